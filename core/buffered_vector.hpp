@@ -5,6 +5,9 @@
 #pragma once
 
 #include <algorithm>
+#include <cstring>
+#include <ranges>
+#include <ratio>
 #include <stdexcept>
 
 #include "detail/alloc_util.hpp"
@@ -14,6 +17,20 @@
 
 namespace sek
 {
+	/** @brief Trait used to check if objects of type `T` can be relocated via a bitwise copy of their representation.
+	 *
+	 * Trivially relocatable objects can be moved to a new location & have their lifetime ended at the old location
+	 * via `memcpy`, without invoking the move constructor & destructor. By default, only trivially copyable types are
+	 * trivially relocatable. May be specialized for types that are not trivially copyable, but do not depend on their
+	 * own address (ex. types that only own a heap-allocated pointer). */
+	template<typename T>
+	struct is_trivially_relocatable : std::is_trivially_copyable<T>
+	{
+	};
+	/** Alias for `is_trivially_relocatable<T>::value`. */
+	template<typename T>
+	constexpr auto is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
 	/** @brief Drop-in replacement for `std::vector` with support for short buffer optimization.
 	 *
 	 * Buffered vector operates the same way as the standard `std::vector` type, with additional support
@@ -23,12 +40,18 @@ namespace sek
 	 * allocator. Unless explicitly requested via `shrink_to_fit`, the long buffer would then be used
 	 * indefinitely.
 	 *
+	 * When the vector is reallocated, it's capacity is multiplied by the `Growth` factor. If `T` is trivially
+	 * relocatable (see `is_trivially_relocatable`), elements are moved between buffers via `memmove`.
+	 *
 	 * @tparam T Type of objects stored within the vector.
 	 * @tparam N Amount of objects of type `T` stored within the local "short" buffer.
-	 * @tparam Alloc Allocator used to allocate memory when vector capacity exceeds `N`. */
-	template<typename T, std::size_t N, typename Alloc = std::allocator<T>>
+	 * @tparam Alloc Allocator used to allocate memory when vector capacity exceeds `N`.
+	 * @tparam Growth `std::ratio` specifying the factor by which capacity grows when the vector is reallocated. */
+	template<typename T, std::size_t N, typename Alloc = std::allocator<T>, typename Growth = std::ratio<2>>
 	class buffered_vector : ebo_base_helper<detail::rebind_alloc_t<Alloc, T>>
 	{
+		static_assert(Growth::num > Growth::den, "Growth factor of `buffered_vector` must be greater than 1");
+
 		using alloc_base = ebo_base_helper<detail::rebind_alloc_t<Alloc, T>>;
 
 	public:
@@ -55,13 +78,33 @@ namespace sek
 			T *data = nullptr;
 		};
 
+		constexpr static size_type growth_num = static_cast<size_type>(Growth::num);
+		constexpr static size_type growth_den = static_cast<size_type>(Growth::den);
+
+		/* Source & destination ranges may overlap as long as `dst` is above `src`. */
 		constexpr static void relocate_backwards_n(T *src, size_type n, T *dst)
 		{
+			if constexpr (is_trivially_relocatable_v<T>)
+			{
+				if (!std::is_constant_evaluated())
+				{
+					std::memmove(static_cast<void *>(dst), static_cast<const void *>(src), n * sizeof(T));
+					return;
+				}
+			}
 			for (size_type i = n; i-- != 0;) relocate(src + i, dst + i);
 		}
-
+		/* Source & destination ranges may overlap as long as `dst` is below `src`. */
 		constexpr static void relocate_n(T *src, size_type n, T *dst)
 		{
+			if constexpr (is_trivially_relocatable_v<T>)
+			{
+				if (!std::is_constant_evaluated())
+				{
+					std::memmove(static_cast<void *>(dst), static_cast<const void *>(src), n * sizeof(T));
+					return;
+				}
+			}
 			for (size_type i = 0; i < n; ++i) relocate(src + i, dst + i);
 		}
 
@@ -94,13 +137,15 @@ namespace sek
 		/** Initializes the vector filled with `n` default-constructed elements using the provided allocator instance. */
 		constexpr buffered_vector(size_type n, const Alloc &alloc = Alloc{}) : buffered_vector(alloc)
 		{
-			insert(end(), n);
+			reserve_exact(n);
+			resize(n);
 		}
 
 		/** Initializes the vector filled with `n` copies of `value` using the provided allocator instance. */
 		constexpr buffered_vector(size_type n, const value_type &value, const Alloc &alloc = Alloc{})
 			: buffered_vector(alloc)
 		{
+			reserve_exact(n);
 			insert(end(), n, value);
 		}
 
@@ -111,6 +156,7 @@ namespace sek
 		template<std::forward_iterator I, std::sentinel_for<I> S>
 		constexpr buffered_vector(I first, S last, const Alloc &alloc = Alloc{}) : buffered_vector(alloc)
 		{
+			reserve_exact(static_cast<size_type>(std::ranges::distance(first, last)));
 			insert(end(), first, last);
 		}
 
@@ -125,12 +171,14 @@ namespace sek
 		/** Copy-constructs the vector. Allocator is copied via `select_on_container_copy_construction`. */
 		constexpr buffered_vector(const buffered_vector &other) : alloc_base(detail::alloc_copy(other.alloc()))
 		{
+			reserve_exact(other.size());
 			insert(end(), other.begin(), other.end());
 		}
 
 		/** Copy-constructs the vector using the provided allocator instance. */
 		constexpr buffered_vector(const buffered_vector &other, const Alloc &alloc) : buffered_vector(alloc)
 		{
+			reserve_exact(other.size());
 			insert(end(), other.begin(), other.end());
 		}
 
@@ -146,7 +194,7 @@ namespace sek
 		/** Move-constructs the vector using the provided allocator instance. */
 		constexpr buffered_vector(buffered_vector &&other, const Alloc &alloc) : buffered_vector(alloc)
 		{
-			if (detail::alloc_eq(alloc(), other.alloc()))
+			if (detail::alloc_eq(this->alloc(), other.alloc()))
 				take_data(other);
 			else
 				move_data(other);
@@ -167,7 +215,7 @@ namespace sek
 					detail::alloc_copy_assign(alloc(), other.alloc());
 				}
 				const auto new_size = other.size();
-				reserve(new_size);
+				reserve_exact(new_size);
 
 				/* If possible, copy-assign overlap, then copy-construct or destroy the rest. */
 				auto src = other.begin(), src_end = other.end();
@@ -175,7 +223,7 @@ namespace sek
 				if constexpr (std::is_copy_assignable_v<T>)
 					for (; dst != dst_end && src != src_end; ++dst, ++src) *dst = *src;
 				if (src < src_end)
-					std::uninitialized_copy_n(src, src_end, dst);
+					std::uninitialized_copy(src, src_end, dst);
 				else
 					std::destroy(dst, dst_end);
 				m_size.value(new_size);
@@ -275,7 +323,10 @@ namespace sek
 		[[nodiscard]] constexpr size_type size() const noexcept { return m_size.value(); }
 
 		/** Returns the maximum possible size of the vector. */
-		[[nodiscard]] constexpr size_type max_size() const noexcept { return std::numeric_limits<size_type>() / 2; }
+		[[nodiscard]] constexpr size_type max_size() const noexcept
+		{
+			return std::numeric_limits<size_type>::max() / 2;
+		}
 
 		/** Returns the current capacity of the vector. */
 		[[nodiscard]] constexpr size_type capacity() const noexcept { return local() ? N : m_heap.capacity; }
@@ -293,10 +344,10 @@ namespace sek
 		[[nodiscard]] constexpr const_reference front() const noexcept { return *begin(); }
 
 		/** Returns reference to the last element of the vector. */
-		[[nodiscard]] constexpr reference back() noexcept { return std::prev(*end()); }
+		[[nodiscard]] constexpr reference back() noexcept { return *std::prev(end()); }
 
 		/** @copydoc back */
-		[[nodiscard]] constexpr const_reference back() const noexcept { return std::prev(*end()); }
+		[[nodiscard]] constexpr const_reference back() const noexcept { return *std::prev(end()); }
 
 		/** Returns reference to the element located at offset `i`. */
 		[[nodiscard]] constexpr reference operator[](size_type i) noexcept { return data()[i]; }
@@ -340,7 +391,7 @@ namespace sek
 			if (!local()) [[likely]]
 			{
 				const auto s = size();
-				if (s < N) /* Move to local storage. */
+				if (s <= N) /* Move to local storage. */
 				{
 					const auto old_capacity = m_heap.capacity;
 					const auto old_data = m_heap.data;
@@ -363,29 +414,22 @@ namespace sek
 			}
 		}
 
-		/** Reserves space for `n` elements, potentially re-allocating internal buffer. */
+		/** Reserves space for at least `n` elements, potentially re-allocating internal buffer.
+		 * If the buffer is re-allocated, capacity is grown by at least the growth factor.
+		 * @throw std::length_error If `n` exceeds `max_size`. */
 		constexpr void reserve(size_type n)
 		{
-			const auto l = local();
-			const auto s = size();
-			if (l && n > N)
-			{
-				const auto new_data = alloc_traits::allocate(alloc(), n);
-				relocate_n(m_local.get(), s, new_data);
-				m_heap.data = new_data;
-				m_heap.capacity = n;
-				m_size.flag(true);
-			}
-			else if (n > m_heap.capacity)
+			if (n > capacity()) reallocate(next_capacity(n));
+		}
+		/** Reserves space for exactly `n` elements, potentially re-allocating internal buffer.
+		 * Unlike `reserve`, does not apply the growth factor.
+		 * @throw std::length_error If `n` exceeds `max_size`. */
+		constexpr void reserve_exact(size_type n)
+		{
+			if (n > capacity())
 			{
-				const auto new_data = alloc_traits::allocate(alloc(), n);
-				const auto old_capacity = m_heap.capacity;
-				const auto old_data = m_heap.data;
-
-				relocate_n(m_local.get(), s, new_data);
-				alloc_traits::deallocate(alloc(), old_data, old_capacity);
-				m_heap.data = new_data;
-				m_heap.capacity = n;
+				check_size(n);
+				reallocate(n);
 			}
 		}
 
@@ -405,6 +449,12 @@ namespace sek
 		template<typename... Args>
 		constexpr iterator emplace(const_iterator where, Args &&...args)
 		{
+			/* Arguments may reference elements that would be relocated to make space, use a temporary in that case. */
+			if (shifts_in_place(where, 1))
+			{
+				T temp(std::forward<Args>(args)...);
+				return emplace_impl(where, 1, [&](T *ptr) { std::construct_at(ptr, std::move(temp)); });
+			}
 			return emplace_impl(where, 1, [&](T *ptr) { std::construct_at(ptr, std::forward<Args>(args)...); });
 		}
 
@@ -452,6 +502,12 @@ namespace sek
 		 * @note Follows the exception guarantee of `std::vector`. */
 		constexpr iterator insert(const_iterator where, size_type n, const value_type &value)
 		{
+			/* `value` may reference an element that would be relocated to make space, use a temporary in that case. */
+			if (n != 0 && shifts_in_place(where, n))
+			{
+				const T temp(value);
+				return emplace_impl(where, n, [&](T *ptr) { std::construct_at(ptr, temp); });
+			}
 			return emplace_impl(where, n, [&](T *ptr) { std::construct_at(ptr, value); });
 		}
 
@@ -463,28 +519,9 @@ namespace sek
 		 * @note Follows the exception guarantee of `std::vector`. */
 		template<std::forward_iterator I, std::sentinel_for<I> S>
 		constexpr iterator insert(const_iterator where, I first, S last)
-		{
-			auto result = begin() + (where - cbegin());
-			const auto back_emplace = where == end();
-			try
-			{
-				for (auto dst = result; first < last; ++dst) dst = insert(dst, where * (first++));
-			}
-			catch (...)
-			{
-				/* Follow the strong exception guarantee of `std::vector` and rollback the size. */
-				if (back_emplace && first == last) m_size.value(m_size.size() - 1);
-				throw;
-			}
-			return result;
-		}
-
-		/** @copydoc insert */
-		template<std::random_access_iterator I, std::sentinel_for<I> S>
-		constexpr iterator insert(const_iterator where, I first, S last)
 		{
 			// clang-format off
-			return emplace_impl(where,static_cast<size_type>(std::distance(first, last)),
+			return emplace_impl(where, static_cast<size_type>(std::ranges::distance(first, last)),
 								[&](T *ptr) { std::construct_at(ptr, *first++); });
 			// clang-format on
 		}
@@ -499,6 +536,37 @@ namespace sek
 			return insert(where, il.begin(), il.end());
 		}
 
+		/** Inserts elements of range `r` at the end of the vector. If size of the range can be determined
+		 * before insertion (range is either sized or a forward range), the vector is re-allocated at most once.
+		 * @param r Range containing elements to insert.
+		 * @note Follows the exception guarantee of `std::vector`. */
+		template<std::ranges::input_range R>
+		constexpr void append_range(R &&r)
+			requires std::constructible_from<T, std::ranges::range_reference_t<R>>
+		{
+			if constexpr (std::ranges::sized_range<R> || std::ranges::forward_range<R>)
+			{
+				const auto n = static_cast<size_type>(std::ranges::distance(r));
+				if constexpr (std::ranges::contiguous_range<R> && std::same_as<std::ranges::range_value_t<R>, T> &&
+							  std::is_trivially_copyable_v<T>)
+				{
+					/* Trivially copyable elements can be copied directly to the end of the buffer. */
+					if (!std::is_constant_evaluated())
+					{
+						const auto old_size = size();
+						reserve(old_size + n);
+						std::memcpy(static_cast<void *>(data() + old_size), std::ranges::data(r), n * sizeof(T));
+						m_size.value(old_size + n);
+						return;
+					}
+				}
+				auto iter = std::ranges::begin(r);
+				emplace_impl(cend(), n, [&](T *ptr) { std::construct_at(ptr, *iter++); });
+			}
+			else
+				for (auto &&value : r) emplace_back(std::forward<decltype(value)>(value));
+		}
+
 		/** Removes an element at the specified position.
 		 * @param where Position of the element to erase.
 		 * @return Iterator to the element after the erased one or `end()`. */
@@ -532,7 +600,7 @@ namespace sek
 		constexpr void pop_back()
 		{
 			m_size.value(m_size.value() - 1);
-			std::destroy(data() + size());
+			std::destroy_at(data() + size());
 		}
 
 		[[nodiscard]] constexpr allocator_type get_allocator() const noexcept { return allocator_type{alloc()}; }
@@ -551,8 +619,8 @@ namespace sek
 
 		// clang-format off
         constexpr void swap(buffered_vector &other) noexcept requires std::is_swappable_v<T> {
-            alloc_assert_swap(alloc(), other.alloc());
-            alloc_swap(alloc(), other.alloc());
+            detail::alloc_assert_swap(alloc(), other.alloc());
+            detail::alloc_swap(alloc(), other.alloc());
             swap_data(other);
         }
 
@@ -566,6 +634,11 @@ namespace sek
 			if (i >= size()) [[unlikely]]
 				throw std::out_of_range("`buffered_vector` subscript out of range");
 		}
+		constexpr void check_size(size_type n) const
+		{
+			if (n > max_size()) [[unlikely]]
+				throw std::length_error("`buffered_vector` size exceeds maximum allowed limit");
+		}
 
 		[[nodiscard]] constexpr auto &alloc() noexcept { return *alloc_base::get(); }
 
@@ -656,7 +729,7 @@ namespace sek
 				if (this_size < other_size)
 				{
 					move_n = this_size;
-					const auto diff = this_size - other_size;
+					const auto diff = other_size - this_size;
 					std::uninitialized_move_n(other.m_local.get() + move_n, diff, m_local.get() + move_n);
 				}
 				else
@@ -704,7 +777,7 @@ namespace sek
 			const auto other_size = other.size();
 			const auto other_end = other.end();
 
-			reserve(other_size);
+			reserve_exact(other_size);
 			const auto this_end = end();
 
 			/* Move-assign overlapping elements. */
@@ -712,78 +785,101 @@ namespace sek
 			for (; dst != this_end && src != other_end; ++dst, ++src) *dst = std::move(*src);
 
 			/* Move-construct or destroy any extra. */
-			if (dst < other_end)
+			if (src != other_end)
 				for (; src != other_end; ++dst, ++src) std::construct_at(dst.get(), std::move(*src));
 			else
 				for (; dst != this_end; ++dst) std::destroy_at(dst.get());
 			m_size.value(other_size);
 		}
 
-		template<typename F, typename... Args>
+		/* Checks if inserting `n` elements at `where` would relocate existing elements within the current buffer. */
+		[[nodiscard]] constexpr bool shifts_in_place(const_iterator where, size_type n) const noexcept
+		{
+			return where != cend() && size() + n <= capacity();
+		}
+		/* Returns capacity of the buffer required to fit `n` elements, taking into account the growth factor. */
+		[[nodiscard]] constexpr size_type next_capacity(size_type n) const
+		{
+			check_size(n);
+
+			/* Clamp the grown capacity to avoid overflow. */
+			const auto cap = capacity();
+			const auto grown = cap < max_size() / growth_num ? cap * growth_num / growth_den : max_size();
+			return std::max(grown, n);
+		}
+		constexpr void reallocate(size_type new_cap)
+		{
+			const auto new_data = alloc_traits::allocate(alloc(), new_cap);
+			relocate_n(data(), size(), new_data);
+			if (!local()) alloc_traits::deallocate(alloc(), m_heap.data, m_heap.capacity);
+
+			m_heap.capacity = new_cap;
+			m_heap.data = new_data;
+			m_size.flag(true);
+		}
+
+		template<typename F>
 		constexpr iterator emplace_impl(const_iterator where, size_type n, F &&factory)
 		{
 			const auto insert_pos = static_cast<size_type>(where - cbegin());
 			const auto old_size = size();
 			const auto new_size = old_size + n;
-			const auto old_cap = capacity();
-			const auto resized = old_cap <= new_size;
-			const auto new_cap = std::max(old_cap * 2, new_size);
-
 			const auto src = data();
-			const auto dst = resized ? alloc_traits::allocate(alloc(), new_cap) : src;
-
-			/* Move everything that is above `insert_pos` */
-			relocate_backwards_n(src + insert_pos, old_size - insert_pos, dst + insert_pos + n);
 
-			try
+			if (new_size > capacity())
 			{
-				for (size_type i = 0; i < n; ++i) factory(dst + insert_pos + i);
-			}
-			catch (...)
-			{
-				/* If a new buffer was allocated, deallocate it. */
-				if (resized) alloc_traits::deallocate(alloc(), dst, new_cap);
-				throw;
-			}
+				/* Construct new elements in the new buffer before relocating, in case the arguments
+				 * reference elements of the vector. */
+				const auto new_cap = next_capacity(new_size);
+				const auto dst = alloc_traits::allocate(alloc(), new_cap);
+				size_type i = 0;
+				try
+				{
+					for (; i < n; ++i) factory(dst + insert_pos + i);
+				}
+				catch (...)
+				{
+					std::destroy_n(dst + insert_pos, i);
+					alloc_traits::deallocate(alloc(), dst, new_cap);
+					throw;
+				}
 
-			/* If resizing was necessary, move old data. */
-			if (resized)
-			{
 				relocate_n(src, insert_pos, dst);
-				if (!local()) alloc_traits::deallocate(alloc(), src, old_cap);
+				relocate_n(src + insert_pos, old_size - insert_pos, dst + insert_pos + n);
+				if (!local()) alloc_traits::deallocate(alloc(), m_heap.data, m_heap.capacity);
+
 				m_heap.capacity = new_cap;
 				m_heap.data = dst;
 				m_size.flag(true);
 			}
+			else
+			{
+				/* Move everything that is above `insert_pos`. Arguments referencing elements of the vector
+				 * are handled by the callers (see `shifts_in_place`). */
+				const auto tail_n = old_size - insert_pos;
+				relocate_backwards_n(src + insert_pos, tail_n, src + insert_pos + n);
 
-			return begin() + static_cast<difference_type>(insert_pos);
-		}
-
-		constexpr iterator make_space(const_iterator where, size_type n)
-		{
-			const auto cap = capacity();
-			const auto old_size = size();
-			const auto new_size = old_size + n;
-			const auto iter_pos = static_cast<size_type>(where - begin());
-
-			/* Reallocate the buffer if necessary. */
-			if (new_size >= cap) [[unlikely]]
-				reserve(std::max(new_size, cap * 2));
+				size_type i = 0;
+				try
+				{
+					for (; i < n; ++i) factory(src + insert_pos + i);
+				}
+				catch (...)
+				{
+					/* Destroy inserted elements & move the rest back. */
+					std::destroy_n(src + insert_pos, i);
+					relocate_n(src + insert_pos + n, tail_n, src + insert_pos);
+					throw;
+				}
+			}
 
-			/* Relocate elements to make space. */
-			const auto src = begin() + static_cast<difference_type>(iter_pos);
-			const auto dst = src + static_cast<difference_type>(n);
-			relocate_backwards_n(src.get(), old_size - iter_pos, dst.get());
 			m_size.value(new_size);
-			return src;
+			return begin() + static_cast<difference_type>(insert_pos);
 		}
 
 		template<typename... Args>
 		constexpr void resize_impl(size_type n, Args &&...args)
 		{
-			if (n >= max_size()) [[unlikely]]
-				throw std::length_error("`buffered_vector` size exceeds maximum allowed limit");
-
 			if (const auto old_size = size(); n < old_size)
 			{
 				std::destroy_n(data() + n, old_size - n);
@@ -794,9 +890,17 @@ namespace sek
 				reserve(n);
 
 				/* Exception guarantee. */
-				auto dst = data(), pos = dst + old_size, end = dst + n;
-				for (; pos < end; ++pos) std::construct_at(pos, args...);
-				m_size.value(pos - dst);
+				auto dst = data() + old_size, pos = dst, end = data() + n;
+				try
+				{
+					for (; pos < end; ++pos) std::construct_at(pos, args...);
+				}
+				catch (...)
+				{
+					std::destroy(dst, pos);
+					throw;
+				}
+				m_size.value(n);
 			}
 		}
 
@@ -809,22 +913,22 @@ namespace sek
 	};
 
 	/** Erases all elements that compare equal to `value` from the vector. */
-	template<typename T, std::size_t N, typename Alloc, typename U>
-	constexpr typename buffered_vector<T, N, Alloc>::size_type erase(buffered_vector<T, N, Alloc> &v, const U &value)
+	template<typename T, std::size_t N, typename A, typename G, typename U>
+	constexpr typename buffered_vector<T, N, A, G>::size_type erase(buffered_vector<T, N, A, G> &v, const U &value)
 	{
 		const auto i = std::remove(v.begin(), v.end(), value);
 		const auto d = std::distance(i, v.end());
 		v.erase(i, v.end());
-		return static_cast<typename buffered_vector<T, N, Alloc>::size_type>(d);
+		return static_cast<typename buffered_vector<T, N, A, G>::size_type>(d);
 	}
 
 	/** Erases all elements that satisfy the predicate `pred` from the vector. */
-	template<typename T, std::size_t N, typename Alloc, typename P>
-	constexpr typename buffered_vector<T, N, Alloc>::size_type erase_if(buffered_vector<T, N, Alloc> &v, P &&pred)
+	template<typename T, std::size_t N, typename A, typename G, typename P>
+	constexpr typename buffered_vector<T, N, A, G>::size_type erase_if(buffered_vector<T, N, A, G> &v, P &&pred)
 	{
 		const auto i = std::remove_if(v.begin(), v.end(), std::forward<P>(pred));
 		const auto d = std::distance(i, v.end());
 		v.erase(i, v.end());
-		return static_cast<typename buffered_vector<T, N, Alloc>::size_type>(d);
+		return static_cast<typename buffered_vector<T, N, A, G>::size_type>(d);
 	}
 }	 // namespace sek
@@ -0,0 +1,355 @@
+/*
+ * Created by switchblade on 2026-10-16
+ */
+
+#pragma once
+
+#include <bit>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <thread>
+
+#include "dense_map.hpp"
+#include "detail/packed_pair.hpp"
+
+namespace sek
+{
+	/** @brief Thread-safe associative container, which stripes keys across multiple internally locked dense maps.
+	 *
+	 * Every shard of the map is guarded by it's own shared mutex, thus lookups never block each other, and
+	 * modifications only block operations on the same shard. Shard of a key is selected via the upper bits of the
+	 * (mixed) key hash, while buckets within a shard use the lower bits, thus keys stay evenly spread within shards.
+	 *
+	 * Since values of a dense map are relocated on insertion & erasure, the map does not provide iterators or
+	 * references to it's elements. Instead, elements are either copied out of the map (`find`), or are accessed via
+	 * a functor which is invoked while the shard is locked (`visit`).
+	 *
+	 * @note Functors passed to `visit`, `visit_all` and `erase_if` must not access the map.
+	 *
+	 * @tparam K Type of objects used as keys.
+	 * @tparam M Type of objects associated with keys.
+	 * @tparam KeyHash Functor used to generate hashes for keys.
+	 * @tparam KeyComp Predicate used to compare keys.
+	 * @tparam Alloc Allocator used for the map. */
+	template<typename K, typename M, typename KeyHash = default_hash, typename KeyComp = std::equal_to<K>, typename Alloc = std::allocator<std::pair<const K, M>>>
+	class concurrent_dense_map
+	{
+		using shard_map = dense_map<K, M, KeyHash, KeyComp, Alloc>;
+
+		struct alignas(64) shard_t
+		{
+			shard_t(const KeyComp &key_compare, const KeyHash &key_hash, const Alloc &alloc)
+				: map(key_compare, key_hash, alloc)
+			{
+			}
+
+			mutable std::shared_mutex mtx;
+			shard_map map;
+		};
+
+		using shard_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<shard_t>;
+
+		// clang-format off
+		constexpr static bool transparent_key = requires
+		{
+			typename KeyHash::is_transparent;
+			typename KeyComp::is_transparent;
+		};
+		// clang-format on
+
+	public:
+		typedef K key_type;
+		typedef M mapped_type;
+		typedef std::pair<const key_type, mapped_type> value_type;
+		typedef Alloc allocator_type;
+		typedef KeyHash hash_type;
+		typedef KeyComp key_equal;
+		typedef typename shard_map::size_type size_type;
+		typedef typename shard_map::difference_type difference_type;
+
+		/** Returns the default amount of shards, which is 4 shards per hardware thread, rounded to a power of 2. */
+		[[nodiscard]] static size_type default_shards() noexcept
+		{
+			return std::bit_ceil(std::max<size_type>(std::thread::hardware_concurrency(), 1) * 4);
+		}
+
+	public:
+		concurrent_dense_map(const concurrent_dense_map &) = delete;
+		concurrent_dense_map &operator=(const concurrent_dense_map &) = delete;
+
+		/** Constructs a map with the default amount of shards. */
+		concurrent_dense_map() : concurrent_dense_map(default_shards()) {}
+		~concurrent_dense_map()
+		{
+			std::destroy_n(m_shards, m_shard_count);
+			shard_alloc{m_data.first()}.deallocate(m_shards, m_shard_count);
+		}
+
+		/** Constructs a map with the specified amount of shards.
+		 * @param shards Amount of shards. Rounded up to a power of 2.
+		 * @param key_compare Key comparator.
+		 * @param key_hash Key hasher.
+		 * @param alloc Allocator used to allocate shards & values of the map. */
+		explicit concurrent_dense_map(size_type shards,
+									  const key_equal &key_compare = {},
+									  const hash_type &key_hash = {},
+									  const allocator_type &alloc = allocator_type{})
+			: m_data(alloc, key_hash), m_shard_count(std::bit_ceil(std::max<size_type>(shards, 1)))
+		{
+			m_shard_bits = static_cast<size_type>(std::countr_zero(m_shard_count));
+
+			shard_alloc a{m_data.first()};
+			m_shards = a.allocate(m_shard_count);
+
+			size_type i = 0;
+			try
+			{
+				for (; i < m_shard_count; ++i) std::construct_at(m_shards + i, key_compare, key_hash, alloc);
+			}
+			catch (...)
+			{
+				std::destroy_n(m_shards, i);
+				a.deallocate(m_shards, m_shard_count);
+				throw;
+			}
+		}
+
+		/** Returns the amount of shards of the map. */
+		[[nodiscard]] constexpr size_type shard_count() const noexcept { return m_shard_count; }
+
+		/** Returns the total amount of elements in the map.
+		 * @note Shards are locked one at a time, thus the result may be out of date if the map is modified
+		 * concurrently. */
+		[[nodiscard]] size_type size() const
+		{
+			size_type result = 0;
+			for (auto &shard : shards())
+			{
+				std::shared_lock<std::shared_mutex> l(shard.mtx);
+				result += shard.map.size();
+			}
+			return result;
+		}
+		/** Checks if the map is empty.
+		 * @copydetails size */
+		[[nodiscard]] bool empty() const { return size() == 0; }
+
+		/** Empties the map's contents. */
+		void clear()
+		{
+			for (auto &shard : shards())
+			{
+				std::lock_guard<std::shared_mutex> l(shard.mtx);
+				shard.map.clear();
+			}
+		}
+		/** Resizes the shards of the map to have space for at least n elements in total. */
+		void reserve(size_type n)
+		{
+			const auto per_shard = (n + m_shard_count - 1) / m_shard_count;
+			for (auto &shard : shards())
+			{
+				std::lock_guard<std::shared_mutex> l(shard.mtx);
+				shard.map.reserve(per_shard);
+			}
+		}
+
+		/** Returns a copy of the object mapped to the specific key.
+		 * @param key Key to search for.
+		 * @return Copy of the mapped object, or an empty optional if the key is not present in the map. */
+		[[nodiscard]] std::optional<mapped_type> find(const key_type &key) const { return find_impl(key); }
+		/** Checks if the map contains an element with specific key.
+		 * @param key Key to search for. */
+		[[nodiscard]] bool contains(const key_type &key) const { return contains_impl(key); }
+
+		// clang-format off
+		/** @copydoc find
+		 * @note This overload participates in overload resolution only
+		 * if both key hasher and key comparator are transparent. */
+		[[nodiscard]] std::optional<mapped_type> find(const auto &key) const requires transparent_key
+		{
+			return find_impl(key);
+		}
+		/** @copydoc contains
+		 * @note This overload participates in overload resolution only
+		 * if both key hasher and key comparator are transparent. */
+		[[nodiscard]] bool contains(const auto &key) const requires transparent_key { return contains_impl(key); }
+		// clang-format on
+
+		/** Invokes a functor with the element mapped to the specific key, while it's shard is locked for reading.
+		 * @param key Key to search for.
+		 * @param f Functor invoked with a const reference to the key & a const reference to the mapped object.
+		 * @return `true` if the key is present in the map, `false` otherwise. */
+		template<typename F>
+		bool visit(const key_type &key, F &&f) const
+		{
+			auto &shard = get_shard(key);
+			std::shared_lock<std::shared_mutex> l(shard.mtx);
+			return visit_impl(std::as_const(shard.map), key, f);
+		}
+		/** Invokes a functor with the element mapped to the specific key, while it's shard is locked for writing.
+		 * @param key Key to search for.
+		 * @param f Functor invoked with a const reference to the key & a reference to the mapped object.
+		 * @return `true` if the key is present in the map, `false` otherwise. */
+		template<typename F>
+		bool visit(const key_type &key, F &&f)
+		{
+			auto &shard = get_shard(key);
+			std::lock_guard<std::shared_mutex> l(shard.mtx);
+			return visit_impl(shard.map, key, f);
+		}
+		/** Invokes a functor for every element of the map. Shards are locked for reading one at a time.
+		 * @param f Functor invoked with a const reference to the key & a const reference to the mapped object. */
+		template<typename F>
+		void visit_all(F &&f) const
+		{
+			for (auto &shard : shards())
+			{
+				std::shared_lock<std::shared_mutex> l(shard.mtx);
+				for (auto [key, value] : std::as_const(shard.map)) f(key, value);
+			}
+		}
+		/** Invokes a functor for every element of the map. Shards are locked for writing one at a time.
+		 * @param f Functor invoked with a const reference to the key & a reference to the mapped object. */
+		template<typename F>
+		void visit_all(F &&f)
+		{
+			for (auto &shard : shards())
+			{
+				std::lock_guard<std::shared_mutex> l(shard.mtx);
+				for (auto [key, value] : shard.map) f(key, value);
+			}
+		}
+
+		/** Attempts to construct a value in-place at the specified key.
+		 * If such key is already associated with a value, does nothing.
+		 * @param key Key for which to insert the value.
+		 * @param args Arguments used to construct the mapped object.
+		 * @return `true` if the element was inserted, `false` otherwise. */
+		template<typename... Args>
+		bool try_emplace(key_type &&key, Args &&...args)
+		{
+			auto &shard = get_shard(key);
+			std::lock_guard<std::shared_mutex> l(shard.mtx);
+			return shard.map.try_emplace(std::forward<key_type>(key), std::forward<Args>(args)...).second;
+		}
+		/** @copydoc try_emplace */
+		template<typename... Args>
+		bool try_emplace(const key_type &key, Args &&...args)
+		{
+			auto &shard = get_shard(key);
+			std::lock_guard<std::shared_mutex> l(shard.mtx);
+			return shard.map.try_emplace(key, std::forward<Args>(args)...).second;
+		}
+		/** Inserts a value into the map. If a value with the same key is already present within the map, replaces it.
+		 * @param value Value to insert.
+		 * @return `true` if a new element was inserted, `false` if an existing element was replaced. */
+		bool insert(value_type &&value)
+		{
+			auto &shard = get_shard(value.first);
+			std::lock_guard<std::shared_mutex> l(shard.mtx);
+			return shard.map.insert(std::forward<value_type>(value)).second;
+		}
+		/** @copydoc insert */
+		bool insert(const value_type &value)
+		{
+			auto &shard = get_shard(value.first);
+			std::lock_guard<std::shared_mutex> l(shard.mtx);
+			return shard.map.insert(value).second;
+		}
+
+		/** Removes element mapped to the specified key from the map if it is present.
+		 * @param key Key of the target element.
+		 * @return `true` if the element was removed, `false` otherwise. */
+		bool erase(const key_type &key)
+		{
+			auto &shard = get_shard(key);
+			std::lock_guard<std::shared_mutex> l(shard.mtx);
+			return shard.map.erase(key);
+		}
+		/** Removes element mapped to the specified key if it satisfies a predicate.
+		 * @param key Key of the target element.
+		 * @param pred Predicate invoked with a const reference to the key & a reference to the mapped object.
+		 * @return `true` if the element was removed, `false` otherwise. */
+		template<typename P>
+		bool erase_if(const key_type &key, P &&pred)
+		{
+			auto &shard = get_shard(key);
+			std::lock_guard<std::shared_mutex> l(shard.mtx);
+			if (auto iter = shard.map.find(key); iter != shard.map.end() && pred(iter->first, iter->second))
+			{
+				shard.map.erase(iter);
+				return true;
+			}
+			return false;
+		}
+		/** Removes all elements satisfying a predicate. Shards are locked for writing one at a time.
+		 * @param pred Predicate invoked with a const reference to the key & a reference to the mapped object.
+		 * @return Amount of elements removed. */
+		template<typename P>
+		size_type erase_if(P &&pred)
+		{
+			size_type result = 0;
+			for (auto &shard : shards())
+			{
+				std::lock_guard<std::shared_mutex> l(shard.mtx);
+
+				/* Erased element is replaced with the last element, thus the iterator is not advanced on erasure. */
+				for (auto iter = shard.map.begin(); iter != shard.map.end();)
+					if (pred(iter->first, iter->second))
+					{
+						iter = shard.map.erase(iter);
+						++result;
+					}
+					else
+						++iter;
+			}
+			return result;
+		}
+
+		[[nodiscard]] allocator_type get_allocator() const noexcept { return m_data.first(); }
+		[[nodiscard]] hash_type hash_function() const noexcept { return m_data.second(); }
+
+	private:
+		[[nodiscard]] std::span<shard_t> shards() const noexcept { return {m_shards, m_shard_count}; }
+
+		[[nodiscard]] shard_t &get_shard(const auto &key) const
+		{
+			/* Use upper bits of the mixed hash, since lower bits select the bucket within the shard. */
+			const auto h = pow2_bucket_policy::mix(m_data.second()(key));
+			return m_shards[std::rotl(h, static_cast<int>(m_shard_bits)) & (m_shard_count - 1)];
+		}
+
+		[[nodiscard]] std::optional<mapped_type> find_impl(const auto &key) const
+		{
+			auto &shard = get_shard(key);
+			std::shared_lock<std::shared_mutex> l(shard.mtx);
+			if (auto iter = shard.map.find(key); iter != shard.map.end()) return iter->second;
+			return std::nullopt;
+		}
+		[[nodiscard]] bool contains_impl(const auto &key) const
+		{
+			auto &shard = get_shard(key);
+			std::shared_lock<std::shared_mutex> l(shard.mtx);
+			return shard.map.contains(key);
+		}
+		template<typename Map, typename F>
+		static bool visit_impl(Map &map, const key_type &key, F &f)
+		{
+			if (auto iter = map.find(key); iter != map.end())
+			{
+				f(iter->first, iter->second);
+				return true;
+			}
+			return false;
+		}
+
+		packed_pair<allocator_type, hash_type> m_data;
+
+		shard_t *m_shards = nullptr;
+		size_type m_shard_count = 0;
+		size_type m_shard_bits = 0;
+	};
+}	 // namespace sek
\ No newline at end of file
@@ -0,0 +1,421 @@
+/*
+ * Created by switchblade on 2026-10-16
+ */
+
+#pragma once
+
+#include "dense_map.hpp"
+
+namespace sek
+{
+	/** @brief Dense table based set of keys with multiplicities (aka a bag).
+	 *
+	 * Count sets store duplicate keys in a run-length layout, where every unique key is stored exactly once together
+	 * with the amount of its copies. As such, `count` is a single lookup, `equal_range` always returns a contiguous
+	 * range of copies and multiple copies of a key can be inserted or erased at once. Count sets are implemented on
+	 * top of a dense map, thus the same iterator invalidation rules apply to the runs of the set.
+	 *
+	 * @tparam T Type of objects stored in the set.
+	 * @tparam KeyHash Functor used to generate hashes for keys. By default uses `default_hash` which calls static
+	 * non-member `hash` function via ADL if available, otherwise invokes `std::hash`.
+	 * @tparam KeyComp Predicate used to compare keys.
+	 * @tparam Alloc Allocator used for the set. */
+	template<typename T, typename KeyHash = default_hash, typename KeyComp = std::equal_to<T>, typename Alloc = std::allocator<T>>
+	class dense_count_set
+	{
+	public:
+		typedef T key_type;
+		typedef T value_type;
+		typedef Alloc allocator_type;
+
+	private:
+		using run_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<std::pair<const T, std::size_t>>;
+		using run_map = dense_map<T, std::size_t, KeyHash, KeyComp, run_alloc>;
+		using run_ptr = typename run_map::const_iterator;
+
+		// clang-format off
+		constexpr static bool transparent_key = requires
+		{
+			typename KeyHash::is_transparent;
+			typename KeyComp::is_transparent;
+		};
+		// clang-format on
+
+		class count_set_iterator
+		{
+			friend class dense_count_set;
+
+		public:
+			typedef T value_type;
+			typedef const T *pointer;
+			typedef const T &reference;
+			typedef std::size_t size_type;
+			typedef std::ptrdiff_t difference_type;
+			typedef std::forward_iterator_tag iterator_category;
+
+		private:
+			constexpr count_set_iterator(run_ptr run, size_type off) noexcept : m_run(run), m_off(off) {}
+
+		public:
+			constexpr count_set_iterator() noexcept = default;
+
+			constexpr count_set_iterator operator++(int) noexcept
+			{
+				auto temp = *this;
+				++(*this);
+				return temp;
+			}
+			constexpr count_set_iterator &operator++() noexcept
+			{
+				/* Move to the next run once all copies of the current one were visited. */
+				if (++m_off == (*m_run).second)
+				{
+					++m_run;
+					m_off = 0;
+				}
+				return *this;
+			}
+
+			/** Returns pointer to the target element. */
+			[[nodiscard]] constexpr pointer get() const noexcept { return std::addressof((*m_run).first); }
+			/** @copydoc value */
+			[[nodiscard]] constexpr pointer operator->() const noexcept { return get(); }
+			/** Returns reference to the target element. */
+			[[nodiscard]] constexpr reference operator*() const noexcept { return *get(); }
+
+			[[nodiscard]] constexpr bool operator==(const count_set_iterator &) const noexcept = default;
+
+			constexpr void swap(count_set_iterator &other) noexcept
+			{
+				using std::swap;
+				swap(m_run, other.m_run);
+				swap(m_off, other.m_off);
+			}
+			friend constexpr void swap(count_set_iterator &a, count_set_iterator &b) noexcept { a.swap(b); }
+
+		private:
+			run_ptr m_run = {};
+			size_type m_off = 0;
+		};
+
+	public:
+		typedef const T *pointer;
+		typedef const T *const_pointer;
+		typedef const T &reference;
+		typedef const T &const_reference;
+
+		typedef typename run_map::hash_type hash_type;
+		typedef typename run_map::key_equal key_equal;
+
+		typedef count_set_iterator iterator;
+		typedef count_set_iterator const_iterator;
+		/** Iterator over runs of the set. Runs are pairs of references to the key & the amount of its copies. */
+		typedef run_ptr run_iterator;
+		typedef typename run_map::size_type size_type;
+		typedef typename run_map::difference_type difference_type;
+
+	public:
+		constexpr dense_count_set() = default;
+		constexpr ~dense_count_set() = default;
+		constexpr dense_count_set(const dense_count_set &) = default;
+		constexpr dense_count_set &operator=(const dense_count_set &) = default;
+
+		/** Constructs a set with the specified allocator.
+		 * @param alloc Allocator used to allocate set's value array. */
+		constexpr explicit dense_count_set(const allocator_type &alloc)
+			: dense_count_set(key_equal{}, hash_type{}, alloc)
+		{
+		}
+		/** Constructs a set with the specified comparator, hasher & allocator.
+		 * @param key_compare Key comparator.
+		 * @param key_hash Key hasher.
+		 * @param alloc Allocator used to allocate set's value array. */
+		constexpr explicit dense_count_set(const key_equal &key_compare,
+										   const hash_type &key_hash = {},
+										   const allocator_type &alloc = allocator_type{})
+			: m_runs(key_compare, key_hash, run_alloc{alloc})
+		{
+		}
+		/** Constructs a set with the specified minimum capacity of unique keys.
+		 * @param capacity Capacity of the set.
+		 * @param key_compare Key comparator.
+		 * @param key_hash Key hasher.
+		 * @param alloc Allocator used to allocate set's value array. */
+		constexpr explicit dense_count_set(size_type capacity,
+										   const key_equal &key_compare = {},
+										   const hash_type &key_hash = {},
+										   const allocator_type &alloc = allocator_type{})
+			: m_runs(capacity, key_compare, key_hash, run_alloc{alloc})
+		{
+		}
+		/** Constructs a set from a sequence of values.
+		 * @param first Iterator to the start of the value sequence.
+		 * @param first Iterator to the end of the value sequence.
+		 * @param key_compare Key comparator.
+		 * @param key_hash Key hasher.
+		 * @param alloc Allocator used to allocate set's value array. */
+		template<std::forward_iterator Iterator>
+		constexpr dense_count_set(Iterator first,
+								  Iterator last,
+								  const key_equal &key_compare = {},
+								  const hash_type &key_hash = {},
+								  const allocator_type &alloc = allocator_type{})
+			: dense_count_set(key_compare, key_hash, alloc)
+		{
+			insert(first, last);
+		}
+		/** Constructs a set from an initializer list.
+		 * @param il Initializer list containing values.
+		 * @param key_compare Key comparator.
+		 * @param key_hash Key hasher.
+		 * @param alloc Allocator used to allocate set's value array. */
+		constexpr dense_count_set(std::initializer_list<value_type> il,
+								  const key_equal &key_compare = {},
+								  const hash_type &key_hash = {},
+								  const allocator_type &alloc = allocator_type{})
+			: dense_count_set(il.begin(), il.end(), key_compare, key_hash, alloc)
+		{
+		}
+
+		/** Move-constructs the set. Allocator is move-constructed.
+		 * @param other Set to move elements from. */
+		constexpr dense_count_set(dense_count_set &&other)
+			: m_runs(std::move(other.m_runs)), m_size(std::exchange(other.m_size, 0))
+		{
+		}
+		/** Move-assigns the set.
+		 * @param other Set to move elements from. */
+		constexpr dense_count_set &operator=(dense_count_set &&other)
+		{
+			m_runs = std::move(other.m_runs);
+			m_size = std::exchange(other.m_size, 0);
+			return *this;
+		}
+
+		/** Returns iterator to the start of the set. */
+		[[nodiscard]] constexpr const_iterator begin() const noexcept { return const_iterator{m_runs.begin(), 0}; }
+		/** Returns iterator to the end of the set. */
+		[[nodiscard]] constexpr const_iterator end() const noexcept { return const_iterator{m_runs.end(), 0}; }
+		/** @copydoc begin */
+		[[nodiscard]] constexpr const_iterator cbegin() const noexcept { return begin(); }
+		/** @copydoc end */
+		[[nodiscard]] constexpr const_iterator cend() const noexcept { return end(); }
+
+		/** Returns iterator to the first run of the set. */
+		[[nodiscard]] constexpr run_iterator run_begin() const noexcept { return m_runs.begin(); }
+		/** Returns iterator to the end of the runs of the set. */
+		[[nodiscard]] constexpr run_iterator run_end() const noexcept { return m_runs.end(); }
+
+		/** Locates the first copy of a key within the set.
+		 * @param key Key to search for.
+		 * @return Iterator to the first copy of the key, or end iterator. */
+		constexpr const_iterator find(const key_type &key) const noexcept
+		{
+			return const_iterator{m_runs.find(key), 0};
+		}
+		/** Checks if the set contains at least one copy of a key.
+		 * @param key Key to search for. */
+		constexpr bool contains(const key_type &key) const noexcept { return m_runs.contains(key); }
+		/** Returns the amount of copies of a key within the set.
+		 * @param key Key to search for. */
+		constexpr size_type count(const key_type &key) const noexcept { return count_impl(m_runs.find(key)); }
+		/** Returns a contiguous range of all copies of a key within the set.
+		 * @param key Key to search for.
+		 * @return Pair of iterators to the first copy of the key & the element after the last copy,
+		 * or a pair of end iterators. */
+		constexpr std::pair<const_iterator, const_iterator> equal_range(const key_type &key) const noexcept
+		{
+			return equal_range_impl(m_runs.find(key));
+		}
+		// clang-format off
+		/** @copydoc find
+		 * @note This overload participates in overload resolution only
+		 * if both key hasher and key comparator are transparent. */
+		constexpr const_iterator find(const auto &key) const noexcept requires transparent_key
+		{
+			return const_iterator{m_runs.find(key), 0};
+		}
+		/** @copydoc contains
+		 * @note This overload participates in overload resolution only
+		 * if both key hasher and key comparator are transparent. */
+		constexpr bool contains(const auto &key) const noexcept requires transparent_key
+		{
+			return m_runs.contains(key);
+		}
+		/** @copydoc count
+		 * @note This overload participates in overload resolution only
+		 * if both key hasher and key comparator are transparent. */
+		constexpr size_type count(const auto &key) const noexcept requires transparent_key
+		{
+			return count_impl(m_runs.find(key));
+		}
+		/** @copydoc equal_range
+		 * @note This overload participates in overload resolution only
+		 * if both key hasher and key comparator are transparent. */
+		constexpr std::pair<const_iterator, const_iterator> equal_range(const auto &key) const noexcept
+			requires transparent_key
+		{
+			return equal_range_impl(m_runs.find(key));
+		}
+		// clang-format on
+
+		/** Empties the set's contents. */
+		constexpr void clear()
+		{
+			m_runs.clear();
+			m_size = 0;
+		}
+		/** Re-hashes the set for the specified minimal capacity of unique keys. */
+		constexpr void rehash(size_type capacity) { m_runs.rehash(capacity); }
+		/** Resizes the internal storage to have space for at least n unique keys. */
+		constexpr void reserve(size_type n) { m_runs.reserve(n); }
+
+		/** Inserts a copy of a key into the set.
+		 * @param value Value to insert.
+		 * @return Iterator to the first copy of the key. */
+		constexpr const_iterator insert(const value_type &value) { return insert_n(value, 1); }
+		/** @copydoc insert */
+		constexpr const_iterator insert(value_type &&value) { return insert_n(std::move(value), 1); }
+		/** @copydoc insert
+		 * @param hint Hint for where to insert the value.
+		 * @note Hint is required for compatibility with STL algorithms and is ignored. */
+		constexpr const_iterator insert([[maybe_unused]] const_iterator hint, const value_type &value)
+		{
+			return insert(value);
+		}
+		/** @copydoc insert */
+		constexpr const_iterator insert([[maybe_unused]] const_iterator hint, value_type &&value)
+		{
+			return insert(std::move(value));
+		}
+		/** Inserts a sequence of values into the set.
+		 * @param first Iterator to the start of the value sequence.
+		 * @param first Iterator to the end of the value sequence.
+		 * @return Amount of new unique keys inserted. */
+		template<std::forward_iterator Iterator>
+		constexpr size_type insert(Iterator first, Iterator last)
+		{
+			const auto old_runs = run_count();
+			for (; first != last; ++first) insert(*first);
+			return run_count() - old_runs;
+		}
+		/** Inserts a sequence of values into the set.
+		 * @param il Initializer list containing values.
+		 * @return Amount of new unique keys inserted. */
+		constexpr size_type insert(std::initializer_list<value_type> il) { return insert(il.begin(), il.end()); }
+
+		/** Inserts multiple copies of a key into the set. Copies of the key are inserted as a single run.
+		 * @param value Value to insert.
+		 * @param n Amount of copies to insert.
+		 * @return Iterator to the first copy of the key, or end iterator if `n` is `0`. */
+		constexpr const_iterator insert_n(const value_type &value, size_type n) { return insert_n_impl(value, n); }
+		/** @copydoc insert_n */
+		constexpr const_iterator insert_n(value_type &&value, size_type n)
+		{
+			return insert_n_impl(std::move(value), n);
+		}
+
+		/** Removes a single copy of a key from the set.
+		 * @param where Iterator to the target element.
+		 * @return Iterator to the element after the erased one. */
+		constexpr const_iterator erase(const_iterator where)
+		{
+			auto &n = m_runs.find((*where.m_run).first)->second;
+			--m_size;
+			if (--n == 0) return const_iterator{m_runs.erase(where.m_run), 0};
+			return where.m_off != n ? where : const_iterator{std::next(where.m_run), 0};
+		}
+		/** Removes all copies of a key from the set.
+		 * @param key Key to search for.
+		 * @return Amount of copies removed. */
+		constexpr size_type erase(const key_type &key) { return erase_n(key, max_size()); }
+		/** Removes up to `n` copies of a key from the set.
+		 * @param key Key to search for.
+		 * @param n Maximum amount of copies to remove.
+		 * @return Amount of copies removed. */
+		constexpr size_type erase_n(const key_type &key, size_type n)
+		{
+			const auto run = m_runs.find(key);
+			if (run == m_runs.end() || n == 0) return 0;
+
+			auto &count = run->second;
+			n = std::min(n, count);
+			if ((count -= n) == 0) m_runs.erase(run);
+			m_size -= n;
+			return n;
+		}
+
+		/** Returns current amount of elements in the set, including duplicates. */
+		[[nodiscard]] constexpr size_type size() const noexcept { return m_size; }
+		/** Returns current amount of unique keys in the set. */
+		[[nodiscard]] constexpr size_type run_count() const noexcept { return m_runs.size(); }
+		/** Returns current capacity of unique keys of the set. */
+		[[nodiscard]] constexpr size_type capacity() const noexcept { return m_runs.capacity(); }
+		/** Returns maximum possible amount of elements in the set. */
+		[[nodiscard]] constexpr size_type max_size() const noexcept
+		{
+			return std::numeric_limits<size_type>::max();
+		}
+		/** Checks if the set is empty. */
+		[[nodiscard]] constexpr bool empty() const noexcept { return size() == 0; }
+
+		/** Returns current amount of buckets in the set. */
+		[[nodiscard]] constexpr size_type bucket_count() const noexcept { return m_runs.bucket_count(); }
+		/** Returns current load factor of the set. */
+		[[nodiscard]] constexpr auto load_factor() const noexcept { return m_runs.load_factor(); }
+		/** Returns current max load factor of the set. */
+		[[nodiscard]] constexpr auto max_load_factor() const noexcept { return m_runs.max_load_factor(); }
+		/** Sets current max load factor of the set. */
+		constexpr void max_load_factor(float f) noexcept { m_runs.max_load_factor(f); }
+
+		[[nodiscard]] constexpr allocator_type get_allocator() const noexcept
+		{
+			return allocator_type{m_runs.get_allocator()};
+		}
+
+		[[nodiscard]] constexpr hash_type hash_function() const noexcept { return m_runs.hash_function(); }
+		[[nodiscard]] constexpr key_equal key_eq() const noexcept { return m_runs.key_eq(); }
+
+		[[nodiscard]] constexpr bool operator==(const dense_count_set &other) const noexcept
+		{
+			if (size() != other.size() || run_count() != other.run_count()) return false;
+			for (auto run = run_begin(); run != run_end(); ++run)
+				if (other.count((*run).first) != (*run).second) return false;
+			return true;
+		}
+
+		constexpr void swap(dense_count_set &other) noexcept
+		{
+			using std::swap;
+			swap(m_runs, other.m_runs);
+			swap(m_size, other.m_size);
+		}
+		friend constexpr void swap(dense_count_set &a, dense_count_set &b) noexcept { a.swap(b); }
+
+	private:
+		[[nodiscard]] constexpr size_type count_impl(run_ptr run) const noexcept
+		{
+			return run != m_runs.end() ? (*run).second : 0;
+		}
+		[[nodiscard]] constexpr std::pair<const_iterator, const_iterator> equal_range_impl(run_ptr run) const noexcept
+		{
+			if (run == m_runs.end()) return {end(), end()};
+			return {const_iterator{run, 0}, const_iterator{std::next(run), 0}};
+		}
+
+		template<typename V>
+		constexpr const_iterator insert_n_impl(V &&value, size_type n)
+		{
+			if (n == 0) [[unlikely]]
+				return end();
+
+			const auto result = m_runs.try_emplace(std::forward<V>(value), 0).first;
+			result->second += n;
+			m_size += n;
+			return const_iterator{result, 0};
+		}
+
+		run_map m_runs;
+		size_type m_size = 0;
+	};
+}	 // namespace sek
\ No newline at end of file
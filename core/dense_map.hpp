@@ -5,6 +5,7 @@
 #pragma once
 
 #include <iterator>
+#include <ranges>
 #include <stdexcept>
 
 #include "assert.hpp"
@@ -20,6 +21,9 @@ namespace sek
 	 * optimal cache locality. Dense maps may invalidate iterators on insertion due to the internal packed storage
 	 * being re-sized. On erasure, iterators to the erased element and elements after the erased one may be invalidated.
 	 *
+	 * Small maps (up to 8 elements) do not allocate a bucket array and instead search all elements linearly.
+	 * The bucket array is built once the map grows past that threshold, or when capacity for more elements is reserved.
+	 *
 	 * @note Due to internal implementation, iterators of the map return a pair of references, instead of reference to a pair.
 	 *
 	 * @tparam K Type of objects used as keys.
@@ -211,6 +215,40 @@ namespace sek
 		{
 		}
 
+		/** Constructs a map from a sequence of values with unique keys. Unlike the range constructor, the sequence
+		 * is not checked for duplicate keys, thus the map is built in a single pass without any lookups.
+		 * @param first Iterator to the start of the value sequence.
+		 * @param first Iterator to the end of the value sequence.
+		 * @param key_compare Key comparator.
+		 * @param key_hash Key hasher.
+		 * @param alloc Allocator used to allocate map's value array.
+		 * @warning If the sequence contains duplicate keys, behavior is undefined. */
+		template<std::forward_iterator Iterator>
+		[[nodiscard]] constexpr static dense_map from_unique_range(Iterator first,
+																   Iterator last,
+																   const key_equal &key_compare = {},
+																   const hash_type &key_hash = {},
+																   const allocator_type &alloc = allocator_type{})
+		{
+			dense_map result{key_compare, key_hash, alloc};
+			result.m_table.insert_unique(first, last);
+			return result;
+		}
+		/** @copybrief from_unique_range
+		 * @param values Forward range of values.
+		 * @param key_compare Key comparator.
+		 * @param key_hash Key hasher.
+		 * @param alloc Allocator used to allocate map's value array.
+		 * @warning If the range contains duplicate keys, behavior is undefined. */
+		template<std::ranges::forward_range R>
+		[[nodiscard]] constexpr static dense_map from_unique_range(R &&values,
+																   const key_equal &key_compare = {},
+																   const hash_type &key_hash = {},
+																   const allocator_type &alloc = allocator_type{})
+		{
+			return from_unique_range(std::ranges::begin(values), std::ranges::end(values), key_compare, key_hash, alloc);
+		}
+
 		/** Copy-constructs the map. Allocator is copied via `select_on_container_copy_construction`.
 		 * @param other Map to copy data and allocators from. */
 		constexpr dense_map(const dense_map &other) : m_table(other.m_table) {}
@@ -300,6 +338,37 @@ namespace sek
 		{
 			return find(key) != end();
 		}
+
+		/** Locates elements for a range of keys. Keys are processed in batches, hashes & buckets of all keys of a batch
+		 * are fetched before any of the keys is resolved, which allows cache misses of individual lookups to overlap.
+		 * @param keys Forward range of keys to search for.
+		 * @param out Output iterator receiving iterators to the elements mapped to the keys (or `end()`), in order.
+		 * @return Output iterator past the last written iterator.
+		 * @note Heterogeneous keys are accepted only if both key hasher and key comparator are transparent. */
+		template<std::ranges::forward_range R, std::output_iterator<iterator> O>
+		constexpr O find_batch(const R &keys, O out)
+			requires(std::same_as<std::ranges::range_value_t<R>, key_type> || transparent_key)
+		{
+			return m_table.find_batch(keys, out);
+		}
+		/** @copydoc find_batch */
+		template<std::ranges::forward_range R, std::output_iterator<const_iterator> O>
+		constexpr O find_batch(const R &keys, O out) const
+			requires(std::same_as<std::ranges::range_value_t<R>, key_type> || transparent_key)
+		{
+			return m_table.find_batch(keys, out);
+		}
+		/** Checks if the map contains elements for a range of keys.
+		 * @param keys Forward range of keys to search for.
+		 * @param out Output iterator receiving `bool` results of the individual checks, in order.
+		 * @return Output iterator past the last written result.
+		 * @note Heterogeneous keys are accepted only if both key hasher and key comparator are transparent. */
+		template<std::ranges::forward_range R, std::output_iterator<bool> O>
+		constexpr O contains_batch(const R &keys, O out) const
+			requires(std::same_as<std::ranges::range_value_t<R>, key_type> || transparent_key)
+		{
+			return m_table.contains_batch(keys, out);
+		}
 		// clang-format on
 
 		/** Returns reference to object mapped to the specific key.
@@ -371,6 +440,9 @@ namespace sek
 		constexpr void rehash(size_type capacity) { m_table.rehash(capacity); }
 		/** Resizes the internal storage to have space for at least n elements. */
 		constexpr void reserve(size_type n) { m_table.reserve(n); }
+		/** Removes holes left by erasure from the internal storage & re-links the remaining elements.
+		 * @note Only has effect for maps using tombstone erasure (see `tombstone_hash`). Invalidates iterators. */
+		constexpr void compact() { m_table.compact(); }
 
 		/** Attempts to construct a value in-place at the specified key.
 		 * If such key is already associated with a value, does nothing.
@@ -600,6 +672,20 @@ namespace sek
 			m_table.max_load_factor = f;
 		}
 
+		/** Checks if incremental rehashing is enabled. */
+		[[nodiscard]] constexpr bool incremental_rehash() const noexcept { return m_table.incremental_rehash; }
+		/** Enables or disables incremental rehashing.
+		 *
+		 * When enabled, growth of the map does not re-link all elements at once. Instead, the new bucket array is
+		 * initialized & elements are migrated to it in fixed-size steps on subsequent insertions and erasures, keeping
+		 * both bucket arrays alive until the migration is complete. This bounds latency of individual insertions at the
+		 * cost of temporary memory overhead.
+		 *
+		 * @note Local iterators & `bucket_size` are not available while a migration is in progress. Explicit call to
+		 * `rehash` (ex. `rehash(bucket_count())`) completes any pending migration.
+		 * @note Storage of elements still grows geometrically, use `reserve` to avoid its re-allocation. */
+		constexpr void incremental_rehash(bool value) noexcept { m_table.incremental_rehash = value; }
+
 		[[nodiscard]] constexpr allocator_type get_allocator() const noexcept
 		{
 			return allocator_type{m_table.allocator()};
@@ -617,6 +703,15 @@ namespace sek
 		constexpr void swap(dense_map &other) noexcept { m_table.swap(other.m_table); }
 		friend constexpr void swap(dense_map &a, dense_map &b) noexcept { a.swap(b); }
 
+		/** Removes all elements that satisfy the predicate `pred` from the map in a single pass.
+		 * @return Amount of elements removed.
+		 * @note Invalidates iterators. */
+		template<typename P>
+		friend constexpr size_type erase_if(dense_map &map, P pred)
+		{
+			return map.m_table.erase_if(pred);
+		}
+
 	private:
 		/** Hash table used to implement the map. */
 		table_type m_table;
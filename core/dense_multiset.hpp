@@ -40,11 +40,15 @@ namespace sek
 		constexpr static size_type key_size = std::tuple_size_v<Key>;
 
 	private:
+		using bucket_policy = typename table_traits::bucket_policy;
+
 		using table_traits::get_key;
 		using table_traits::initial_capacity;
 		using table_traits::initial_load_factor;
 		using table_traits::npos;
 
+		using index_type = typename table_traits::index_type;
+
 		template<size_type I>
 		using n_key_type = std::tuple_element_t<I, key_type>;
 		template<size_type I>
@@ -66,7 +70,7 @@ namespace sek
 		{
 		public:
 			constexpr sparse_entry() noexcept = default;
-			constexpr explicit sparse_entry(size_type value) noexcept
+			constexpr explicit sparse_entry(index_type value) noexcept
 			{
 				std::fill(m_values.begin(), m_values.end(), value);
 			}
@@ -78,13 +82,43 @@ namespace sek
 			friend constexpr void swap(sparse_entry &a, sparse_entry &b) noexcept { a.swap(b); }
 
 		private:
-			std::array<size_type, key_size> m_values = {};
+			std::array<index_type, key_size> m_values = {};
 		};
 
 		using sparse_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<sparse_entry>;
 		using sparse_data = std::vector<sparse_entry, sparse_alloc>;
 
-		struct dense_entry
+		/* Compact multisets do not cache hashes of the keys, see `detail::dense_entry_hash`. */
+		struct cached_entry_hash
+		{
+			template<size_type I>
+			[[nodiscard]] constexpr bool hash_eq(std::size_t h) const noexcept
+			{
+				return hash[I] == h;
+			}
+			template<size_type I>
+			constexpr void set_hash(std::size_t h) noexcept
+			{
+				hash[I] = h;
+			}
+
+			std::array<std::size_t, key_size> hash = {};
+		};
+		struct uncached_entry_hash
+		{
+			template<size_type I>
+			[[nodiscard]] constexpr bool hash_eq(std::size_t) const noexcept
+			{
+				return true;
+			}
+			template<size_type I>
+			constexpr void set_hash(std::size_t) noexcept
+			{
+			}
+		};
+		using entry_hash_base = std::conditional_t<table_traits::cache_hash, cached_entry_hash, uncached_entry_hash>;
+
+		struct dense_entry : entry_hash_base
 		{
 			constexpr dense_entry() = default;
 			constexpr dense_entry(const dense_entry &) = default;
@@ -111,7 +145,7 @@ namespace sek
 				using std::swap;
 				swap(value, other.value);
 				swap(next, other.next);
-				swap(hash, other.hash);
+				swap(static_cast<entry_hash_base &>(*this), static_cast<entry_hash_base &>(other));
 			}
 			friend constexpr void swap(dense_entry &a, dense_entry &b) noexcept(std::is_nothrow_swappable_v<value_type>)
 			{
@@ -120,8 +154,7 @@ namespace sek
 
 			value_type value;
 
-			std::array<size_type, key_size> next = {};
-			std::array<size_type, key_size> hash = {};
+			std::array<index_type, key_size> next = {};
 		};
 
 		using dense_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<dense_entry>;
@@ -267,7 +300,9 @@ namespace sek
 										  const allocator_type &alloc = allocator_type{})
 			: m_dense{dense_alloc{alloc}, key_compare},
 			  m_sparse{std::piecewise_construct,
-					   std::forward_as_tuple(capacity, sparse_entry{npos}, sparse_alloc{alloc}),
+					   std::forward_as_tuple(bucket_policy::round_count(capacity),
+											 sparse_entry{npos},
+											 sparse_alloc{alloc}),
 					   std::forward_as_tuple(key_hash)}
 		{
 		}
@@ -436,10 +471,10 @@ namespace sek
 
 			/* Adjust the capacity to be at least large enough to fit the current size. */
 			const auto load_cap = static_cast<size_type>(static_cast<float>(size()) / m_max_load_factor);
-			capacity = max(max(load_cap, capacity), initial_capacity);
+			capacity = bucket_policy::round_count(max(max(load_cap, capacity), initial_capacity));
 
 			/* Don't do anything if the capacity did not change after the adjustment. */
-			if (capacity != bucket_vector().capacity()) [[likely]]
+			if (capacity != bucket_count()) [[likely]]
 				rehash_impl(capacity);
 		}
 		/** Resizes the internal storage to have space for at least n elements. */
@@ -541,7 +576,7 @@ namespace sek
 		/** Returns maximum possible amount of elements in the set. */
 		[[nodiscard]] constexpr size_type max_size() const noexcept
 		{
-			const auto max_idx = std::min(value_vector().max_size(), npos - 1);
+			const auto max_idx = std::min(value_vector().max_size(), static_cast<size_type>(npos) - 1);
 			return static_cast<size_type>(static_cast<float>(max_idx) * m_max_load_factor);
 		}
 		/** Checks if the set is empty. */
@@ -601,17 +636,25 @@ namespace sek
 
 		[[nodiscard]] constexpr auto key_hash(const auto &k) const { return m_sparse.second()(k); }
 		[[nodiscard]] constexpr auto key_comp(const auto &a, const auto &b) const { return m_dense.second()(a, b); }
+		template<size_type I>
+		[[nodiscard]] constexpr std::size_t entry_hash(const dense_entry &entry) const
+		{
+			if constexpr (table_traits::cache_hash)
+				return entry.hash[I];
+			else
+				return key_hash(entry.template key<I>());
+		}
 
 		template<size_type I>
-		[[nodiscard]] constexpr size_type *get_chain(std::size_t h) noexcept
+		[[nodiscard]] constexpr index_type *get_chain(std::size_t h) noexcept
 		{
-			const auto idx = h % bucket_count();
+			const auto idx = bucket_policy::index(h, bucket_count());
 			return &(bucket_vector()[idx][I]);
 		}
 		template<size_type I>
-		[[nodiscard]] constexpr const size_type *get_chain(std::size_t h) const noexcept
+		[[nodiscard]] constexpr const index_type *get_chain(std::size_t h) const noexcept
 		{
-			const auto idx = h % bucket_count();
+			const auto idx = bucket_policy::index(h, bucket_count());
 			return &(bucket_vector()[idx][I]);
 		}
 
@@ -621,10 +664,7 @@ namespace sek
 			for (auto *idx = get_chain<I>(h); *idx != npos;)
 			{
 				const auto &entry = value_vector()[*idx];
-				const auto &entry_key = entry.template key<I>();
-				const auto entry_hash = entry.hash[I];
-
-				if (entry_hash == h && key_comp(key, entry_key))
+				if (entry.template hash_eq<I>(h) && key_comp(key, entry.template key<I>()))
 					return *idx;
 				else
 					idx = &entry.next[I];
@@ -642,11 +682,11 @@ namespace sek
 			const auto move_chain = [&]<size_type I>(index_selector_t<I>)
 			{
 				/* Find the chain offset pointing to the old position & replace it with the new position. */
-				for (auto *chain_idx = get_chain<I>(src.hash[I]); *chain_idx != npos;
+				for (auto *chain_idx = get_chain<I>(entry_hash<I>(src)); *chain_idx != npos;
 					 chain_idx = &(value_vector()[*chain_idx].next[I]))
 					if (*chain_idx == from)
 					{
-						*chain_idx = to;
+						*chain_idx = static_cast<index_type>(to);
 						break;
 					}
 			};
@@ -658,14 +698,14 @@ namespace sek
 		constexpr void unlink_entry(dense_entry &entry)
 		{
 			const auto &key = entry.template key<I>();
-			const auto hash = entry.hash[I];
+			const auto hash = entry_hash<I>(entry);
 			for (auto *chain_idx = get_chain<I>(hash); *chain_idx != npos;)
 			{
 				const auto pos = *chain_idx;
 				auto entry_ptr = value_vector().data() + static_cast<difference_type>(pos);
 
 				/* Un-link the entry from the chain. */
-				if (entry_ptr->hash[I] == hash && key_comp(key, entry_ptr->template key<I>()))
+				if (entry_ptr->template hash_eq<I>(hash) && key_comp(key, entry_ptr->template key<I>()))
 				{
 					*chain_idx = entry_ptr->next[I];
 					break;
@@ -685,13 +725,15 @@ namespace sek
 			maybe_rehash();
 
 			auto insert_pos = value_vector().size(); /* Position could be modified during replacement. */
+			SEK_ASSERT(insert_pos < npos, "Multiset size exceeds the range of chain indices");
 			auto *entry_ptr = &value_vector().emplace_back(std::forward<Args>(args)...);
 
 			/* Remove & re-insert the entry for every bucket chain. */
 			const auto replace_key = [&]<size_type I>(index_selector_t<I>) -> size_type
 			{
 				const auto &key = entry_ptr->template key<I>();
-				const auto hash = entry_ptr->hash[I] = key_hash(key);
+				const auto hash = key_hash(key);
+				entry_ptr->template set_hash<I>(hash);
 
 				/* If a conflicting entry within the chain is found, swap it with the last entry & pop the stack. */
 				auto *chain_idx = get_chain<I>(hash);
@@ -699,7 +741,7 @@ namespace sek
 				{
 					const auto conflict_pos = *chain_idx;
 					auto &conflict_entry = value_vector().data()[conflict_pos];
-					if (conflict_entry.hash[I] == hash && key_comp(key, conflict_entry.template key<I>()))
+					if (conflict_entry.template hash_eq<I>(hash) && key_comp(key, conflict_entry.template key<I>()))
 					{
 						/* Unlink the conflicting entry from every bucket chain. Replacing the entry in-place is
 						 * impossible, since different keys will belong to different bucket chains, thus requireing
@@ -721,7 +763,7 @@ namespace sek
 
 						/* Insert the entry into the current bucket chain. */
 						entry_ptr->next[I] = *chain_idx;
-						*chain_idx = insert_pos;
+						*chain_idx = static_cast<index_type>(insert_pos);
 
 						/* Pop the erased entry. */
 						value_vector().pop_back();
@@ -732,7 +774,7 @@ namespace sek
 
 				/* If there is no conflicting entry for the current bucket chain, insert it at the end. */
 				entry_ptr->next[I] = *chain_idx;
-				*chain_idx = insert_pos;
+				*chain_idx = static_cast<index_type>(insert_pos);
 				return 0;
 			};
 
@@ -765,9 +807,9 @@ namespace sek
 		{
 			const auto chain_insert = [&]<size_type I>(index_selector_t<I>, dense_entry &entry, size_type pos)
 			{
-				auto *chain_idx = get_chain<I>(entry.hash[I]);
+				auto *chain_idx = get_chain<I>(entry_hash<I>(entry));
 				entry.next[I] = *chain_idx;
-				*chain_idx = pos;
+				*chain_idx = static_cast<index_type>(pos);
 			};
 
 			/* Clear & reserve the vector filled with npos. */
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <iterator>
+#include <ranges>
 #include <stdexcept>
 
 #include "assert.hpp"
@@ -156,6 +157,40 @@ namespace sek
 		{
 		}
 
+		/** Constructs a set from a sequence of values with unique keys. Unlike the range constructor, the sequence
+		 * is not checked for duplicate keys, thus the set is built in a single pass without any lookups.
+		 * @param first Iterator to the start of the value sequence.
+		 * @param first Iterator to the end of the value sequence.
+		 * @param key_compare Key comparator.
+		 * @param key_hash Key hasher.
+		 * @param alloc Allocator used to allocate set's value array.
+		 * @warning If the sequence contains duplicate keys, behavior is undefined. */
+		template<std::forward_iterator Iterator>
+		[[nodiscard]] constexpr static dense_set from_unique_range(Iterator first,
+																   Iterator last,
+																   const KeyComp &key_compare = {},
+																   const KeyHash &key_hash = {},
+																   const allocator_type &alloc = allocator_type{})
+		{
+			dense_set result{key_compare, key_hash, alloc};
+			result.m_table.insert_unique(first, last);
+			return result;
+		}
+		/** @copybrief from_unique_range
+		 * @param values Forward range of values.
+		 * @param key_compare Key comparator.
+		 * @param key_hash Key hasher.
+		 * @param alloc Allocator used to allocate set's value array.
+		 * @warning If the range contains duplicate keys, behavior is undefined. */
+		template<std::ranges::forward_range R>
+		[[nodiscard]] constexpr static dense_set from_unique_range(R &&values,
+																   const KeyComp &key_compare = {},
+																   const KeyHash &key_hash = {},
+																   const allocator_type &alloc = allocator_type{})
+		{
+			return from_unique_range(std::ranges::begin(values), std::ranges::end(values), key_compare, key_hash, alloc);
+		}
+
 		/** Copy-constructs the set. Allocator is copied via `select_on_container_copy_construction`.
 		 * @param other Map to copy data and allocators from. */
 		constexpr dense_set(const dense_set &other) : m_table(other.m_table) {}
@@ -236,6 +271,30 @@ namespace sek
 		{
 			return find(key) != end();
 		}
+
+		/** Locates elements for a range of keys. Keys are processed in batches, hashes & buckets of all keys of a batch
+		 * are fetched before any of the keys is resolved, which allows cache misses of individual lookups to overlap.
+		 * @param keys Forward range of keys to search for.
+		 * @param out Output iterator receiving iterators to the matching elements (or `end()`), in order.
+		 * @return Output iterator past the last written iterator.
+		 * @note Heterogeneous keys are accepted only if both key hasher and key comparator are transparent. */
+		template<std::ranges::forward_range R, std::output_iterator<const_iterator> O>
+		constexpr O find_batch(const R &keys, O out) const
+			requires(std::same_as<std::ranges::range_value_t<R>, key_type> || transparent_key)
+		{
+			return m_table.find_batch(keys, out);
+		}
+		/** Checks if the set contains a range of elements.
+		 * @param keys Forward range of keys to search for.
+		 * @param out Output iterator receiving `bool` results of the individual checks, in order.
+		 * @return Output iterator past the last written result.
+		 * @note Heterogeneous keys are accepted only if both key hasher and key comparator are transparent. */
+		template<std::ranges::forward_range R, std::output_iterator<bool> O>
+		constexpr O contains_batch(const R &keys, O out) const
+			requires(std::same_as<std::ranges::range_value_t<R>, key_type> || transparent_key)
+		{
+			return m_table.contains_batch(keys, out);
+		}
 		// clang-format on
 
 		/** Empties the set's contents. */
@@ -245,6 +304,9 @@ namespace sek
 		constexpr void rehash(size_type capacity) { m_table.rehash(capacity); }
 		/** Resizes the internal storage to have space for at least n elements. */
 		constexpr void reserve(size_type n) { m_table.reserve(n); }
+		/** Removes holes left by erasure from the internal storage & re-links the remaining elements.
+		 * @note Only has effect for sets using tombstone erasure (see `tombstone_hash`). Invalidates iterators. */
+		constexpr void compact() { m_table.compact(); }
 
 		/** Constructs a value (of value_type) in-place.
 		 * If the same value is already present within the set, replaces that value.
@@ -437,6 +499,20 @@ namespace sek
 			m_table.max_load_factor = f;
 		}
 
+		/** Checks if incremental rehashing is enabled. */
+		[[nodiscard]] constexpr bool incremental_rehash() const noexcept { return m_table.incremental_rehash; }
+		/** Enables or disables incremental rehashing.
+		 *
+		 * When enabled, growth of the set does not re-link all elements at once. Instead, the new bucket array is
+		 * initialized & elements are migrated to it in fixed-size steps on subsequent insertions and erasures, keeping
+		 * both bucket arrays alive until the migration is complete. This bounds latency of individual insertions at the
+		 * cost of temporary memory overhead.
+		 *
+		 * @note Local iterators & `bucket_size` are not available while a migration is in progress. Explicit call to
+		 * `rehash` (ex. `rehash(bucket_count())`) completes any pending migration.
+		 * @note Storage of elements still grows geometrically, use `reserve` to avoid its re-allocation. */
+		constexpr void incremental_rehash(bool value) noexcept { m_table.incremental_rehash = value; }
+
 		[[nodiscard]] constexpr allocator_type get_allocator() const noexcept
 		{
 			return allocator_type{m_table.allocator()};
@@ -454,6 +530,15 @@ namespace sek
 		constexpr void swap(dense_set &other) noexcept { m_table.swap(other.m_table); }
 		friend constexpr void swap(dense_set &a, dense_set &b) noexcept { a.swap(b); }
 
+		/** Removes all elements that satisfy the predicate `pred` from the set in a single pass.
+		 * @return Amount of elements removed.
+		 * @note Invalidates iterators. */
+		template<typename P>
+		friend constexpr size_type erase_if(dense_set &set, P pred)
+		{
+			return set.m_table.erase_if(pred);
+		}
+
 	private:
 		/** Hash table used to implement the set. */
 		table_type m_table;
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <bit>
+#include <functional>
 
 #include "../define.h"
 #include "packed_pair.hpp"
@@ -37,6 +38,7 @@ namespace sek::detail
 		basic_pool &operator=(const basic_pool &) = delete;
 
 		constexpr basic_pool() noexcept = default;
+		constexpr explicit basic_pool(const Alloc &alloc) noexcept : m_alloc_pages(alloc_type{alloc}, nullptr) {}
 		explicit basic_pool(std::size_t cap) { make_page(cap); }
 		constexpr basic_pool(basic_pool &&other) noexcept { swap(other); }
 		constexpr basic_pool &operator=(basic_pool &&other) noexcept
@@ -86,6 +88,30 @@ namespace sek::detail
 			m_total_cap += cap;
 		}
 
+		/** Checks if the node pointed to by `ptr` belongs to a page of this pool. */
+		[[nodiscard]] bool owns(const T *ptr) const noexcept
+		{
+			const auto node = std::bit_cast<const node_t *>(ptr);
+			for (auto *page = m_alloc_pages.second(); page != nullptr; page = page->next)
+			{
+				const auto nodes = std::bit_cast<const node_t *>(page) + header_nodes;
+				if (std::less_equal<>{}(nodes, node) && std::less<>{}(node, nodes + page->capacity)) return true;
+			}
+			return false;
+		}
+		/** Takes ownership of pages of `other`. Free nodes of `other` are not re-used until the pool is released. */
+		void splice(basic_pool &other) noexcept
+		{
+			if (auto *first = std::exchange(other.last_page(), nullptr); first != nullptr) [[likely]]
+			{
+				auto *page = first;
+				while (page->next != nullptr) page = page->next;
+				page->next = std::exchange(last_page(), first);
+				m_total_cap += std::exchange(other.m_total_cap, 0);
+			}
+			other.m_next_free = nullptr;
+		}
+
 		void release()
 		{
 			for (auto *page = last_page(); page != nullptr;)
@@ -104,6 +130,7 @@ namespace sek::detail
 			using std::swap;
 			swap(m_alloc_pages, other.m_alloc_pages);
 			swap(m_next_free, other.m_next_free);
+			swap(m_total_cap, other.m_total_cap);
 		}
 
 		constexpr alloc_type &get_alloc() noexcept { return m_alloc_pages.first(); }
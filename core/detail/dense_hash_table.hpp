@@ -15,14 +15,39 @@
 
 namespace sek::detail
 {
-	template<typename Value, typename KeyGet>
-	class dense_table_entry
+	/* Hashes of entries are cached to avoid re-hashing keys on rehash & to skip key comparisons on mismatch.
+	 * Compact tables do not cache hashes, in which case every entry is considered a potential match. */
+	template<bool CacheHash>
+	struct dense_entry_hash
 	{
+		[[nodiscard]] constexpr bool hash_eq(std::size_t h) const noexcept { return hash == h; }
+		constexpr void set_hash(std::size_t h) noexcept { hash = h; }
+
+		std::size_t hash = {};
+	};
+	template<>
+	struct dense_entry_hash<false>
+	{
+		[[nodiscard]] constexpr bool hash_eq(std::size_t) const noexcept { return true; }
+		constexpr void set_hash(std::size_t) noexcept {}
+	};
+
+	template<typename Value, typename KeyGet, typename Index = std::size_t, bool CacheHash = true>
+	class dense_table_entry : public dense_entry_hash<CacheHash>
+	{
+		using hash_base = dense_entry_hash<CacheHash>;
+
 	public:
 		typedef std::size_t size_type;
 		typedef std::ptrdiff_t difference_type;
+		typedef Index index_type;
+
+		constexpr static index_type npos = std::numeric_limits<index_type>::max();
+		constexpr static bool cache_hash = CacheHash;
 
-		constexpr static size_type npos = std::numeric_limits<size_type>::max();
+		/* Holes left by tombstone erasure are marked by the high bit of `bucket_next`, the rest of which contains
+		 * the 1-based index of the next hole within the free list (or 0 if there are no more holes). */
+		constexpr static index_type hole_bit = static_cast<index_type>(index_type{1} << (sizeof(index_type) * 8 - 1));
 
 	public:
 		constexpr dense_table_entry() = default;
@@ -41,6 +66,7 @@ namespace sek::detail
 		// clang-format on
 
 		[[nodiscard]] constexpr decltype(auto) key() const noexcept { return KeyGet{}(value); }
+		[[nodiscard]] constexpr bool is_hole() const noexcept { return bucket_next != npos && (bucket_next & hole_bit); }
 
 		constexpr void swap(dense_table_entry &other) noexcept(std::is_nothrow_swappable_v<Value>)
 		{
@@ -48,7 +74,7 @@ namespace sek::detail
 
 			swap(value, other.value);
 			swap(bucket_next, other.bucket_next);
-			swap(hash, other.hash);
+			swap(static_cast<hash_base &>(*this), static_cast<hash_base &>(other));
 		}
 		friend constexpr void swap(dense_table_entry &a, dense_table_entry &b) noexcept(std::is_nothrow_swappable_v<Value>)
 		{
@@ -56,8 +82,7 @@ namespace sek::detail
 		}
 
 		Value value;
-		size_type bucket_next = npos;
-		std::size_t hash = {};
+		index_type bucket_next = npos;
 	};
 
 	template<typename Value, typename Hash, typename Cmp, typename KeyGet>
@@ -66,15 +91,48 @@ namespace sek::detail
 		typedef Cmp key_equal;
 		typedef Hash hash_type;
 
-		typedef dense_table_entry<Value, KeyGet> entry_type;
+		typedef dense_table_entry<Value, KeyGet, table_index_t<Hash>, table_cache_hash_v<Hash>> entry_type;
+		typedef table_bucket_policy_t<Hash> bucket_policy;
 		typedef typename entry_type::size_type size_type;
 		typedef typename entry_type::difference_type difference_type;
+		typedef typename entry_type::index_type index_type;
 
 		[[nodiscard]] constexpr static decltype(auto) get_key(const auto &v) { return KeyGet{}(v); }
 
 		constexpr static float initial_load_factor = .875f;
-		constexpr static size_type npos = entry_type::npos;
+		constexpr static index_type npos = entry_type::npos;
 		constexpr static size_type initial_capacity = 8;
+		/* Tables do not allocate the bucket array until they contain more than `small_size` elements. Until then,
+		 * all entries are linked into a single chain, the head of which is stored within the table. */
+		constexpr static size_type small_size = 8;
+		constexpr static bool cache_hash = entry_type::cache_hash;
+		constexpr static bool tombstones = table_tombstones_v<Hash>;
+	};
+
+	/* End of the entry array is only required by iterators of tables which use tombstone erasure. */
+	template<typename P, bool>
+	struct dense_iterator_end
+	{
+		constexpr dense_iterator_end() noexcept = default;
+		constexpr explicit dense_iterator_end(P) noexcept {}
+
+		[[nodiscard]] constexpr P get_end() const noexcept { return {}; }
+
+		[[nodiscard]] constexpr auto operator<=>(const dense_iterator_end &) const noexcept = default;
+		[[nodiscard]] constexpr bool operator==(const dense_iterator_end &) const noexcept = default;
+	};
+	template<typename P>
+	struct dense_iterator_end<P, true>
+	{
+		constexpr dense_iterator_end() noexcept = default;
+		constexpr explicit dense_iterator_end(P end) noexcept : m_end(end) {}
+
+		[[nodiscard]] constexpr P get_end() const noexcept { return m_end; }
+
+		[[nodiscard]] constexpr auto operator<=>(const dense_iterator_end &) const noexcept = default;
+		[[nodiscard]] constexpr bool operator==(const dense_iterator_end &) const noexcept = default;
+
+		P m_end = {};
 	};
 
 	/* Dense hash tables are implemented via a sparse array of bucket indices & a dense array of buckets,
@@ -98,7 +156,17 @@ namespace sek::detail
 	 * to the erased and the swapped-with bucket are also updated. In order to do so, the swapped-with bucket's
 	 * chain is traversed and is updated accordingly.
 	 *
-	 * In order for this to not affect performance, the default load factor is set to be below 1. */
+	 * In order for this to not affect performance, the default load factor is set to be below 1.
+	 *
+	 * Optionally, the table can grow incrementally. In that case, on growth the new sparse array is first filled in
+	 * fixed-size steps (while all lookups still use the old array), after which chains of the old array are migrated
+	 * to the new array in fixed-size steps. During migration, a key is located in the old array if its old bucket
+	 * was not migrated yet, otherwise it is located in the new array. Every insertion & erasure performs one step,
+	 * thus no single operation has to re-link the whole table.
+	 *
+	 * Tables using tombstone erasure do not move the last entry into the erased one. Instead, erased entries are
+	 * un-linked from their chains & pushed onto a free list, to be re-used by future insertions. Iterators of such
+	 * tables skip the holes, and holes are removed from the dense array only on explicit compaction or rehash. */
 	template<typename Key, typename Value, typename Traits, typename Hash, typename Cmp, typename KeyGet, typename Alloc>
 	class dense_hash_table : dense_table_traits<Value, Hash, Cmp, KeyGet>
 	{
@@ -111,27 +179,41 @@ namespace sek::detail
 		typedef typename table_traits::difference_type difference_type;
 
 	private:
+		using bucket_policy = typename table_traits::bucket_policy;
+
 		using table_traits::get_key;
 		using table_traits::initial_capacity;
 		using table_traits::initial_load_factor;
 		using table_traits::npos;
+		using table_traits::small_size;
+
+		/* Amount of buckets filled & amount of chains migrated per step of an incremental rehash. */
+		constexpr static size_type rehash_fill_step = 1024;
+		constexpr static size_type rehash_chain_step = 16;
 
 		using entry_type = typename table_traits::entry_type;
+		using index_type = typename table_traits::index_type;
+
+		/* Tombstone tables reserve the high bit of chain indices for marking holes. */
+		constexpr static size_type max_index = table_traits::tombstones ? entry_type::hole_bit - 2 : npos - 1;
 
-		using sparse_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<size_type>;
-		using sparse_data = std::vector<size_type, sparse_alloc>;
+		using sparse_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<index_type>;
+		using sparse_data = std::vector<index_type, sparse_alloc>;
 		using dense_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<entry_type>;
 		using dense_data = std::vector<entry_type, dense_alloc>;
 
 		template<bool IsConst>
 		class dense_table_iterator
+			: dense_iterator_end<std::conditional_t<IsConst, const entry_type, entry_type> *, table_traits::tombstones>
 		{
 			template<bool>
 			friend class dense_table_iterator;
 			friend class dense_hash_table;
 
-			using iter_t = std::conditional_t<IsConst, typename dense_data::const_iterator, typename dense_data::iterator>;
 			using ptr_t = std::conditional_t<IsConst, const entry_type, entry_type> *;
+			using end_base = dense_iterator_end<ptr_t, table_traits::tombstones>;
+
+			constexpr static bool tombstones = table_traits::tombstones;
 
 		public:
 			typedef typename Traits::value_type value_type;
@@ -139,17 +221,20 @@ namespace sek::detail
 			typedef std::conditional_t<IsConst, typename Traits::const_reference, typename Traits::reference> reference;
 			typedef std::size_t size_type;
 			typedef std::ptrdiff_t difference_type;
-			typedef std::random_access_iterator_tag iterator_category;
+			typedef std::conditional_t<tombstones, std::bidirectional_iterator_tag, std::random_access_iterator_tag>
+				iterator_category;
 
 		private:
-			constexpr explicit dense_table_iterator(iter_t iter) noexcept : m_ptr(std::to_address(iter)) {}
-			constexpr explicit dense_table_iterator(ptr_t ptr) noexcept : m_ptr(ptr) {}
+			constexpr explicit dense_table_iterator(ptr_t ptr, ptr_t end) noexcept : end_base(end), m_ptr(ptr)
+			{
+				if constexpr (tombstones) skip_holes();
+			}
 
 		public:
 			constexpr dense_table_iterator() noexcept = default;
 			template<bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
 			constexpr dense_table_iterator(const dense_table_iterator<OtherConst> &other) noexcept
-				: dense_table_iterator(other.m_ptr)
+				: end_base(other.get_end()), m_ptr(other.m_ptr)
 			{
 			}
 
@@ -162,9 +247,10 @@ namespace sek::detail
 			constexpr dense_table_iterator &operator++() noexcept
 			{
 				++m_ptr;
+				if constexpr (tombstones) skip_holes();
 				return *this;
 			}
-			constexpr dense_table_iterator &operator+=(difference_type n) noexcept
+			constexpr dense_table_iterator &operator+=(difference_type n) noexcept requires(!tombstones)
 			{
 				m_ptr += n;
 				return *this;
@@ -178,23 +264,28 @@ namespace sek::detail
 			constexpr dense_table_iterator &operator--() noexcept
 			{
 				--m_ptr;
+				if constexpr (tombstones)
+					while (m_ptr->is_hole()) --m_ptr;
 				return *this;
 			}
-			constexpr dense_table_iterator &operator-=(difference_type n) noexcept
+			constexpr dense_table_iterator &operator-=(difference_type n) noexcept requires(!tombstones)
 			{
 				m_ptr -= n;
 				return *this;
 			}
 
 			[[nodiscard]] constexpr dense_table_iterator operator+(difference_type n) const noexcept
+				requires(!tombstones)
 			{
-				return dense_table_iterator{m_ptr + n};
+				return dense_table_iterator{m_ptr + n, nullptr};
 			}
 			[[nodiscard]] constexpr dense_table_iterator operator-(difference_type n) const noexcept
+				requires(!tombstones)
 			{
-				return dense_table_iterator{m_ptr - n};
+				return dense_table_iterator{m_ptr - n, nullptr};
 			}
 			[[nodiscard]] constexpr difference_type operator-(const dense_table_iterator &other) const noexcept
+				requires(!tombstones)
 			{
 				return m_ptr - other.m_ptr;
 			}
@@ -205,17 +296,25 @@ namespace sek::detail
 			[[nodiscard]] constexpr pointer operator->() const noexcept { return get(); }
 
 			/** Returns reference to the element at an offset. */
-			[[nodiscard]] constexpr reference operator[](difference_type n) const noexcept { return m_ptr[n].value; }
+			[[nodiscard]] constexpr reference operator[](difference_type n) const noexcept requires(!tombstones)
+			{
+				return m_ptr[n].value;
+			}
 			/** Returns reference to the target element. */
 			[[nodiscard]] constexpr reference operator*() const noexcept { return *get(); }
 
 			[[nodiscard]] constexpr auto operator<=>(const dense_table_iterator &) const noexcept = default;
 			[[nodiscard]] constexpr bool operator==(const dense_table_iterator &) const noexcept = default;
 
-			constexpr void swap(dense_table_iterator &other) noexcept { std::swap(m_ptr, other.m_ptr); }
+			constexpr void swap(dense_table_iterator &other) noexcept { std::swap(*this, other); }
 			friend constexpr void swap(dense_table_iterator &a, dense_table_iterator &b) noexcept { a.swap(b); }
 
 		private:
+			constexpr void skip_holes() noexcept
+			{
+				while (m_ptr != end_base::m_end && m_ptr->is_hole()) ++m_ptr;
+			}
+
 			ptr_t m_ptr = {};
 		};
 		template<bool IsConst>
@@ -265,7 +364,10 @@ namespace sek::detail
 			}
 
 			/** Returns pointer to the target element. */
-			[[nodiscard]] constexpr pointer get() const noexcept { return pointer{std::addressof(m_ptr->value)}; }
+			[[nodiscard]] constexpr pointer get() const noexcept
+			{
+				return pointer{std::addressof(m_ptr[static_cast<difference_type>(m_off)].value)};
+			}
 			/** @copydoc value */
 			[[nodiscard]] constexpr pointer operator->() const noexcept { return get(); }
 			/** Returns reference to the target element. */
@@ -301,8 +403,39 @@ namespace sek::detail
 		constexpr dense_hash_table() = default;
 		constexpr dense_hash_table(const dense_hash_table &) = default;
 		constexpr dense_hash_table &operator=(const dense_hash_table &) = default;
-		constexpr dense_hash_table(dense_hash_table &&) = default;
-		constexpr dense_hash_table &operator=(dense_hash_table &&) = default;
+		constexpr dense_hash_table(dense_hash_table &&other) noexcept(std::is_nothrow_move_constructible_v<dense_data>)
+			: m_dense{std::move(other.m_dense)},
+			  m_sparse{std::move(other.m_sparse)},
+			  m_small_chain{std::exchange(other.m_small_chain, npos)},
+			  m_rehash_buckets{std::move(other.m_rehash_buckets)},
+			  m_rehash_pos{std::exchange(other.m_rehash_pos, 0)},
+			  m_rehash_target{std::exchange(other.m_rehash_target, 0)},
+			  m_holes{std::exchange(other.m_holes, 0)},
+			  m_free_head{std::exchange(other.m_free_head, 0)},
+			  max_load_factor{other.max_load_factor},
+			  incremental_rehash{other.incremental_rehash}
+		{
+		}
+		constexpr dense_hash_table &operator=(dense_hash_table &&other) noexcept(
+			std::is_nothrow_move_assignable_v<dense_data>)
+		{
+			m_dense = std::move(other.m_dense);
+			m_sparse = std::move(other.m_sparse);
+			m_small_chain = std::exchange(other.m_small_chain, npos);
+			m_rehash_buckets = std::move(other.m_rehash_buckets);
+			m_rehash_pos = std::exchange(other.m_rehash_pos, 0);
+			m_rehash_target = std::exchange(other.m_rehash_target, 0);
+			m_holes = std::exchange(other.m_holes, 0);
+			m_free_head = std::exchange(other.m_free_head, 0);
+			max_load_factor = other.max_load_factor;
+			incremental_rehash = other.incremental_rehash;
+
+			/* Vectors of `other` are left non-empty if the allocators are not equal, reset them to the small chain. */
+			other.value_vector().clear();
+			other.bucket_vector().clear();
+			other.m_rehash_buckets.clear();
+			return *this;
+		}
 		constexpr ~dense_hash_table() = default;
 
 		constexpr dense_hash_table(const Cmp &equal, const Hash &hash, const Alloc &alloc)
@@ -312,8 +445,9 @@ namespace sek::detail
 		constexpr dense_hash_table(size_type bucket_count, const Cmp &equal, const Hash &hash, const Alloc &alloc)
 			: m_dense{dense_alloc{alloc}, equal},
 			  m_sparse{std::piecewise_construct,
-					   std::forward_as_tuple(bucket_count, npos, sparse_alloc{alloc}),
-					   std::forward_as_tuple(hash)}
+					   std::forward_as_tuple(small_bucket_count(bucket_count), npos, sparse_alloc{alloc}),
+					   std::forward_as_tuple(hash)},
+			  m_rehash_buckets{sparse_alloc{alloc}}
 		{
 		}
 		constexpr dense_hash_table(const dense_hash_table &other, const Alloc &alloc)
@@ -323,7 +457,14 @@ namespace sek::detail
 			  m_sparse{std::piecewise_construct,
 					   std::forward_as_tuple(other.bucket_vector(), sparse_alloc{alloc}),
 					   std::forward_as_tuple(other.m_sparse.second())},
-			  max_load_factor{other.max_load_factor}
+			  m_small_chain{other.m_small_chain},
+			  m_rehash_buckets{other.m_rehash_buckets, sparse_alloc{alloc}},
+			  m_rehash_pos{other.m_rehash_pos},
+			  m_rehash_target{other.m_rehash_target},
+			  m_holes{other.m_holes},
+			  m_free_head{other.m_free_head},
+			  max_load_factor{other.max_load_factor},
+			  incremental_rehash{other.incremental_rehash}
 		{
 		}
 
@@ -334,15 +475,26 @@ namespace sek::detail
 			  m_sparse{std::piecewise_construct,
 					   std::forward_as_tuple(std::move(other.bucket_vector()), sparse_alloc{alloc}),
 					   std::forward_as_tuple(std::move(other.m_sparse.second()))},
-			  max_load_factor{other.max_load_factor}
+			  m_small_chain{std::exchange(other.m_small_chain, npos)},
+			  m_rehash_buckets{std::move(other.m_rehash_buckets), sparse_alloc{alloc}},
+			  m_rehash_pos{std::exchange(other.m_rehash_pos, 0)},
+			  m_rehash_target{std::exchange(other.m_rehash_target, 0)},
+			  m_holes{std::exchange(other.m_holes, 0)},
+			  m_free_head{std::exchange(other.m_free_head, 0)},
+			  max_load_factor{other.max_load_factor},
+			  incremental_rehash{other.incremental_rehash}
 		{
+			/* Vectors of `other` are left non-empty if the allocators are not equal, reset them to the small chain. */
+			other.value_vector().clear();
+			other.bucket_vector().clear();
+			other.m_rehash_buckets.clear();
 		}
 
-		[[nodiscard]] constexpr auto begin() noexcept { return iterator{value_vector().begin()}; }
-		[[nodiscard]] constexpr auto cbegin() const noexcept { return const_iterator{value_vector().begin()}; }
+		[[nodiscard]] constexpr auto begin() noexcept { return to_iterator(0); }
+		[[nodiscard]] constexpr auto cbegin() const noexcept { return to_iterator(0); }
 		[[nodiscard]] constexpr auto begin() const noexcept { return cbegin(); }
-		[[nodiscard]] constexpr auto end() noexcept { return iterator{value_vector().end()}; }
-		[[nodiscard]] constexpr auto cend() const noexcept { return const_iterator{value_vector().end()}; }
+		[[nodiscard]] constexpr auto end() noexcept { return to_iterator(value_vector().size()); }
+		[[nodiscard]] constexpr auto cend() const noexcept { return to_iterator(value_vector().size()); }
 		[[nodiscard]] constexpr auto end() const noexcept { return cend(); }
 		[[nodiscard]] constexpr auto rbegin() noexcept { return reverse_iterator{end()}; }
 		[[nodiscard]] constexpr auto crbegin() const noexcept { return const_reverse_iterator{cend()}; }
@@ -351,15 +503,16 @@ namespace sek::detail
 		[[nodiscard]] constexpr auto crend() const noexcept { return const_reverse_iterator{cbegin()}; }
 		[[nodiscard]] constexpr auto rend() const noexcept { return crend(); }
 
-		[[nodiscard]] constexpr size_type size() const noexcept { return value_vector().size(); }
+		[[nodiscard]] constexpr size_type size() const noexcept { return value_vector().size() - m_holes; }
 		[[nodiscard]] constexpr size_type capacity() const noexcept
 		{
 			/* Capacity needs to take into account the max load factor. */
+			if (is_small()) return small_size;
 			return static_cast<size_type>(static_cast<float>(bucket_count()) * max_load_factor);
 		}
 		[[nodiscard]] constexpr size_type max_size() const noexcept
 		{
-			const auto max_idx = std::min(value_vector().max_size(), npos - 1);
+			const auto max_idx = std::min(value_vector().max_size(), static_cast<size_type>(max_index));
 			return static_cast<size_type>(static_cast<float>(max_idx) * max_load_factor);
 		}
 		[[nodiscard]] constexpr float load_factor() const noexcept
@@ -367,16 +520,22 @@ namespace sek::detail
 			return static_cast<float>(size()) / static_cast<float>(bucket_count());
 		}
 
-		[[nodiscard]] constexpr size_type bucket_count() const noexcept { return bucket_vector().size(); }
+		[[nodiscard]] constexpr size_type bucket_count() const noexcept
+		{
+			/* Small tables have a single bucket. */
+			return is_small() ? 1 : bucket_vector().size();
+		}
 		[[nodiscard]] constexpr size_type max_bucket_count() const noexcept { return bucket_vector().max_size(); }
 
 		[[nodiscard]] constexpr auto begin(size_type bucket) noexcept
 		{
-			return local_iterator{value_vector().begin(), bucket};
+			SEK_ASSERT(!is_migrating(), "Bucket interface is not available during incremental rehash");
+			return local_iterator{value_vector().begin(), *get_bucket(bucket)};
 		}
 		[[nodiscard]] constexpr auto cbegin(size_type bucket) const noexcept
 		{
-			return const_local_iterator{value_vector().begin(), bucket};
+			SEK_ASSERT(!is_migrating(), "Bucket interface is not available during incremental rehash");
+			return const_local_iterator{value_vector().begin(), *get_bucket(bucket)};
 		}
 		[[nodiscard]] constexpr auto begin(size_type bucket) const noexcept { return cbegin(bucket); }
 		[[nodiscard]] constexpr auto end(size_type) noexcept { return local_iterator{value_vector().begin(), npos}; }
@@ -390,37 +549,75 @@ namespace sek::detail
 		{
 			return static_cast<size_type>(std::distance(begin(bucket), end(bucket)));
 		}
-		[[nodiscard]] constexpr size_type bucket(const auto &key) const noexcept { return *get_chain(key_hash(key)); }
+		[[nodiscard]] constexpr size_type bucket(const auto &key) const noexcept
+		{
+			return bucket_policy::index(key_hash(key), bucket_count());
+		}
 		[[nodiscard]] constexpr size_type bucket(const_iterator iter) const noexcept
 		{
-			return *get_chain(iter.m_ptr->hash);
+			return bucket_policy::index(entry_hash(*iter.m_ptr), bucket_count());
 		}
 
 		[[nodiscard]] constexpr auto find(const auto &key) noexcept
 		{
-			return begin() + static_cast<difference_type>(find_impl(key_hash(key), key));
+			return to_iterator(find_impl(key_hash(key), key));
 		}
 		[[nodiscard]] constexpr auto find(const auto &key) const noexcept
 		{
-			return begin() + static_cast<difference_type>(find_impl(key_hash(key), key));
+			return to_iterator(find_impl(key_hash(key), key));
+		}
+
+		template<typename R, typename O>
+		constexpr O find_batch(const R &keys, O out)
+		{
+			find_batch_impl(keys, [&](size_type idx) { *out++ = to_iterator(idx); });
+			return out;
+		}
+		template<typename R, typename O>
+		constexpr O find_batch(const R &keys, O out) const
+		{
+			find_batch_impl(keys, [&](size_type idx) { *out++ = to_iterator(idx); });
+			return out;
+		}
+		template<typename R, typename O>
+		constexpr O contains_batch(const R &keys, O out) const
+		{
+			find_batch_impl(keys, [&](size_type idx) { *out++ = idx != value_vector().size(); });
+			return out;
 		}
 
 		constexpr void clear()
 		{
-			std::fill_n(bucket_vector().data(), bucket_count(), npos);
+			cancel_rehash();
+			std::fill_n(bucket_vector().data(), bucket_vector().size(), npos);
+			m_small_chain = npos;
 			value_vector().clear();
+			m_holes = 0;
+			m_free_head = 0;
 		}
 
 		constexpr void rehash(size_type new_cap)
 		{
-			using std::max;
-
-			/* Adjust the capacity to be at least large enough to fit the current size. */
-			new_cap = max(max(static_cast<size_type>(static_cast<float>(size()) / max_load_factor), new_cap), initial_capacity);
-
-			/* Don't do anything if the capacity did not change after the adjustment. */
-			if (new_cap != bucket_vector().capacity()) [[likely]]
+			/* Don't do anything if the capacity did not change after the adjustment. Pending incremental rehash
+			 * is always completed & holes are always removed. */
+			new_cap = adjust_bucket_count(new_cap);
+			if (new_cap != bucket_vector().size() || rehash_pending() || m_holes != 0) [[likely]]
+			{
+				remove_holes();
 				rehash_impl(new_cap);
+			}
+		}
+		constexpr void compact()
+		{
+			if (m_holes != 0)
+			{
+				remove_holes();
+				rehash_impl(bucket_vector().size());
+			}
+		}
+		[[nodiscard]] constexpr bool rehash_pending() const noexcept
+		{
+			return m_rehash_target != 0 || !m_rehash_buckets.empty();
 		}
 		constexpr void reserve(size_type n)
 		{
@@ -433,24 +630,33 @@ namespace sek::detail
 		{
 			/* Temporary entry needs to be created at first. */
 			auto &entry = value_vector().emplace_back(std::forward<Args>(args)...);
-			const auto h = entry.hash = key_hash(entry.key());
+			const auto h = key_hash(entry.key());
+			entry.set_hash(h);
 			auto *chain_idx = get_chain(h);
 			while (*chain_idx != npos)
 				if (auto &candidate = value_vector()[*chain_idx];
-					candidate.hash == h && key_comp(entry.key(), candidate.key()))
+					candidate.hash_eq(h) && key_comp(entry.key(), candidate.key()))
 				{
 					/* Found a candidate for replacing. */
 					candidate.value = std::move(entry.value);
 					value_vector().pop_back(); /* Pop the temporary. */
-					return {begin() + static_cast<difference_type>(*chain_idx), false};
+					return {to_iterator(*chain_idx), false};
 				}
 				else
 					chain_idx = &candidate.bucket_next;
 
-			/* No suitable entry for replacing was found, add new link. */
-			const auto pos = *chain_idx = size() - 1;
+			/* No suitable entry for replacing was found, add new link. Re-use a hole if one is available. */
+			auto pos = value_vector().size() - 1;
+			if (const auto hole = fill_hole(h, std::move(entry.value)); hole != static_cast<size_type>(npos))
+				[[unlikely]]
+			{
+				value_vector().pop_back();
+				pos = hole;
+			}
+			SEK_ASSERT(pos < max_index, "Table size exceeds the range of chain indices");
+			*chain_idx = static_cast<index_type>(pos);
 			maybe_rehash();
-			return {begin() + static_cast<difference_type>(pos), true};
+			return {to_iterator(pos), true};
 		}
 		template<typename... Args>
 		constexpr std::pair<iterator, bool> try_emplace(const auto &key, Args &&...args)
@@ -474,9 +680,12 @@ namespace sek::detail
 		template<std::forward_iterator Iter>
 		constexpr size_type insert(Iter first, Iter last)
 		{
-			size_type inserted = 0;
-			while (first != last) inserted += emplace(*first++).second;
-			return inserted;
+			return bulk_insert<false>(first, last);
+		}
+		template<std::forward_iterator Iter>
+		constexpr size_type insert_unique(Iter first, Iter last)
+		{
+			return bulk_insert<true>(first, last);
 		}
 		constexpr size_type insert(iterator first, iterator last)
 		{
@@ -516,12 +725,25 @@ namespace sek::detail
 
 		constexpr auto erase(const_iterator first, const_iterator last)
 		{
-			/* Iterate backwards here, since iterators after the erased one can be invalidated. */
-			auto result = end();
-			while (first < last) result = erase(--last);
-			return result;
+			if constexpr (table_traits::tombstones)
+			{
+				/* Tombstone erasure does not invalidate other iterators, thus iterate forward. */
+				auto result = end();
+				while (first != last) first = result = erase(first);
+				return result;
+			}
+			else
+			{
+				/* Iterate backwards here, since iterators after the erased one can be invalidated. */
+				auto result = end();
+				while (first < last) result = erase(--last);
+				return result;
+			}
+		}
+		constexpr auto erase(const_iterator where)
+		{
+			return erase_impl(entry_hash(*where.m_ptr), get_key(*where.get()));
 		}
-		constexpr auto erase(const_iterator where) { return erase_impl(where.m_ptr->hash, get_key(*where.get())); }
 
 		// clang-format off
 		template<typename T>
@@ -532,6 +754,42 @@ namespace sek::detail
 		}
 		// clang-format on
 
+		template<typename P>
+		constexpr size_type erase_if(P &&pred)
+		{
+			/* Holes are removed up-front, so that remaining entries can be compacted in a single pass. */
+			remove_holes();
+
+			/* Move retained entries towards the front, then re-link all chains at once. */
+			auto &values = value_vector();
+			size_type pos = 0, i = 0;
+			try
+			{
+				for (; i < values.size(); ++i)
+					if (!pred(*to_iterator(i)))
+					{
+						if (i != pos) values[pos] = std::move(values[i]);
+						++pos;
+					}
+			}
+			catch (...)
+			{
+				/* Moved-from & erased entries are located between `pos` & `i`. */
+				const auto first = values.begin() + static_cast<difference_type>(pos);
+				values.erase(first, values.begin() + static_cast<difference_type>(i));
+				rehash_impl(bucket_vector().size());
+				throw;
+			}
+
+			const auto result = values.size() - pos;
+			if (result != 0)
+			{
+				values.erase(values.begin() + static_cast<difference_type>(pos), values.end());
+				rehash_impl(bucket_vector().size());
+			}
+			return result;
+		}
+
 		[[nodiscard]] constexpr auto allocator() const noexcept { return value_vector().get_allocator(); }
 		[[nodiscard]] constexpr auto &get_hash() const noexcept { return m_sparse.second(); }
 		[[nodiscard]] constexpr auto &get_comp() const noexcept { return m_dense.second(); }
@@ -541,7 +799,14 @@ namespace sek::detail
 			using std::swap;
 			swap(m_sparse, other.m_sparse);
 			swap(m_dense, other.m_dense);
+			swap(m_small_chain, other.m_small_chain);
+			swap(m_rehash_buckets, other.m_rehash_buckets);
+			swap(m_rehash_pos, other.m_rehash_pos);
+			swap(m_rehash_target, other.m_rehash_target);
+			swap(m_holes, other.m_holes);
+			swap(m_free_head, other.m_free_head);
 			swap(max_load_factor, other.max_load_factor);
+			swap(incremental_rehash, other.incremental_rehash);
 		}
 
 	private:
@@ -552,36 +817,97 @@ namespace sek::detail
 
 		[[nodiscard]] constexpr auto key_hash(const auto &k) const { return m_sparse.second()(k); }
 		[[nodiscard]] constexpr auto key_comp(const auto &a, const auto &b) const { return m_dense.second()(a, b); }
+		[[nodiscard]] constexpr std::size_t entry_hash(const entry_type &entry) const
+		{
+			if constexpr (table_traits::cache_hash)
+				return entry.hash;
+			else
+				return key_hash(entry.key());
+		}
 
-		[[nodiscard]] constexpr size_type *get_chain(std::size_t h) noexcept
+		[[nodiscard]] constexpr bool is_migrating() const noexcept
 		{
-			const auto idx = h % bucket_count();
-			return bucket_vector().data() + idx;
+			return m_rehash_target == 0 && !m_rehash_buckets.empty();
+		}
+		[[nodiscard]] constexpr bool is_small() const noexcept { return bucket_vector().empty(); }
+		[[nodiscard]] constexpr const index_type *get_bucket(size_type bucket) const noexcept
+		{
+			return is_small() ? &m_small_chain : bucket_vector().data() + bucket;
+		}
+		[[nodiscard]] constexpr index_type *get_chain(std::size_t h) noexcept
+		{
+			return const_cast<index_type *>(std::as_const(*this).get_chain(h));
 		}
-		[[nodiscard]] constexpr const size_type *get_chain(std::size_t h) const noexcept
+		[[nodiscard]] constexpr const index_type *get_chain(std::size_t h) const noexcept
 		{
-			const auto idx = h % bucket_count();
+			/* Small tables keep all entries within a single chain. */
+			if (is_small()) return &m_small_chain;
+
+			/* If the old bucket of the key was not migrated yet, the key is located in the old bucket array. */
+			if (!m_rehash_buckets.empty() && m_rehash_target == 0) [[unlikely]]
+			{
+				const auto old_idx = bucket_policy::index(h, m_rehash_buckets.size());
+				if (old_idx >= m_rehash_pos) return m_rehash_buckets.data() + old_idx;
+			}
+			const auto idx = bucket_policy::index(h, bucket_count());
 			return bucket_vector().data() + idx;
 		}
 
 		[[nodiscard]] constexpr size_type find_impl(std::size_t h, const auto &key) const noexcept
 		{
-			for (auto *idx = get_chain(h); *idx != npos;)
-				if (auto &entry = value_vector()[*idx]; entry.hash == h && key_comp(key, entry.key()))
+			return find_chain(get_chain(h), h, key);
+		}
+		[[nodiscard]] constexpr size_type find_chain(const index_type *idx, std::size_t h, const auto &key) const
+		{
+			while (*idx != npos)
+				if (auto &entry = value_vector()[*idx]; entry.hash_eq(h) && key_comp(key, entry.key()))
 					return *idx;
 				else
 					idx = &entry.bucket_next;
 			return value_vector().size();
 		}
+		template<typename R, typename F>
+		constexpr void find_batch_impl(const R &keys, F &&f) const
+		{
+			constexpr size_type batch_size = 16;
+
+			std::size_t hashes[batch_size];
+			const index_type *chains[batch_size];
+			for (auto first = std::ranges::begin(keys), last = std::ranges::end(keys); first != last;)
+			{
+				/* Hash a batch of keys & prefetch their buckets, then prefetch the chain heads, and only then resolve
+				 * the keys. This way cache misses of the whole batch overlap instead of being serialized. */
+				size_type n = 0;
+				for (auto key = first; n < batch_size && key != last; ++n, ++key)
+				{
+					hashes[n] = key_hash(*key);
+					chains[n] = get_chain(hashes[n]);
+					table_prefetch(chains[n]);
+				}
+				for (size_type i = 0; i < n; ++i)
+					if (const auto idx = *chains[i]; idx != npos) table_prefetch(value_vector().data() + idx);
+				for (size_type i = 0; i < n; ++i, ++first) f(find_chain(chains[i], hashes[i], *first));
+			}
+		}
 
 		template<typename... Args>
 		[[nodiscard]] constexpr iterator insert_new(std::size_t h, auto *chain_idx, Args &&...args)
 		{
-			const auto pos = *chain_idx = size();
-			value_vector().emplace_back(std::forward<Args>(args)...).hash = h;
+			/* Chain index needs to be written before the dense array can be re-allocated, since it may point
+			 * into an existing entry. */
+			auto pos = fill_hole(h, std::forward<Args>(args)...);
+			if (pos != static_cast<size_type>(npos)) [[unlikely]]
+				*chain_idx = static_cast<index_type>(pos);
+			else
+			{
+				pos = value_vector().size();
+				SEK_ASSERT(pos < max_index, "Table size exceeds the range of chain indices");
+				*chain_idx = static_cast<index_type>(pos);
+				value_vector().emplace_back(std::forward<Args>(args)...).set_hash(h);
+			}
 			maybe_rehash();
 
-			return begin() + static_cast<difference_type>(pos);
+			return to_iterator(pos);
 		}
 		template<typename T>
 		[[nodiscard]] constexpr std::pair<iterator, bool> insert_impl(const auto &key, T &&value)
@@ -590,7 +916,7 @@ namespace sek::detail
 			const auto h = key_hash(key);
 			auto *chain_idx = get_chain(h);
 			while (*chain_idx != npos)
-				if (auto &candidate = value_vector()[*chain_idx]; candidate.hash == h && key_comp(key, candidate.key()))
+				if (auto &candidate = value_vector()[*chain_idx]; candidate.hash_eq(h) && key_comp(key, candidate.key()))
 				{
 					/* Found a candidate for replacing, replace the value & hash. */
 					if constexpr (requires { candidate.value = std::forward<T>(value); })
@@ -600,8 +926,8 @@ namespace sek::detail
 						std::destroy_at(&candidate.value);
 						std::construct_at(&candidate.value, std::forward<T>(value));
 					}
-					candidate.hash = h;
-					return {begin() + static_cast<difference_type>(*chain_idx), false};
+					candidate.set_hash(h);
+					return {to_iterator(*chain_idx), false};
 				}
 				else
 					chain_idx = &candidate.bucket_next;
@@ -616,8 +942,8 @@ namespace sek::detail
 			const auto h = key_hash(key);
 			auto *chain_idx = get_chain(h);
 			while (*chain_idx != npos)
-				if (auto &existing = value_vector()[*chain_idx]; existing.hash == h && key_comp(key, existing.key()))
-					return {begin() + static_cast<difference_type>(*chain_idx), false};
+				if (auto &existing = value_vector()[*chain_idx]; existing.hash_eq(h) && key_comp(key, existing.key()))
+					return {to_iterator(*chain_idx), false};
 				else
 					chain_idx = &existing.bucket_next;
 
@@ -625,29 +951,229 @@ namespace sek::detail
 			return {insert_new(h, chain_idx, std::forward<Args>(args)...), true};
 		}
 
+		template<bool Unique, typename Iter>
+		constexpr size_type bulk_insert(Iter first, Iter last)
+		{
+			const auto count = static_cast<size_type>(std::distance(first, last));
+
+			/* Reserve storage for values & buckets once for the whole sequence. */
+			value_vector().reserve(value_vector().size() + count);
+			if (const auto min_buckets = static_cast<size_type>(static_cast<float>(size() + count) / max_load_factor);
+				min_buckets > bucket_count() || rehash_pending())
+				rehash(std::max(min_buckets, bucket_count()));
+
+			/* Rehash might have removed holes, thus the size is only known at this point. */
+			const auto old_size = value_vector().size();
+			const auto new_size = old_size + count;
+
+			/* Construct all entries & hash their keys in a separate pass, so that hashing is not interleaved with
+			 * construction & chain traversal. */
+			try
+			{
+				for (; first != last; ++first) value_vector().emplace_back(*first);
+				if constexpr (table_traits::cache_hash)
+					for (auto i = old_size; i < new_size; ++i)
+					{
+						auto &entry = value_vector()[i];
+						entry.set_hash(key_hash(entry.key()));
+					}
+			}
+			catch (...)
+			{
+				const auto tail = value_vector().begin() + static_cast<difference_type>(old_size);
+				value_vector().erase(tail, value_vector().end());
+				throw;
+			}
+
+			/* Link the entries in a single sweep. If the keys are known to be unique, no lookup is required. */
+			if constexpr (Unique)
+			{
+				for (auto i = old_size; i < new_size; ++i)
+				{
+					auto &entry = value_vector()[i];
+					auto *chain_idx = get_chain(entry_hash(entry));
+					entry.bucket_next = *chain_idx;
+					*chain_idx = static_cast<index_type>(i);
+				}
+				return new_size - old_size;
+			}
+			else
+			{
+				/* Entries with duplicate keys replace the existing values & are compacted away. */
+				auto pos = old_size;
+				for (auto i = old_size; i < new_size; ++i)
+				{
+					auto &entry = value_vector()[i];
+					const auto h = entry_hash(entry);
+					auto *chain_idx = get_chain(h);
+					while (*chain_idx != npos)
+						if (auto &candidate = value_vector()[*chain_idx];
+							candidate.hash_eq(h) && key_comp(entry.key(), candidate.key()))
+							break;
+						else
+							chain_idx = &candidate.bucket_next;
+
+					if (*chain_idx != npos)
+						value_vector()[*chain_idx].value = std::move(entry.value);
+					else
+					{
+						if (i != pos) value_vector()[pos] = std::move(entry);
+						value_vector()[pos].bucket_next = npos;
+						*chain_idx = static_cast<index_type>(pos++);
+					}
+				}
+				value_vector().erase(value_vector().begin() + static_cast<difference_type>(pos), value_vector().end());
+				return pos - old_size;
+			}
+		}
+
 		constexpr void maybe_rehash()
 		{
-			if (load_factor() > max_load_factor) [[unlikely]]
-				rehash(bucket_count() * 2);
+			if (rehash_pending()) [[unlikely]]
+				rehash_step();
+			else if (is_small())
+			{
+				/* The bucket array is only built once the table outgrows the small chain. */
+				if (size() > small_size) [[unlikely]]
+					rehash_impl(adjust_bucket_count(0));
+			}
+			else if (load_factor() > max_load_factor) [[unlikely]]
+			{
+				if (!incremental_rehash) /* Holes are not removed here, since positions must remain stable. */
+					rehash_impl(adjust_bucket_count(bucket_count() * 2));
+				else
+				{
+					/* Storage for the new bucket array is allocated up-front, but is filled in steps. */
+					m_rehash_target = bucket_policy::round_count(bucket_count() * 2);
+					m_rehash_buckets.reserve(m_rehash_target);
+				}
+			}
+		}
+		constexpr void rehash_step()
+		{
+			if (m_rehash_target != 0)
+			{
+				const auto n = std::min(m_rehash_target - m_rehash_buckets.size(), rehash_fill_step);
+				m_rehash_buckets.insert(m_rehash_buckets.end(), n, npos);
+
+				/* Once the new bucket array is filled, it becomes the main bucket array & migration can start. */
+				if (m_rehash_buckets.size() == m_rehash_target)
+				{
+					bucket_vector().swap(m_rehash_buckets);
+					m_rehash_target = 0;
+					m_rehash_pos = 0;
+				}
+				return;
+			}
+
+			/* Move a fixed amount of old chains to the new bucket array. */
+			const auto old_count = m_rehash_buckets.size();
+			const auto last = std::min(m_rehash_pos + rehash_chain_step, old_count);
+			for (; m_rehash_pos < last; ++m_rehash_pos)
+				for (auto idx = std::exchange(m_rehash_buckets[m_rehash_pos], npos); idx != npos;)
+				{
+					auto &entry = value_vector()[idx];
+					auto *chain_idx = bucket_vector().data() + bucket_policy::index(entry_hash(entry), bucket_count());
+					const auto next = entry.bucket_next;
+					entry.bucket_next = *chain_idx;
+					*chain_idx = idx;
+					idx = next;
+				}
+			if (m_rehash_pos == old_count) cancel_rehash();
+		}
+		constexpr void cancel_rehash()
+		{
+			/* Release the old (or partially filled) bucket array. */
+			sparse_data{m_rehash_buckets.get_allocator()}.swap(m_rehash_buckets);
+			m_rehash_target = 0;
+			m_rehash_pos = 0;
+		}
+		[[nodiscard]] constexpr size_type adjust_bucket_count(size_type n) const noexcept
+		{
+			using std::max;
+
+			/* Small tables stay small unless either the size or the requested capacity exceed the small size. */
+			if (is_small() && size() <= small_size && static_cast<float>(n) * max_load_factor <= small_size)
+				return 0;
+
+			/* Adjust the capacity to be at least large enough to fit the current size. */
+			n = max(max(static_cast<size_type>(static_cast<float>(size()) / max_load_factor), n), initial_capacity);
+			return bucket_policy::round_count(n);
+		}
+		[[nodiscard]] constexpr static size_type small_bucket_count(size_type n) noexcept
+		{
+			return n > small_size ? bucket_policy::round_count(n) : 0;
+		}
+		constexpr void remove_holes()
+		{
+			if constexpr (table_traits::tombstones)
+				if (m_holes != 0)
+				{
+					const auto pred = [](const entry_type &e) { return e.is_hole(); };
+					const auto tail = std::remove_if(value_vector().begin(), value_vector().end(), pred);
+					value_vector().erase(tail, value_vector().end());
+					m_holes = 0;
+					m_free_head = 0;
+				}
 		}
 		constexpr void rehash_impl(size_type new_cap)
 		{
-			/* Clear & reserve the vector filled with npos. */
+			cancel_rehash();
+
+			/* Clear & reserve the vector filled with npos. Zero capacity switches the table to the small chain. */
 			bucket_vector().clear();
 			bucket_vector().resize(new_cap, npos);
+			m_small_chain = npos;
 
 			/* Go through each entry & re-insert it. */
 			for (size_type i = 0; i < value_vector().size(); ++i)
 			{
 				auto &entry = value_vector()[i];
-				auto *chain_idx = get_chain(entry.hash);
+				if constexpr (table_traits::tombstones)
+					if (entry.is_hole()) [[unlikely]]
+						continue;
+				auto *chain_idx = get_chain(entry_hash(entry));
 
 				/* Will also handle cases where chain_idx is npos (empty chain). */
 				entry.bucket_next = *chain_idx;
-				*chain_idx = i;
+				*chain_idx = static_cast<index_type>(i);
 			}
 		}
 
+		template<typename... Args>
+		[[nodiscard]] constexpr size_type fill_hole(std::size_t h, Args &&...args)
+		{
+			if constexpr (table_traits::tombstones && std::is_nothrow_move_constructible_v<Value>)
+				if (m_free_head != 0)
+				{
+					/* Construct the value first, so that the free list stays intact if construction throws. */
+					Value value(std::forward<Args>(args)...);
+
+					const auto pos = m_free_head - 1;
+					auto &entry = value_vector()[pos];
+					m_free_head = static_cast<size_type>(entry.bucket_next & ~entry_type::hole_bit);
+					--m_holes;
+
+					std::destroy_at(&entry.value);
+					std::construct_at(&entry.value, std::move(value));
+					entry.bucket_next = npos;
+					entry.set_hash(h);
+					return pos;
+				}
+			return static_cast<size_type>(npos);
+		}
+
+		[[nodiscard]] constexpr iterator to_iterator(size_type idx) noexcept
+		{
+			auto *data = value_vector().data();
+			return iterator{data + idx, data + value_vector().size()};
+		}
+		[[nodiscard]] constexpr const_iterator to_iterator(size_type idx) const noexcept
+		{
+			auto *data = value_vector().data();
+			return const_iterator{data + idx, data + value_vector().size()};
+		}
+
 		constexpr auto erase_impl(std::size_t h, const auto &key)
 		{
 			/* Remove the entry from its chain. */
@@ -657,25 +1183,39 @@ namespace sek::detail
 				auto entry_ptr = value_vector().data() + static_cast<difference_type>(pos);
 
 				/* Un-link the entry from the chain & swap with the last entry. */
-				if (entry_ptr->hash == h && key_comp(key, entry_ptr->key()))
+				if (entry_ptr->hash_eq(h) && key_comp(key, entry_ptr->key()))
 				{
 					*chain_idx = entry_ptr->bucket_next;
-					if (const auto end_pos = size() - 1; pos != end_pos)
+					if constexpr (table_traits::tombstones)
+					{
+						/* Release the value & push the entry onto the free list. Other entries are never moved. */
+						[[maybe_unused]] const auto released = std::move(entry_ptr->value);
+						entry_ptr->bucket_next = static_cast<index_type>(entry_type::hole_bit | m_free_head);
+						m_free_head = static_cast<size_type>(pos) + 1;
+						++m_holes;
+
+						if (rehash_pending()) [[unlikely]]
+							rehash_step();
+						return to_iterator(static_cast<size_type>(pos) + 1);
+					}
+					else if (const auto end_pos = value_vector().size() - 1; pos != end_pos)
 					{
 						*entry_ptr = std::move(value_vector().back());
 
 						/* Find the chain offset pointing to the old position & replace it with the new position. */
-						for (chain_idx = get_chain(entry_ptr->hash); *chain_idx != npos;
+						for (chain_idx = get_chain(entry_hash(*entry_ptr)); *chain_idx != npos;
 							 chain_idx = &value_vector()[*chain_idx].bucket_next)
 							if (*chain_idx == end_pos)
 							{
-								*chain_idx = pos;
+								*chain_idx = static_cast<index_type>(pos);
 								break;
 							}
 					}
 
 					value_vector().pop_back();
-					return begin() + static_cast<difference_type>(pos);
+					if (rehash_pending()) [[unlikely]]
+						rehash_step();
+					return to_iterator(pos);
 				}
 				chain_idx = &entry_ptr->bucket_next;
 			}
@@ -683,9 +1223,22 @@ namespace sek::detail
 		}
 
 		packed_pair<dense_data, Cmp> m_dense;
-		packed_pair<sparse_data, Hash> m_sparse = {sparse_data(initial_capacity, npos), Hash{}};
+		packed_pair<sparse_data, Hash> m_sparse = {sparse_data{}, Hash{}};
+		/* Head of the only chain of a small table. */
+		index_type m_small_chain = npos;
+
+		/* Bucket array taking part in an incremental rehash. While `m_rehash_target` is non-zero, this is the
+		 * new bucket array being filled, otherwise it is the old bucket array being migrated. */
+		sparse_data m_rehash_buckets;
+		size_type m_rehash_pos = 0;
+		size_type m_rehash_target = 0;
+
+		/* Amount of holes left by tombstone erasure & 1-based index of the first hole in the free list. */
+		size_type m_holes = 0;
+		size_type m_free_head = 0;
 
 	public:
 		float max_load_factor = initial_load_factor;
+		bool incremental_rehash = false;
 	};
 }	 // namespace sek::detail
\ No newline at end of file
@@ -0,0 +1,648 @@
+/*
+ * Created by switchblade on 2026-10-16
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "../assert.hpp"
+#include "flat_table_group.hpp"
+#include "packed_pair.hpp"
+#include "table_util.hpp"
+
+namespace sek::detail
+{
+	template<typename Value, typename KeyGet>
+	struct flat_table_entry
+	{
+		constexpr flat_table_entry() = default;
+		constexpr flat_table_entry(const flat_table_entry &) = default;
+		constexpr flat_table_entry &operator=(const flat_table_entry &) = default;
+		constexpr flat_table_entry(flat_table_entry &&) noexcept(std::is_nothrow_move_constructible_v<Value>) = default;
+		constexpr flat_table_entry &operator=(flat_table_entry &&) noexcept(std::is_nothrow_move_assignable_v<Value>) = default;
+		constexpr ~flat_table_entry() = default;
+
+		// clang-format off
+		template<typename... Args>
+		constexpr explicit flat_table_entry(Args &&...args) requires std::constructible_from<Value, Args...>
+			: value(std::forward<Args>(args)...)
+		{
+		}
+		// clang-format on
+
+		[[nodiscard]] constexpr decltype(auto) key() const noexcept { return KeyGet{}(value); }
+
+		Value value;
+		std::size_t hash = {};
+	};
+
+	/* Flat hash tables are implemented via a dense array of values (same as dense hash tables), and an open-addressing
+	 * array of slots containing indices into the dense array. Every slot has a control byte, stored separately from
+	 * the slots, which contains 7 bits of the hash of the slot's entry, or marks the slot as empty or deleted.
+	 *
+	 * Control bytes are grouped in groups of 16, which are probed at once (using SSE2 if available), thus most
+	 * lookups check a single group of control bytes & compare a single key. The slot array capacity is always
+	 * a power of 2, thus the home group of a hash is selected via a bit mask instead of division.
+	 *
+	 * Groups are probed via a triangular sequence, which visits every group of a power-of-2 table.
+	 * Probe sequence of a key terminates at the first group containing an empty slot, thus an erased slot is
+	 * only marked empty if it's group already contains an empty slot, and is marked deleted otherwise.
+	 *
+	 * Same as dense tables, flat tables provide fast iteration but no iterator stability on erasure or insertion. */
+	template<typename Key, typename Value, typename Traits, typename Hash, typename Cmp, typename KeyGet, typename Alloc>
+	class flat_hash_table
+	{
+	public:
+		typedef Cmp key_equal;
+		typedef Hash hash_type;
+		typedef std::size_t size_type;
+		typedef std::ptrdiff_t difference_type;
+
+	private:
+		using entry_type = flat_table_entry<Value, KeyGet>;
+		using group_type = flat_table_group;
+		using probe_seq = flat_table_probe_seq;
+
+		constexpr static float initial_load_factor = .875f;
+		constexpr static size_type initial_capacity = group_type::size;
+		constexpr static size_type npos = std::numeric_limits<size_type>::max();
+
+		[[nodiscard]] constexpr static decltype(auto) get_key(const auto &v) { return KeyGet{}(v); }
+
+		using ctrl_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<std::int8_t>;
+		using ctrl_data = std::vector<std::int8_t, ctrl_alloc>;
+		using sparse_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<size_type>;
+		using sparse_data = std::vector<size_type, sparse_alloc>;
+		using dense_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<entry_type>;
+		using dense_data = std::vector<entry_type, dense_alloc>;
+
+		template<bool IsConst>
+		class flat_table_iterator
+		{
+			template<bool>
+			friend class flat_table_iterator;
+			friend class flat_hash_table;
+
+			using iter_t = std::conditional_t<IsConst, typename dense_data::const_iterator, typename dense_data::iterator>;
+			using ptr_t = std::conditional_t<IsConst, const entry_type, entry_type> *;
+
+		public:
+			typedef typename Traits::value_type value_type;
+			typedef std::conditional_t<IsConst, typename Traits::const_pointer, typename Traits::pointer> pointer;
+			typedef std::conditional_t<IsConst, typename Traits::const_reference, typename Traits::reference> reference;
+			typedef std::size_t size_type;
+			typedef std::ptrdiff_t difference_type;
+			typedef std::random_access_iterator_tag iterator_category;
+
+		private:
+			constexpr explicit flat_table_iterator(iter_t iter) noexcept : m_ptr(std::to_address(iter)) {}
+			constexpr explicit flat_table_iterator(ptr_t ptr) noexcept : m_ptr(ptr) {}
+
+		public:
+			constexpr flat_table_iterator() noexcept = default;
+			template<bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+			constexpr flat_table_iterator(const flat_table_iterator<OtherConst> &other) noexcept
+				: flat_table_iterator(other.m_ptr)
+			{
+			}
+
+			constexpr flat_table_iterator operator++(int) noexcept
+			{
+				auto temp = *this;
+				++(*this);
+				return temp;
+			}
+			constexpr flat_table_iterator &operator++() noexcept
+			{
+				++m_ptr;
+				return *this;
+			}
+			constexpr flat_table_iterator &operator+=(difference_type n) noexcept
+			{
+				m_ptr += n;
+				return *this;
+			}
+			constexpr flat_table_iterator operator--(int) noexcept
+			{
+				auto temp = *this;
+				--(*this);
+				return temp;
+			}
+			constexpr flat_table_iterator &operator--() noexcept
+			{
+				--m_ptr;
+				return *this;
+			}
+			constexpr flat_table_iterator &operator-=(difference_type n) noexcept
+			{
+				m_ptr -= n;
+				return *this;
+			}
+
+			[[nodiscard]] constexpr flat_table_iterator operator+(difference_type n) const noexcept
+			{
+				return flat_table_iterator{m_ptr + n};
+			}
+			[[nodiscard]] constexpr flat_table_iterator operator-(difference_type n) const noexcept
+			{
+				return flat_table_iterator{m_ptr - n};
+			}
+			[[nodiscard]] constexpr difference_type operator-(const flat_table_iterator &other) const noexcept
+			{
+				return m_ptr - other.m_ptr;
+			}
+
+			/** Returns pointer to the target element. */
+			[[nodiscard]] constexpr pointer get() const noexcept { return pointer{std::addressof(m_ptr->value)}; }
+			/** @copydoc value */
+			[[nodiscard]] constexpr pointer operator->() const noexcept { return get(); }
+
+			/** Returns reference to the element at an offset. */
+			[[nodiscard]] constexpr reference operator[](difference_type n) const noexcept { return m_ptr[n].value; }
+			/** Returns reference to the target element. */
+			[[nodiscard]] constexpr reference operator*() const noexcept { return *get(); }
+
+			[[nodiscard]] constexpr auto operator<=>(const flat_table_iterator &) const noexcept = default;
+			[[nodiscard]] constexpr bool operator==(const flat_table_iterator &) const noexcept = default;
+
+			constexpr void swap(flat_table_iterator &other) noexcept { std::swap(m_ptr, other.m_ptr); }
+			friend constexpr void swap(flat_table_iterator &a, flat_table_iterator &b) noexcept { a.swap(b); }
+
+		private:
+			ptr_t m_ptr = {};
+		};
+
+	public:
+		typedef flat_table_iterator<false> iterator;
+		typedef flat_table_iterator<true> const_iterator;
+		typedef std::reverse_iterator<iterator> reverse_iterator;
+		typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+		/* Every slot contains at most 1 entry, thus buckets are iterated via the dense array. */
+		typedef iterator local_iterator;
+		typedef const_iterator const_local_iterator;
+
+	public:
+		constexpr flat_hash_table() = default;
+		constexpr flat_hash_table(const flat_hash_table &) = default;
+		constexpr flat_hash_table &operator=(const flat_hash_table &) = default;
+		constexpr flat_hash_table(flat_hash_table &&) = default;
+		constexpr flat_hash_table &operator=(flat_hash_table &&) = default;
+		constexpr ~flat_hash_table() = default;
+
+		constexpr flat_hash_table(const Cmp &equal, const Hash &hash, const Alloc &alloc)
+			: flat_hash_table{initial_capacity, equal, hash, alloc}
+		{
+		}
+		constexpr flat_hash_table(size_type bucket_count, const Cmp &equal, const Hash &hash, const Alloc &alloc)
+			: m_dense{dense_alloc{alloc}, equal},
+			  m_sparse{std::piecewise_construct,
+					   std::forward_as_tuple(round_capacity(bucket_count), sparse_alloc{alloc}),
+					   std::forward_as_tuple(hash)},
+			  m_ctrl(round_capacity(bucket_count), group_type::empty, ctrl_alloc{alloc})
+		{
+		}
+		constexpr flat_hash_table(const flat_hash_table &other, const Alloc &alloc)
+			: m_dense{std::piecewise_construct,
+					  std::forward_as_tuple(other.value_vector(), dense_alloc{alloc}),
+					  std::forward_as_tuple(other.m_dense.second())},
+			  m_sparse{std::piecewise_construct,
+					   std::forward_as_tuple(other.slot_vector(), sparse_alloc{alloc}),
+					   std::forward_as_tuple(other.m_sparse.second())},
+			  m_ctrl(other.m_ctrl, ctrl_alloc{alloc}),
+			  m_deleted{other.m_deleted},
+			  max_load_factor{other.max_load_factor}
+		{
+		}
+		constexpr flat_hash_table(flat_hash_table &&other, const Alloc &alloc)
+			: m_dense{std::piecewise_construct,
+					  std::forward_as_tuple(std::move(other.value_vector()), dense_alloc{alloc}),
+					  std::forward_as_tuple(std::move(other.m_dense.second()))},
+			  m_sparse{std::piecewise_construct,
+					   std::forward_as_tuple(std::move(other.slot_vector()), sparse_alloc{alloc}),
+					   std::forward_as_tuple(std::move(other.m_sparse.second()))},
+			  m_ctrl(std::move(other.m_ctrl), ctrl_alloc{alloc}),
+			  m_deleted{other.m_deleted},
+			  max_load_factor{other.max_load_factor}
+		{
+		}
+
+		[[nodiscard]] constexpr auto begin() noexcept { return iterator{value_vector().begin()}; }
+		[[nodiscard]] constexpr auto cbegin() const noexcept { return const_iterator{value_vector().begin()}; }
+		[[nodiscard]] constexpr auto begin() const noexcept { return cbegin(); }
+		[[nodiscard]] constexpr auto end() noexcept { return iterator{value_vector().end()}; }
+		[[nodiscard]] constexpr auto cend() const noexcept { return const_iterator{value_vector().end()}; }
+		[[nodiscard]] constexpr auto end() const noexcept { return cend(); }
+		[[nodiscard]] constexpr auto rbegin() noexcept { return reverse_iterator{end()}; }
+		[[nodiscard]] constexpr auto crbegin() const noexcept { return const_reverse_iterator{cend()}; }
+		[[nodiscard]] constexpr auto rbegin() const noexcept { return crbegin(); }
+		[[nodiscard]] constexpr auto rend() noexcept { return reverse_iterator{begin()}; }
+		[[nodiscard]] constexpr auto crend() const noexcept { return const_reverse_iterator{cbegin()}; }
+		[[nodiscard]] constexpr auto rend() const noexcept { return crend(); }
+
+		[[nodiscard]] constexpr size_type size() const noexcept { return value_vector().size(); }
+		[[nodiscard]] constexpr size_type capacity() const noexcept
+		{
+			/* Capacity needs to take into account the max load factor. */
+			return static_cast<size_type>(static_cast<float>(bucket_count()) * max_load_factor);
+		}
+		[[nodiscard]] constexpr size_type max_size() const noexcept
+		{
+			const auto max_idx = std::min(value_vector().max_size(), npos - 1);
+			return static_cast<size_type>(static_cast<float>(max_idx) * max_load_factor);
+		}
+		[[nodiscard]] constexpr float load_factor() const noexcept
+		{
+			return static_cast<float>(size()) / static_cast<float>(bucket_count());
+		}
+
+		[[nodiscard]] constexpr size_type bucket_count() const noexcept { return m_ctrl.size(); }
+		[[nodiscard]] constexpr size_type max_bucket_count() const noexcept
+		{
+			return std::bit_floor(std::min(m_ctrl.max_size(), slot_vector().max_size()));
+		}
+
+		[[nodiscard]] constexpr auto begin(size_type bucket) noexcept
+		{
+			return m_ctrl[bucket] >= 0 ? begin() + static_cast<difference_type>(slot_vector()[bucket]) : end();
+		}
+		[[nodiscard]] constexpr auto cbegin(size_type bucket) const noexcept
+		{
+			return m_ctrl[bucket] >= 0 ? cbegin() + static_cast<difference_type>(slot_vector()[bucket]) : cend();
+		}
+		[[nodiscard]] constexpr auto begin(size_type bucket) const noexcept { return cbegin(bucket); }
+		[[nodiscard]] constexpr auto end(size_type bucket) noexcept
+		{
+			return m_ctrl[bucket] >= 0 ? begin(bucket) + 1 : end();
+		}
+		[[nodiscard]] constexpr auto cend(size_type bucket) const noexcept
+		{
+			return m_ctrl[bucket] >= 0 ? cbegin(bucket) + 1 : cend();
+		}
+		[[nodiscard]] constexpr auto end(size_type bucket) const noexcept { return cend(bucket); }
+
+		[[nodiscard]] constexpr size_type bucket_size(size_type bucket) const noexcept { return m_ctrl[bucket] >= 0; }
+		[[nodiscard]] constexpr size_type bucket(const auto &key) const noexcept
+		{
+			const auto h = key_hash(key);
+			if (const auto slot = find_slot(h, key); slot != npos) return slot;
+			return probe_seq{mix_hash(h) >> 7, group_mask()}.offset();
+		}
+		[[nodiscard]] constexpr size_type bucket(const_iterator iter) const noexcept
+		{
+			return find_position(iter.m_ptr->hash, static_cast<size_type>(iter.m_ptr - value_vector().data()));
+		}
+
+		[[nodiscard]] constexpr auto find(const auto &key) noexcept
+		{
+			return begin() + static_cast<difference_type>(find_impl(key_hash(key), key));
+		}
+		[[nodiscard]] constexpr auto find(const auto &key) const noexcept
+		{
+			return begin() + static_cast<difference_type>(find_impl(key_hash(key), key));
+		}
+
+		constexpr void clear()
+		{
+			std::fill(m_ctrl.begin(), m_ctrl.end(), group_type::empty);
+			value_vector().clear();
+			m_deleted = 0;
+		}
+
+		constexpr void rehash(size_type new_cap)
+		{
+			using std::max;
+
+			/* Adjust the capacity to be at least large enough to fit the current size. */
+			new_cap = max(static_cast<size_type>(static_cast<float>(size()) / max_load_factor) + 1, new_cap);
+
+			/* Don't do anything if the capacity did not change after the adjustment. */
+			if (new_cap = round_capacity(new_cap); new_cap != bucket_count()) [[likely]]
+				rehash_impl(new_cap);
+		}
+		constexpr void reserve(size_type n)
+		{
+			value_vector().reserve(n);
+			rehash(static_cast<size_type>(static_cast<float>(n) / max_load_factor) + 1);
+		}
+
+		template<typename... Args>
+		constexpr std::pair<iterator, bool> emplace(Args &&...args)
+		{
+			/* Temporary entry needs to be created at first. */
+			auto &entry = value_vector().emplace_back(std::forward<Args>(args)...);
+			const auto h = entry.hash = key_hash(entry.key());
+			if (const auto slot = find_slot(h, entry.key()); slot != npos)
+			{
+				/* Found a candidate for replacing. */
+				const auto pos = slot_vector()[slot];
+				value_vector()[pos].value = std::move(entry.value);
+				value_vector().pop_back(); /* Pop the temporary. */
+				return {begin() + static_cast<difference_type>(pos), false};
+			}
+
+			/* No suitable entry for replacing was found, add new slot. */
+			const auto pos = size() - 1;
+			insert_slot(h, pos);
+			return {begin() + static_cast<difference_type>(pos), true};
+		}
+		template<typename... Args>
+		constexpr std::pair<iterator, bool> try_emplace(const auto &key, Args &&...args)
+		{
+			// clang-format off
+			return try_insert_impl(key, std::piecewise_construct,
+								   std::forward_as_tuple(key),
+								   std::forward_as_tuple(std::forward<Args>(args)...));
+			// clang-format on
+		}
+		template<typename... Args>
+		constexpr std::pair<iterator, bool> try_emplace(Key &&key, Args &&...args)
+		{
+			// clang-format off
+			return try_insert_impl(key, std::piecewise_construct,
+								   std::forward_as_tuple(std::forward<Key>(key)),
+								   std::forward_as_tuple(std::forward<Args>(args)...));
+			// clang-format on
+		}
+
+		template<std::forward_iterator Iter>
+		constexpr size_type insert(Iter first, Iter last)
+		{
+			size_type inserted = 0;
+			while (first != last) inserted += emplace(*first++).second;
+			return inserted;
+		}
+		constexpr size_type insert(iterator first, iterator last)
+		{
+			size_type inserted = 0;
+			while (first != last) inserted += insert(*first++).second;
+			return inserted;
+		}
+		constexpr size_type insert(const_iterator first, const_iterator last)
+		{
+			size_type inserted = 0;
+			while (first != last) inserted += insert(*first++).second;
+			return inserted;
+		}
+
+		constexpr std::pair<iterator, bool> insert(const Value &value) { return insert_impl(get_key(value), value); }
+		constexpr std::pair<iterator, bool> insert(Value &&value)
+		{
+			return insert_impl(get_key(value), std::forward<Value>(value));
+		}
+
+		template<std::forward_iterator Iter>
+		constexpr size_type try_insert(Iter first, Iter last)
+		{
+			size_type inserted = 0;
+			while (first != last) inserted += try_insert(*first++).second;
+			return inserted;
+		}
+
+		constexpr std::pair<iterator, bool> try_insert(const Value &value)
+		{
+			return try_insert_impl(get_key(value), value);
+		}
+		constexpr std::pair<iterator, bool> try_insert(Value &&value)
+		{
+			return try_insert_impl(get_key(value), std::forward<Value>(value));
+		}
+
+		constexpr auto erase(const_iterator first, const_iterator last)
+		{
+			/* Iterate backwards here, since iterators after the erased one can be invalidated. */
+			auto result = end();
+			while (first < last) result = erase(--last);
+			return result;
+		}
+		constexpr auto erase(const_iterator where)
+		{
+			const auto pos = static_cast<size_type>(where.m_ptr - value_vector().data());
+			return erase_impl(find_position(where.m_ptr->hash, pos));
+		}
+
+		// clang-format off
+		template<typename T>
+		constexpr auto erase(const T &key) requires(!std::same_as<std::decay_t<const_iterator>, T> &&
+		                                            !std::same_as<std::decay_t<iterator>, T>)
+		{
+			if (const auto slot = find_slot(key_hash(key), key); slot != npos) [[likely]]
+				return erase_impl(slot);
+			return end();
+		}
+		// clang-format on
+
+		[[nodiscard]] constexpr auto allocator() const noexcept { return value_vector().get_allocator(); }
+		[[nodiscard]] constexpr auto &get_hash() const noexcept { return m_sparse.second(); }
+		[[nodiscard]] constexpr auto &get_comp() const noexcept { return m_dense.second(); }
+
+		constexpr void swap(flat_hash_table &other) noexcept
+		{
+			using std::swap;
+			swap(m_sparse, other.m_sparse);
+			swap(m_dense, other.m_dense);
+			swap(m_ctrl, other.m_ctrl);
+			swap(m_deleted, other.m_deleted);
+			swap(max_load_factor, other.max_load_factor);
+		}
+
+	private:
+		/* Rounds bucket count to a power of 2 multiple of group size. */
+		[[nodiscard]] constexpr static size_type round_capacity(size_type n) noexcept
+		{
+			return std::bit_ceil(std::max(n, initial_capacity));
+		}
+		/* Mixes the hash, so that weak hashes (ex. identity hashes of integers) are spread across groups. */
+		[[nodiscard]] constexpr static std::size_t mix_hash(std::size_t h) noexcept
+		{
+			return pow2_bucket_policy::mix(h);
+		}
+		[[nodiscard]] constexpr static std::int8_t ctrl_hash(std::size_t m) noexcept
+		{
+			return static_cast<std::int8_t>(m & 0x7f);
+		}
+
+		[[nodiscard]] constexpr dense_data &value_vector() noexcept { return m_dense.first(); }
+		[[nodiscard]] constexpr const dense_data &value_vector() const noexcept { return m_dense.first(); }
+		[[nodiscard]] constexpr sparse_data &slot_vector() noexcept { return m_sparse.first(); }
+		[[nodiscard]] constexpr const sparse_data &slot_vector() const noexcept { return m_sparse.first(); }
+
+		[[nodiscard]] constexpr auto key_hash(const auto &k) const { return m_sparse.second()(k); }
+		[[nodiscard]] constexpr auto key_comp(const auto &a, const auto &b) const { return m_dense.second()(a, b); }
+
+		[[nodiscard]] constexpr size_type group_mask() const noexcept
+		{
+			return bucket_count() / group_type::size - 1;
+		}
+
+		/* Returns slot containing the entry with the specified key, or `npos` if no such entry exists. */
+		[[nodiscard]] constexpr size_type find_slot(std::size_t h, const auto &key) const noexcept
+		{
+			if (bucket_count() == 0) [[unlikely]]
+				return npos;
+
+			const auto m = mix_hash(h);
+			for (probe_seq seq{m >> 7, group_mask()};; seq.next())
+			{
+				const group_type group{m_ctrl.data() + seq.offset()};
+				for (auto bits = group.match(ctrl_hash(m)); bits != 0; bits &= bits - 1)
+				{
+					const auto slot = seq.offset(static_cast<std::uint32_t>(std::countr_zero(bits)));
+					const auto &entry = value_vector()[slot_vector()[slot]];
+					if (entry.hash == h && key_comp(key, entry.key())) [[likely]]
+						return slot;
+				}
+				if (group.match_empty() != 0) [[likely]]
+					return npos;
+			}
+		}
+		/* Returns slot pointing to the specified position within the dense array. */
+		[[nodiscard]] constexpr size_type find_position(std::size_t h, size_type pos) const noexcept
+		{
+			const auto m = mix_hash(h);
+			for (probe_seq seq{m >> 7, group_mask()};; seq.next())
+			{
+				const group_type group{m_ctrl.data() + seq.offset()};
+				for (auto bits = group.match(ctrl_hash(m)); bits != 0; bits &= bits - 1)
+					if (const auto slot = seq.offset(static_cast<std::uint32_t>(std::countr_zero(bits)));
+						slot_vector()[slot] == pos)
+						return slot;
+				SEK_ASSERT(group.match_empty() == 0, "Dense array position must be present within the table");
+			}
+		}
+		/* Returns first empty or deleted slot in the probe sequence of the hash. */
+		[[nodiscard]] constexpr size_type find_available(std::size_t m) const noexcept
+		{
+			for (probe_seq seq{m >> 7, group_mask()};; seq.next())
+				if (const auto bits = group_type{m_ctrl.data() + seq.offset()}.match_available(); bits != 0)
+					return seq.offset(static_cast<std::uint32_t>(std::countr_zero(bits)));
+		}
+
+		[[nodiscard]] constexpr size_type find_impl(std::size_t h, const auto &key) const noexcept
+		{
+			if (const auto slot = find_slot(h, key); slot != npos) [[likely]]
+				return slot_vector()[slot];
+			return value_vector().size();
+		}
+
+		/* Assigns a slot to the entry at position `pos` of the dense array. */
+		constexpr void insert_slot(std::size_t h, size_type pos)
+		{
+			/* If there is no more space (including deleted slots), re-hash the table. Re-hash will also insert the new
+			 * entry, since it is already present within the dense array. If more than half of the occupied slots are
+			 * deleted, re-hash in-place to clear them out, otherwise grow. */
+			if (size() + m_deleted > capacity()) [[unlikely]]
+			{
+				const auto grow = bucket_count() == 0 || m_deleted <= size() / 2;
+				rehash_impl(grow ? round_capacity(bucket_count() * 2) : bucket_count());
+				return;
+			}
+
+			const auto m = mix_hash(h);
+			const auto slot = find_available(m);
+			m_deleted -= m_ctrl[slot] == group_type::deleted;
+			m_ctrl[slot] = ctrl_hash(m);
+			slot_vector()[slot] = pos;
+		}
+		template<typename... Args>
+		[[nodiscard]] constexpr iterator insert_new(std::size_t h, Args &&...args)
+		{
+			const auto pos = size();
+			value_vector().emplace_back(std::forward<Args>(args)...).hash = h;
+			insert_slot(h, pos);
+			return begin() + static_cast<difference_type>(pos);
+		}
+		template<typename T>
+		[[nodiscard]] constexpr std::pair<iterator, bool> insert_impl(const auto &key, T &&value)
+		{
+			/* See if we can replace any entry. */
+			const auto h = key_hash(key);
+			if (const auto slot = find_slot(h, key); slot != npos)
+			{
+				/* Found a candidate for replacing, replace the value. */
+				const auto pos = slot_vector()[slot];
+				auto &candidate = value_vector()[pos];
+				if constexpr (requires { candidate.value = std::forward<T>(value); })
+					candidate.value = std::forward<T>(value);
+				else
+				{
+					std::destroy_at(&candidate.value);
+					std::construct_at(&candidate.value, std::forward<T>(value));
+				}
+				return {begin() + static_cast<difference_type>(pos), false};
+			}
+
+			/* No candidate for replacing found, create new entry. */
+			return {insert_new(h, std::forward<T>(value)), true};
+		}
+		template<typename... Args>
+		[[nodiscard]] constexpr std::pair<iterator, bool> try_insert_impl(const auto &key, Args &&...args)
+		{
+			/* See if an entry already exists. */
+			const auto h = key_hash(key);
+			if (const auto slot = find_slot(h, key); slot != npos)
+				return {begin() + static_cast<difference_type>(slot_vector()[slot]), false};
+
+			/* No existing entry found, create new entry. */
+			return {insert_new(h, std::forward<Args>(args)...), true};
+		}
+
+		constexpr void rehash_impl(size_type new_cap)
+		{
+			/* Allocate new arrays before modifying the table, so that the table is left intact on failure. */
+			ctrl_data new_ctrl(new_cap, group_type::empty, m_ctrl.get_allocator());
+			sparse_data new_slots(new_cap, slot_vector().get_allocator());
+			m_ctrl.swap(new_ctrl);
+			slot_vector().swap(new_slots);
+			m_deleted = 0;
+
+			/* Go through each entry & re-insert it. */
+			for (size_type i = 0; i < value_vector().size(); ++i)
+			{
+				const auto m = mix_hash(value_vector()[i].hash);
+				const auto slot = find_available(m);
+				m_ctrl[slot] = ctrl_hash(m);
+				slot_vector()[slot] = i;
+			}
+		}
+
+		constexpr auto erase_impl(size_type slot)
+		{
+			/* If the group already has an empty slot, no probe sequence could have continued past it,
+			 * thus the slot can be marked empty. Otherwise, mark it deleted. */
+			const auto group_offset = slot - slot % group_type::size;
+			if (group_type{m_ctrl.data() + group_offset}.match_empty() != 0)
+				m_ctrl[slot] = group_type::empty;
+			else
+			{
+				m_ctrl[slot] = group_type::deleted;
+				++m_deleted;
+			}
+
+			/* Swap the erased entry with the last entry & update the last entry's slot. */
+			const auto pos = slot_vector()[slot];
+			if (const auto end_pos = size() - 1; pos != end_pos)
+			{
+				auto &entry = value_vector()[pos];
+				entry = std::move(value_vector().back());
+				slot_vector()[find_position(entry.hash, end_pos)] = pos;
+			}
+
+			value_vector().pop_back();
+			return begin() + static_cast<difference_type>(pos);
+		}
+
+		packed_pair<dense_data, Cmp> m_dense;
+		packed_pair<sparse_data, Hash> m_sparse = {sparse_data(initial_capacity), Hash{}};
+		ctrl_data m_ctrl = ctrl_data(initial_capacity, group_type::empty);
+		size_type m_deleted = 0;
+
+	public:
+		float max_load_factor = initial_load_factor;
+	};
+}	 // namespace sek::detail
\ No newline at end of file
@@ -0,0 +1,94 @@
+/*
+ * Created by switchblade on 2026-10-16
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "arch.h"
+
+#if defined(SEK_ARCH_x86) && (defined(__SSE2__) || defined(SEK_ARCH_x86_64))
+#define SEK_FLAT_TABLE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace sek::detail
+{
+	/* Group of control bytes of a flat or sparse hash table, probed at once. Control byte of an occupied slot contains
+	 * 7 bits of the slot's hash, empty & deleted slots are marked with negative values (sign bit set). */
+	class flat_table_group
+	{
+	public:
+		typedef std::uint32_t bitmask;
+
+		constexpr static std::size_t size = 16;
+
+		constexpr static std::int8_t empty = -128;
+		constexpr static std::int8_t deleted = -2;
+
+	public:
+		explicit flat_table_group(const std::int8_t *ctrl) noexcept
+#ifdef SEK_FLAT_TABLE_SSE2
+			: m_ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl)))
+		{
+		}
+#else
+		{
+			std::copy_n(ctrl, size, m_ctrl);
+		}
+#endif
+
+		/** Returns bitmask of slots with control byte equal to `h`. */
+		[[nodiscard]] bitmask match(std::int8_t h) const noexcept
+		{
+#ifdef SEK_FLAT_TABLE_SSE2
+			const auto cmp = _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(h)), m_ctrl);
+			return static_cast<bitmask>(_mm_movemask_epi8(cmp));
+#else
+			bitmask result = 0;
+			for (std::size_t i = 0; i < size; ++i) result |= static_cast<bitmask>(m_ctrl[i] == h) << i;
+			return result;
+#endif
+		}
+		/** Returns bitmask of empty slots. */
+		[[nodiscard]] bitmask match_empty() const noexcept { return match(empty); }
+		/** Returns bitmask of empty or deleted slots. */
+		[[nodiscard]] bitmask match_available() const noexcept
+		{
+#ifdef SEK_FLAT_TABLE_SSE2
+			return static_cast<bitmask>(_mm_movemask_epi8(m_ctrl));
+#else
+			bitmask result = 0;
+			for (std::size_t i = 0; i < size; ++i) result |= static_cast<bitmask>(m_ctrl[i] < 0) << i;
+			return result;
+#endif
+		}
+
+	private:
+#ifdef SEK_FLAT_TABLE_SSE2
+		__m128i m_ctrl;
+#else
+		std::int8_t m_ctrl[size];
+#endif
+	};
+
+	/* Triangular probe sequence over groups of control bytes. Visits every group of a power-of-2 table. */
+	class flat_table_probe_seq
+	{
+	public:
+		constexpr flat_table_probe_seq(std::size_t h, std::size_t mask) noexcept : m_mask(mask), m_pos(h & mask) {}
+
+		[[nodiscard]] constexpr std::size_t offset() const noexcept { return m_pos * flat_table_group::size; }
+		[[nodiscard]] constexpr std::size_t offset(std::uint32_t i) const noexcept { return offset() + i; }
+
+		constexpr void next() noexcept { m_pos = (m_pos + ++m_step) & m_mask; }
+
+	private:
+		std::size_t m_mask;
+		std::size_t m_pos;
+		std::size_t m_step = 0;
+	};
+}	 // namespace sek::detail
\ No newline at end of file
@@ -0,0 +1,368 @@
+/*
+ * Created by switchblade on 2026-10-16
+ */
+
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "packed_pair.hpp"
+
+namespace sek::detail
+{
+	/* Mapped tables are read-only hash tables stored within a flat relocatable image. The image consists of a header,
+	 * a bucket array, an entry array & a string pool. All references within the image are byte offsets, thus the
+	 * image can be used directly from a memory-mapped file without any deserialization. Layout of the image:
+	 *
+	 * [header][buckets: uint32 * bucket_count][entries: entry * size][pool: bytes * pool_size]
+	 *
+	 * Every entry contains the hash of its key, the index of the next entry within the bucket chain & the stored
+	 * representation of the key and mapped value. Trivially copyable types are stored as-is, while strings are
+	 * stored as offset & length pairs into the string pool. */
+
+	struct mapped_table_header
+	{
+		constexpr static std::uint32_t magic_value = 0x4d4b4553; /* "SEKM" */
+		constexpr static std::uint32_t version_value = 1;
+
+		std::uint32_t magic;
+		std::uint32_t version;
+		std::uint32_t entry_size;
+		std::uint32_t entry_align;
+		/* Tags of the key & mapped types, used to detect images of different types with the same entry layout. */
+		std::uint32_t key_tag;
+		std::uint32_t mapped_tag;
+
+		std::uint64_t size;
+		std::uint64_t bucket_count;
+		std::uint64_t buckets_off;
+		std::uint64_t entries_off;
+		std::uint64_t pool_off;
+		std::uint64_t pool_size;
+	};
+
+	[[nodiscard]] constexpr std::size_t mapped_align_up(std::size_t n, std::size_t align) noexcept
+	{
+		return (n + align - 1) & ~(align - 1);
+	}
+
+	template<typename T>
+	struct mapped_repr
+	{
+		static_assert(std::is_trivially_copyable_v<T> && !std::is_pointer_v<T>,
+					  "Mapped tables support only trivially copyable types & strings");
+
+		using stored_type = T;
+		using view_type = const T &;
+
+		constexpr static std::uint32_t type_tag = static_cast<std::uint32_t>(
+			sizeof(T) << 4 | std::is_floating_point_v<T> << 1 | std::is_signed_v<T> << 2 | std::is_class_v<T> << 3);
+
+		[[nodiscard]] constexpr static view_type view(const stored_type &value, const std::byte *) noexcept
+		{
+			return value;
+		}
+		[[nodiscard]] static stored_type store(const T &value, std::vector<std::byte> &) { return value; }
+	};
+
+	struct mapped_string
+	{
+		std::uint64_t offset;
+		std::uint64_t length;
+	};
+	template<typename C, typename Traits>
+	struct mapped_string_repr
+	{
+		using stored_type = mapped_string;
+		using view_type = std::basic_string_view<C, Traits>;
+
+		constexpr static std::uint32_t type_tag = static_cast<std::uint32_t>(sizeof(C) << 4 | 1);
+
+		[[nodiscard]] static view_type view(const stored_type &str, const std::byte *pool) noexcept
+		{
+			const auto *data = reinterpret_cast<const C *>(pool + str.offset);
+			return view_type{data, static_cast<std::size_t>(str.length)};
+		}
+		[[nodiscard]] static stored_type store(view_type str, std::vector<std::byte> &pool)
+		{
+			/* Strings within the pool are aligned to the character size. */
+			const auto offset = mapped_align_up(pool.size(), alignof(C));
+			pool.resize(offset + str.size() * sizeof(C));
+			if (!str.empty()) std::memcpy(pool.data() + offset, str.data(), str.size() * sizeof(C));
+			return {offset, str.size()};
+		}
+	};
+	template<typename C, typename Traits, typename A>
+	struct mapped_repr<std::basic_string<C, Traits, A>> : mapped_string_repr<C, Traits>
+	{
+	};
+	template<typename C, typename Traits>
+	struct mapped_repr<std::basic_string_view<C, Traits>> : mapped_string_repr<C, Traits>
+	{
+	};
+
+	template<typename K, typename M>
+	struct mapped_entry
+	{
+		std::uint64_t hash;
+		std::uint32_t next;
+		typename mapped_repr<K>::stored_type key;
+		typename mapped_repr<M>::stored_type mapped;
+	};
+	template<typename K>
+	struct mapped_entry<K, void>
+	{
+		std::uint64_t hash;
+		std::uint32_t next;
+		typename mapped_repr<K>::stored_type key;
+	};
+
+	template<typename K, typename M>
+	struct mapped_value
+	{
+		using type = std::pair<typename mapped_repr<K>::view_type, typename mapped_repr<M>::view_type>;
+	};
+	template<typename K>
+	struct mapped_value<K, void>
+	{
+		using type = typename mapped_repr<K>::view_type;
+	};
+
+	/* `M` is `void` for mapped sets. */
+	template<typename K, typename M, typename Hash, typename Cmp>
+	class mapped_dense_table
+	{
+		using entry_type = mapped_entry<K, M>;
+		using key_repr = mapped_repr<K>;
+
+		constexpr static std::uint32_t mapped_tag = [] {
+			if constexpr (std::is_void_v<M>)
+				return 0u;
+			else
+				return mapped_repr<M>::type_tag;
+		}();
+
+		constexpr static std::uint32_t npos = std::numeric_limits<std::uint32_t>::max();
+
+	public:
+		typedef typename key_repr::view_type key_view;
+		typedef typename mapped_value<K, M>::type value_type;
+		typedef std::size_t size_type;
+		typedef std::ptrdiff_t difference_type;
+
+		class iterator
+		{
+			friend class mapped_dense_table;
+
+			struct arrow_proxy
+			{
+				[[nodiscard]] constexpr const value_type *operator->() const noexcept { return &value; }
+
+				value_type value;
+			};
+
+		public:
+			typedef typename mapped_dense_table::value_type value_type;
+			typedef value_type reference;
+			typedef arrow_proxy pointer;
+			typedef std::ptrdiff_t difference_type;
+			typedef std::bidirectional_iterator_tag iterator_category;
+
+		private:
+			constexpr iterator(const entry_type *ptr, const std::byte *pool) noexcept : m_ptr(ptr), m_pool(pool) {}
+
+		public:
+			constexpr iterator() noexcept = default;
+
+			constexpr iterator operator++(int) noexcept
+			{
+				auto temp = *this;
+				++(*this);
+				return temp;
+			}
+			constexpr iterator &operator++() noexcept
+			{
+				++m_ptr;
+				return *this;
+			}
+			constexpr iterator operator--(int) noexcept
+			{
+				auto temp = *this;
+				--(*this);
+				return temp;
+			}
+			constexpr iterator &operator--() noexcept
+			{
+				--m_ptr;
+				return *this;
+			}
+
+			/** Returns a proxy pointer to the target element. */
+			[[nodiscard]] constexpr pointer operator->() const noexcept { return pointer{**this}; }
+			/** Returns the target element. Strings are returned as views into the string pool of the image. */
+			[[nodiscard]] constexpr reference operator*() const noexcept
+			{
+				const auto key = key_repr::view(m_ptr->key, m_pool);
+				if constexpr (std::is_void_v<M>)
+					return key;
+				else
+					return {key, mapped_repr<M>::view(m_ptr->mapped, m_pool)};
+			}
+
+			[[nodiscard]] constexpr bool operator==(const iterator &other) const noexcept
+			{
+				return m_ptr == other.m_ptr;
+			}
+
+		private:
+			const entry_type *m_ptr = nullptr;
+			const std::byte *m_pool = nullptr;
+		};
+
+	public:
+		template<typename Iter, typename Get>
+		[[nodiscard]] static std::vector<std::byte> make_image(Iter first, size_type n, const Hash &hash, Get get)
+		{
+			if (n >= npos) throw std::length_error("Mapped table size exceeds the range of chain indices");
+
+			/* Bucket count is a power of 2, which makes chains at most 2 entries long on average. */
+			const auto bucket_count = std::bit_ceil(n / 2 + 1);
+			std::vector<std::uint32_t> buckets(bucket_count, npos);
+			std::vector<std::byte> entries(n * sizeof(entry_type));
+			std::vector<std::byte> pool;
+
+			for (size_type i = 0; i < n; ++i, ++first)
+			{
+				/* Entries are zero-filled, so that padding bytes of the image are deterministic. */
+				entry_type entry;
+				std::memset(&entry, 0, sizeof(entry_type));
+				if constexpr (std::is_void_v<M>)
+					entry.key = key_repr::store(get(*first), pool);
+				else
+				{
+					const auto &[key, mapped] = get(*first);
+					entry.key = key_repr::store(key, pool);
+					entry.mapped = mapped_repr<M>::store(mapped, pool);
+				}
+				/* Hash the key view, since lookups are done using views of the stored keys. */
+				entry.hash = hash(key_repr::view(entry.key, pool.data()));
+
+				auto &chain = buckets[entry.hash & (bucket_count - 1)];
+				entry.next = chain;
+				chain = static_cast<std::uint32_t>(i);
+				std::memcpy(entries.data() + i * sizeof(entry_type), &entry, sizeof(entry_type));
+			}
+
+			mapped_table_header header = {};
+			header.magic = mapped_table_header::magic_value;
+			header.version = mapped_table_header::version_value;
+			header.entry_size = static_cast<std::uint32_t>(sizeof(entry_type));
+			header.entry_align = static_cast<std::uint32_t>(alignof(entry_type));
+			header.key_tag = key_repr::type_tag;
+			header.mapped_tag = mapped_tag;
+			header.size = n;
+			header.bucket_count = bucket_count;
+			header.buckets_off = sizeof(mapped_table_header);
+			const auto buckets_end = header.buckets_off + bucket_count * sizeof(std::uint32_t);
+			header.entries_off = mapped_align_up(buckets_end, alignof(entry_type));
+			header.pool_off = mapped_align_up(header.entries_off + n * sizeof(entry_type), alignof(std::uint64_t));
+			header.pool_size = pool.size();
+
+			/* Padding between sections is zero-filled, thus images of equal tables are identical. */
+			std::vector<std::byte> result(header.pool_off + header.pool_size);
+			std::memcpy(result.data(), &header, sizeof(header));
+			std::memcpy(result.data() + header.buckets_off, buckets.data(), bucket_count * sizeof(std::uint32_t));
+			if (n != 0) std::memcpy(result.data() + header.entries_off, entries.data(), entries.size());
+			if (!pool.empty()) std::memcpy(result.data() + header.pool_off, pool.data(), pool.size());
+			return result;
+		}
+
+	public:
+		constexpr mapped_dense_table() noexcept = default;
+		mapped_dense_table(std::span<const std::byte> image, const Hash &hash, const Cmp &cmp)
+			: m_image(image), m_funcs(hash, cmp)
+		{
+			if (image.size() < sizeof(mapped_table_header)) invalid_image();
+			if (reinterpret_cast<std::uintptr_t>(image.data()) % alignof(std::uint64_t) != 0) invalid_image();
+
+			mapped_table_header header;
+			std::memcpy(&header, image.data(), sizeof(header));
+			if (header.magic != mapped_table_header::magic_value ||
+				header.version != mapped_table_header::version_value || header.entry_size != sizeof(entry_type) ||
+				header.entry_align != alignof(entry_type) || header.key_tag != key_repr::type_tag ||
+				header.mapped_tag != mapped_tag)
+				invalid_image();
+
+			/* Make sure all sections are within the image & properly aligned. Contents of the sections are trusted. */
+			const auto image_size = static_cast<std::uint64_t>(image.size());
+			if (!std::has_single_bit(header.bucket_count) || header.size >= npos || header.pool_off > image_size ||
+				header.pool_size > image_size - header.pool_off || header.entries_off > header.pool_off ||
+				header.size > (header.pool_off - header.entries_off) / sizeof(entry_type) ||
+				header.buckets_off > header.entries_off ||
+				header.bucket_count > (header.entries_off - header.buckets_off) / sizeof(std::uint32_t) ||
+				header.buckets_off % alignof(std::uint32_t) != 0 || header.entries_off % alignof(entry_type) != 0)
+				invalid_image();
+
+			const auto *data = image.data();
+			m_buckets = reinterpret_cast<const std::uint32_t *>(data + header.buckets_off);
+			m_entries = reinterpret_cast<const entry_type *>(data + header.entries_off);
+			m_pool = data + header.pool_off;
+			m_size = static_cast<size_type>(header.size);
+			m_bucket_count = static_cast<size_type>(header.bucket_count);
+		}
+
+		[[nodiscard]] constexpr iterator begin() const noexcept { return iterator{m_entries, m_pool}; }
+		[[nodiscard]] constexpr iterator end() const noexcept { return iterator{m_entries + m_size, m_pool}; }
+
+		[[nodiscard]] constexpr iterator find(const auto &key) const noexcept
+		{
+			const auto h = static_cast<std::uint64_t>(m_funcs.first()(key));
+			for (auto idx = m_bucket_count != 0 ? m_buckets[h & (m_bucket_count - 1)] : npos; idx != npos;)
+			{
+				const auto &entry = m_entries[idx];
+				if (entry.hash == h && m_funcs.second()(key, key_repr::view(entry.key, m_pool)))
+					return iterator{&entry, m_pool};
+				idx = entry.next;
+			}
+			return end();
+		}
+
+		[[nodiscard]] constexpr size_type size() const noexcept { return m_size; }
+		[[nodiscard]] constexpr size_type bucket_count() const noexcept { return m_bucket_count; }
+		[[nodiscard]] constexpr std::span<const std::byte> image() const noexcept { return m_image; }
+
+		[[nodiscard]] constexpr const Hash &get_hash() const noexcept { return m_funcs.first(); }
+		[[nodiscard]] constexpr const Cmp &get_comp() const noexcept { return m_funcs.second(); }
+
+		constexpr void swap(mapped_dense_table &other) noexcept
+		{
+			using std::swap;
+			swap(m_image, other.m_image);
+			swap(m_funcs, other.m_funcs);
+			swap(m_buckets, other.m_buckets);
+			swap(m_entries, other.m_entries);
+			swap(m_pool, other.m_pool);
+			swap(m_size, other.m_size);
+			swap(m_bucket_count, other.m_bucket_count);
+		}
+
+	private:
+		[[noreturn]] static void invalid_image() { throw std::invalid_argument("Invalid mapped table image"); }
+
+		std::span<const std::byte> m_image;
+		packed_pair<Hash, Cmp> m_funcs;
+
+		const std::uint32_t *m_buckets = nullptr;
+		const entry_type *m_entries = nullptr;
+		const std::byte *m_pool = nullptr;
+		size_type m_size = 0;
+		size_type m_bucket_count = 0;
+	};
+}	 // namespace sek::detail
\ No newline at end of file
@@ -10,8 +10,13 @@ namespace sek::detail
 {
 	/* Ordered hash tables are similar in design to dense hash tables, additionally preserving insertion order of
 	 * elements. This functionality allows the user to efficiently preform key-based operations, while keeping
-	 * track of insertion order of elements without the need for external ordering. Internally, every element of
-	 * the table maintains a bidirectional linked list of element insertion order. */
+	 * track of insertion order of elements without the need for external ordering.
+	 *
+	 * Elements of the dense array are kept physically in insertion order, thus iteration is a sequential scan of
+	 * the dense array. New elements are always appended to the end of the array, and erased elements are left as
+	 * holes (same as with tombstone erasure of dense tables), which are skipped by iterators. Trailing holes are
+	 * removed immediately, while the rest of the holes are removed on insertion once they make up more than half
+	 * of the dense array, or on explicit compaction & rehash. */
 	template<typename Key, typename Value, typename Traits, typename Hash, typename Cmp, typename KeyGet, typename Alloc>
 	class ordered_hash_table : dense_table_traits<Value, Hash, Cmp, KeyGet>
 	{
@@ -24,129 +29,31 @@ namespace sek::detail
 		typedef typename table_traits::difference_type difference_type;
 
 	private:
+		using bucket_policy = typename table_traits::bucket_policy;
+		using entry_type = typename table_traits::entry_type;
+
 		using table_traits::get_key;
 		using table_traits::initial_capacity;
 		using table_traits::initial_load_factor;
 		using table_traits::npos;
+		using table_traits::small_size;
 
-		struct entry_node
-		{
-			constexpr entry_node() noexcept = default;
-			constexpr entry_node(const entry_node &) noexcept = default;
-			constexpr entry_node &operator=(const entry_node &) noexcept = default;
-
-			constexpr entry_node(entry_node &&other) noexcept : prev(other.prev), next(other.next) { relink(); }
-			constexpr entry_node &operator=(entry_node &&other) noexcept
-			{
-				prev = other.prev;
-				next = other.next;
-				return relink();
-			}
-
-			constexpr entry_node(entry_node *prev, entry_node *next) noexcept : prev(prev), next(next) {}
-
-			constexpr entry_node &link_before(entry_node *next_ptr) noexcept { return link(next_ptr->prev, next_ptr); }
-			constexpr entry_node &link(entry_node *prev_ptr, entry_node *next_ptr) noexcept
-			{
-				prev = prev_ptr;
-				next = next_ptr;
-				prev_ptr->next = this;
-				next_ptr->prev = this;
-				return *this;
-			}
-			constexpr entry_node &relink() noexcept
-			{
-				next->prev = this;
-				prev->next = this;
-				return *this;
-			}
-			constexpr entry_node &unlink() noexcept
-			{
-				next->prev = prev;
-				prev->next = next;
-				return *this;
-			}
-
-			constexpr void swap(entry_node &other) noexcept
-			{
-				std::swap(prev, other.prev);
-				std::swap(next, other.next);
-			}
-			constexpr void swap_head(entry_node &other) noexcept
-			{
-				const auto old_next = next;
-				const auto old_prev = prev;
-				const auto other_next = other.next;
-				const auto other_prev = other.prev;
-
-				/* If `next` & `prev` do not point to `this`, give them to `other`. */
-				if (old_next != this) [[likely]]
-					other.next = old_next;
-				if (old_prev != this) [[likely]]
-					other.prev = old_prev;
-
-				/* If `other.next` & `other.prev` do not point to `other`, take them. */
-				if (other_next != &other) [[likely]]
-					next = other_next;
-				if (other_prev != &other) [[likely]]
-					prev = other_prev;
-			}
-
-			entry_node *prev = nullptr;
-			entry_node *next = nullptr;
-		};
-		class entry_type : public entry_node, private table_traits::entry_type
-		{
-			using entry_base = typename table_traits::entry_type;
-			using node_base = entry_node;
-
-		public:
-			constexpr entry_type() = default;
-			constexpr entry_type(const entry_type &) = default;
-			constexpr entry_type &operator=(const entry_type &) = default;
-			constexpr entry_type(entry_type &&) noexcept(std::is_nothrow_move_constructible_v<entry_base>) = default;
-			constexpr entry_type &operator=(entry_type &&) noexcept(std::is_nothrow_move_assignable_v<entry_base>) = default;
-			constexpr ~entry_type() = default;
-
-			// clang-format off
-			template<typename... Args>
-			constexpr explicit entry_type(Args &&...args) requires std::constructible_from<Value, Args...>
-				: entry_base(std::forward<Args>(args)...)
-			{
-			}
-			// clang-format on
-
-			template<typename... Args>
-			constexpr explicit entry_type(Args &&...args) : entry_base(std::forward<Args>(args)...)
-			{
-			}
-			template<typename... Args>
-			constexpr entry_type(entry_node &n, std::size_t h, Args &&...args) : entry_base(std::forward<Args>(args)...)
-			{
-				node_base::link_before(&n);
-				entry_base::hash = h;
-			}
+		using index_type = typename table_traits::index_type;
+		using sparse_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<index_type>;
+		using sparse_data = std::vector<index_type, sparse_alloc>;
+		using dense_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<entry_type>;
+		using dense_data = std::vector<entry_type, dense_alloc>;
 
-			using entry_base::bucket_next;
-			using entry_base::hash;
-			using entry_base::key;
-			using entry_base::value;
+		/* High bit of chain indices is reserved for marking holes. */
+		constexpr static size_type max_index = entry_type::hole_bit - 2;
 
-			constexpr void swap(entry_type &other) noexcept(std::is_nothrow_swappable_v<entry_base>)
-			{
-				node_base::swap(other);
-				entry_base::swap(other);
-			}
-			friend constexpr void swap(entry_type &a, entry_type &b) noexcept(std::is_nothrow_swappable_v<entry_type>)
-			{
-				a.swap(b);
-			}
-		};
+		using dense_pair = packed_pair<dense_data, Cmp>;
+		using sparse_pair = packed_pair<sparse_data, Hash>;
 
-		using sparse_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<size_type>;
-		using sparse_data = std::vector<size_type, sparse_alloc>;
-		using dense_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<entry_type>;
-		using dense_data = std::vector<entry_type, dense_alloc>;
+		constexpr static bool nothrow_move_construct =
+			std::is_nothrow_move_constructible_v<dense_pair> && std::is_nothrow_move_constructible_v<sparse_pair>;
+		constexpr static bool nothrow_move_assign =
+			std::is_nothrow_move_assignable_v<dense_pair> && std::is_nothrow_move_assignable_v<sparse_pair>;
 
 		template<bool IsConst>
 		class ordered_table_iterator
@@ -155,8 +62,7 @@ namespace sek::detail
 			friend class ordered_table_iterator;
 			friend class ordered_hash_table;
 
-			using iter_t = std::conditional_t<IsConst, typename dense_data::const_iterator, typename dense_data::iterator>;
-			using ptr_t = std::conditional_t<IsConst, const entry_node, entry_node> *;
+			using ptr_t = std::conditional_t<IsConst, const entry_type, entry_type> *;
 
 		public:
 			typedef typename Traits::value_type value_type;
@@ -167,14 +73,16 @@ namespace sek::detail
 			typedef std::bidirectional_iterator_tag iterator_category;
 
 		private:
-			constexpr explicit ordered_table_iterator(iter_t iter) noexcept : m_ptr(std::to_address(iter)) {}
-			constexpr explicit ordered_table_iterator(ptr_t ptr) noexcept : m_ptr(ptr) {}
+			constexpr explicit ordered_table_iterator(ptr_t ptr, ptr_t end) noexcept : m_ptr(ptr), m_end(end)
+			{
+				skip_holes();
+			}
 
 		public:
 			constexpr ordered_table_iterator() noexcept = default;
 			template<bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
 			constexpr ordered_table_iterator(const ordered_table_iterator<OtherConst> &other) noexcept
-				: ordered_table_iterator(other.m_ptr)
+				: ordered_table_iterator(other.m_ptr, other.m_end)
 			{
 			}
 
@@ -186,7 +94,8 @@ namespace sek::detail
 			}
 			constexpr ordered_table_iterator &operator++() noexcept
 			{
-				m_ptr = m_ptr->next;
+				++m_ptr;
+				skip_holes();
 				return *this;
 			}
 			constexpr ordered_table_iterator operator--(int) noexcept
@@ -197,31 +106,45 @@ namespace sek::detail
 			}
 			constexpr ordered_table_iterator &operator--() noexcept
 			{
-				m_ptr = m_ptr->prev;
+				/* Decrementing the begin iterator is undefined, thus a preceding element always exists. */
+				do
+					--m_ptr;
+				while (m_ptr->is_hole());
 				return *this;
 			}
 
 			/** Returns pointer to the target element. */
-			[[nodiscard]] constexpr pointer get() const noexcept { return pointer{std::addressof(entry()->value)}; }
+			[[nodiscard]] constexpr pointer get() const noexcept { return pointer{std::addressof(m_ptr->value)}; }
 			/** @copydoc value */
 			[[nodiscard]] constexpr pointer operator->() const noexcept { return get(); }
 			/** Returns reference to the target element. */
 			[[nodiscard]] constexpr reference operator*() const noexcept { return *get(); }
 
-			[[nodiscard]] constexpr auto operator<=>(const ordered_table_iterator &) const noexcept = default;
-			[[nodiscard]] constexpr bool operator==(const ordered_table_iterator &) const noexcept = default;
+			[[nodiscard]] constexpr auto operator<=>(const ordered_table_iterator &other) const noexcept
+			{
+				return m_ptr <=> other.m_ptr;
+			}
+			[[nodiscard]] constexpr bool operator==(const ordered_table_iterator &other) const noexcept
+			{
+				return m_ptr == other.m_ptr;
+			}
 
-			constexpr void swap(ordered_table_iterator &other) noexcept { std::swap(m_ptr, other.m_ptr); }
+			constexpr void swap(ordered_table_iterator &other) noexcept
+			{
+				using std::swap;
+				swap(m_ptr, other.m_ptr);
+				swap(m_end, other.m_end);
+			}
 			friend constexpr void swap(ordered_table_iterator &a, ordered_table_iterator &b) noexcept { a.swap(b); }
 
 		private:
-			[[nodiscard]] constexpr auto *entry() const noexcept
+			constexpr void skip_holes() noexcept
 			{
-				using entry_ptr = std::conditional_t<IsConst, const entry_type, entry_type> *;
-				return static_cast<entry_ptr>(m_ptr);
+				while (m_ptr != m_end && m_ptr->is_hole()) ++m_ptr;
 			}
 
 			ptr_t m_ptr = {};
+			ptr_t m_end = {};
 		};
 		template<bool IsConst>
 		class ordered_table_bucket_iterator
@@ -270,7 +193,10 @@ namespace sek::detail
 			}
 
 			/** Returns pointer to the target element. */
-			[[nodiscard]] constexpr pointer get() const noexcept { return pointer{std::addressof(m_ptr->value)}; }
+			[[nodiscard]] constexpr pointer get() const noexcept
+			{
+				return pointer{std::addressof(m_ptr[static_cast<difference_type>(m_off)].value)};
+			}
 			/** @copydoc value */
 			[[nodiscard]] constexpr pointer operator->() const noexcept { return get(); }
 			/** Returns reference to the target element. */
@@ -314,27 +240,13 @@ namespace sek::detail
 		constexpr ordered_hash_table(size_type bucket_count, const Cmp &equal, const Hash &hash, const Alloc &alloc)
 			: m_dense{dense_alloc{alloc}, equal},
 			  m_sparse{std::piecewise_construct,
-					   std::forward_as_tuple(bucket_count, npos, sparse_alloc{alloc}),
+					   std::forward_as_tuple(small_bucket_count(bucket_count), npos, sparse_alloc{alloc}),
 					   std::forward_as_tuple(hash)}
 		{
 		}
 
-		constexpr ordered_hash_table(const ordered_hash_table &other)
-			: m_dense{other.m_dense}, m_sparse{other.m_sparse}, max_load_factor{other.max_load_factor}
-		{
-			rebase_nodes(other);
-		}
-		constexpr ordered_hash_table &operator=(const ordered_hash_table &other)
-		{
-			if (this != &other)
-			{
-				m_dense = other.m_dense;
-				m_sparse = other.m_sparse;
-				max_load_factor = other.max_load_factor;
-				rebase_nodes(other);
-			}
-			return *this;
-		}
+		constexpr ordered_hash_table(const ordered_hash_table &) = default;
+		constexpr ordered_hash_table &operator=(const ordered_hash_table &) = default;
 
 		constexpr ordered_hash_table(const ordered_hash_table &other, const Alloc &alloc)
 			: m_dense{std::piecewise_construct,
@@ -343,13 +255,32 @@ namespace sek::detail
 			  m_sparse{std::piecewise_construct,
 					   std::forward_as_tuple(other.bucket_vector(), sparse_alloc{alloc}),
 					   std::forward_as_tuple(other.m_sparse.second())},
+			  m_small_chain{other.m_small_chain},
+			  m_begin{other.m_begin},
+			  m_holes{other.m_holes},
 			  max_load_factor{other.max_load_factor}
 		{
-			rebase_nodes(other);
 		}
 
-		constexpr ordered_hash_table(ordered_hash_table &&) = default;
-		constexpr ordered_hash_table &operator=(ordered_hash_table &&) = default;
+		constexpr ordered_hash_table(ordered_hash_table &&other) noexcept(nothrow_move_construct)
+			: m_dense{std::move(other.m_dense)},
+			  m_sparse{std::move(other.m_sparse)},
+			  m_small_chain{std::exchange(other.m_small_chain, npos)},
+			  m_begin{std::exchange(other.m_begin, 0)},
+			  m_holes{std::exchange(other.m_holes, 0)},
+			  max_load_factor{other.max_load_factor}
+		{
+		}
+		constexpr ordered_hash_table &operator=(ordered_hash_table &&other) noexcept(nothrow_move_assign)
+		{
+			m_dense = std::move(other.m_dense);
+			m_sparse = std::move(other.m_sparse);
+			m_small_chain = std::exchange(other.m_small_chain, npos);
+			m_begin = std::exchange(other.m_begin, 0);
+			m_holes = std::exchange(other.m_holes, 0);
+			max_load_factor = other.max_load_factor;
+			return *this;
+		}
 
 		constexpr ordered_hash_table(ordered_hash_table &&other, const Alloc &alloc)
 			: m_dense{std::piecewise_construct,
@@ -358,15 +289,18 @@ namespace sek::detail
 			  m_sparse{std::piecewise_construct,
 					   std::forward_as_tuple(std::move(other.bucket_vector()), sparse_alloc{alloc}),
 					   std::forward_as_tuple(std::move(other.m_sparse.second()))},
+			  m_small_chain{std::exchange(other.m_small_chain, npos)},
+			  m_begin{std::exchange(other.m_begin, 0)},
+			  m_holes{std::exchange(other.m_holes, 0)},
 			  max_load_factor{other.max_load_factor}
 		{
 		}
 
-		[[nodiscard]] constexpr auto begin() noexcept { return iterator{m_head.next}; }
-		[[nodiscard]] constexpr auto cbegin() const noexcept { return const_iterator{m_head.next}; }
+		[[nodiscard]] constexpr auto begin() noexcept { return to_iterator(m_begin); }
+		[[nodiscard]] constexpr auto cbegin() const noexcept { return to_iterator(m_begin); }
 		[[nodiscard]] constexpr auto begin() const noexcept { return cbegin(); }
-		[[nodiscard]] constexpr auto end() noexcept { return iterator{&m_head}; }
-		[[nodiscard]] constexpr auto cend() const noexcept { return const_iterator{&m_head}; }
+		[[nodiscard]] constexpr auto end() noexcept { return to_iterator(value_vector().size()); }
+		[[nodiscard]] constexpr auto cend() const noexcept { return to_iterator(value_vector().size()); }
 		[[nodiscard]] constexpr auto end() const noexcept { return cend(); }
 		[[nodiscard]] constexpr auto rbegin() noexcept { return reverse_iterator{end()}; }
 		[[nodiscard]] constexpr auto crbegin() const noexcept { return const_reverse_iterator{cend()}; }
@@ -375,32 +309,36 @@ namespace sek::detail
 		[[nodiscard]] constexpr auto crend() const noexcept { return const_reverse_iterator{cbegin()}; }
 		[[nodiscard]] constexpr auto rend() const noexcept { return crend(); }
 
-		[[nodiscard]] constexpr size_type size() const noexcept { return value_vector().size(); }
+		[[nodiscard]] constexpr size_type size() const noexcept { return value_vector().size() - m_holes; }
 		[[nodiscard]] constexpr size_type capacity() const noexcept
 		{
 			/* Capacity needs to take into account the max load factor. */
+			if (is_small()) return small_size;
 			return static_cast<size_type>(static_cast<float>(bucket_count()) * max_load_factor);
 		}
 		[[nodiscard]] constexpr size_type max_size() const noexcept
 		{
-			const auto max_idx = std::min(value_vector().max_size(), npos - 1);
+			const auto max_idx = std::min(value_vector().max_size(), max_index);
 			return static_cast<size_type>(static_cast<float>(max_idx) * max_load_factor);
 		}
 		[[nodiscard]] constexpr float load_factor() const noexcept
 		{
 			return static_cast<float>(size()) / static_cast<float>(bucket_count());
 		}
-
-		[[nodiscard]] constexpr size_type bucket_count() const noexcept { return bucket_vector().size(); }
+		[[nodiscard]] constexpr size_type bucket_count() const noexcept
+		{
+			/* Small tables have a single bucket. */
+			return is_small() ? 1 : bucket_vector().size();
+		}
 		[[nodiscard]] constexpr size_type max_bucket_count() const noexcept { return bucket_vector().max_size(); }
 
 		[[nodiscard]] constexpr auto begin(size_type bucket) noexcept
 		{
-			return local_iterator{value_vector().begin(), bucket};
+			return local_iterator{value_vector().begin(), *get_bucket(bucket)};
 		}
 		[[nodiscard]] constexpr auto cbegin(size_type bucket) const noexcept
 		{
-			return const_local_iterator{value_vector().begin(), bucket};
+			return const_local_iterator{value_vector().begin(), *get_bucket(bucket)};
 		}
 		[[nodiscard]] constexpr auto begin(size_type bucket) const noexcept { return cbegin(bucket); }
 		[[nodiscard]] constexpr auto end(size_type) noexcept { return local_iterator{value_vector().begin(), npos}; }
@@ -414,71 +352,89 @@ namespace sek::detail
 		{
 			return static_cast<size_type>(std::distance(begin(bucket), end(bucket)));
 		}
-		[[nodiscard]] constexpr size_type bucket(const auto &key) const noexcept { return *get_chain(key_hash(key)); }
+		[[nodiscard]] constexpr size_type bucket(const auto &key) const noexcept
+		{
+			return bucket_policy::index(key_hash(key), bucket_count());
+		}
 		[[nodiscard]] constexpr size_type bucket(const_iterator iter) const noexcept
 		{
-			return *get_chain(iter.m_ptr->hash);
+			return bucket_policy::index(entry_hash(*iter.m_ptr), bucket_count());
 		}
 
 		[[nodiscard]] constexpr auto find(const auto &key) noexcept
 		{
-			return to_iterator(find_impl(key_hash(key), key));
+			const auto idx = find_impl(key_hash(key), key);
+			return idx != value_vector().size() ? to_iterator(idx) : end();
 		}
 		[[nodiscard]] constexpr auto find(const auto &key) const noexcept
 		{
-			return to_iterator(find_impl(key_hash(key), key));
+			const auto idx = find_impl(key_hash(key), key);
+			return idx != value_vector().size() ? to_iterator(idx) : end();
 		}
 
 		constexpr void clear()
 		{
-			std::fill_n(bucket_vector().data(), bucket_count(), npos);
+			std::fill_n(bucket_vector().data(), bucket_vector().size(), npos);
+			m_small_chain = npos;
 			value_vector().clear();
+			m_begin = 0;
+			m_holes = 0;
 		}
 
 		constexpr void rehash(size_type new_cap)
 		{
-			using std::max;
+			new_cap = adjust_bucket_count(new_cap);
 
-			/* Adjust the capacity to be at least large enough to fit the current size. */
-			new_cap = max(max(static_cast<size_type>(static_cast<float>(size()) / max_load_factor), new_cap), initial_capacity);
-
-			/* Don't do anything if the capacity did not change after the adjustment. */
-			if (new_cap != bucket_vector().capacity()) [[likely]]
+			/* Don't do anything if the capacity did not change after the adjustment. Holes are always removed. */
+			if (new_cap != bucket_vector().size() || m_holes != 0) [[likely]]
+			{
+				remove_holes();
 				rehash_impl(new_cap);
+			}
 		}
 		constexpr void reserve(size_type n)
 		{
 			value_vector().reserve(n);
 			rehash(static_cast<size_type>(static_cast<float>(n) / max_load_factor));
 		}
+		constexpr void compact()
+		{
+			if (m_holes != 0)
+			{
+				remove_holes();
+				rehash_impl(bucket_vector().size());
+			}
+		}
 
 		template<typename... Args>
 		constexpr std::pair<iterator, bool> emplace(Args &&...args)
 		{
 			/* Temporary entry needs to be created at first. */
-			const auto old_size = size();
+			maybe_compact();
+			const auto old_size = value_vector().size();
 			auto &entry = value_vector().emplace_back(std::forward<Args>(args)...);
 
 			/* Try to find an existing entry with the same key. */
-			const auto h = entry.hash = key_hash(entry.key());
+			const auto h = key_hash(entry.key());
+			entry.set_hash(h);
 			auto *chain_idx = get_chain(h);
 			while (*chain_idx != npos)
 				if (auto &candidate = value_vector()[*chain_idx];
-					candidate.hash == h && key_comp(entry.key(), candidate.key()))
+					candidate.hash_eq(h) && key_comp(entry.key(), candidate.key()))
 				{
 					/* Found a candidate for replacing. Move-assign it and remove the temporary. */
 					candidate.value = std::move(entry.value);
 					value_vector().pop_back();
-					return {iterator{&candidate}, false};
+					return {to_iterator(static_cast<size_type>(&candidate - value_vector().data())), false};
 				}
 				else
 					chain_idx = &candidate.bucket_next;
 
 			/* No suitable entry for replacing was found, add new link. */
-			const auto pos = *chain_idx = old_size;
-			entry.link_before(&m_head);
+			SEK_ASSERT(old_size <= max_index, "Table size exceeds the range of chain indices");
+			*chain_idx = static_cast<index_type>(old_size);
 			maybe_rehash();
-			return {iterator{&entry}, true};
+			return {to_iterator(old_size), true};
 		}
 		template<typename... Args>
 		constexpr std::pair<iterator, bool> try_emplace(const auto &key, Args &&...args)
@@ -544,11 +500,22 @@ namespace sek::detail
 
 		constexpr auto erase(const_iterator first, const_iterator last)
 		{
-			auto result = end();
-			while (first < last) result = erase(first);
-			return result;
+			/* Erase from the back, so that removal of trailing holes does not invalidate the rest of the range. */
+			auto &values = value_vector();
+			const auto first_idx = static_cast<size_type>(first.m_ptr - values.data());
+			const auto last_idx = static_cast<size_type>(last.m_ptr - values.data());
+			for (auto i = last_idx; i > first_idx;)
+			{
+				/* The dense array may shrink past `i` after trailing holes are removed. */
+				i = std::min(i, values.size()) - 1;
+				if (!values[i].is_hole()) erase(to_iterator(i));
+			}
+			return last_idx < values.size() ? to_iterator(last_idx) : end();
+		}
+		constexpr auto erase(const_iterator where)
+		{
+			return erase_impl(entry_hash(*where.m_ptr), where.m_ptr->key());
 		}
-		constexpr auto erase(const_iterator where) { return erase_impl(where.entry()->hash, get_key(*where.get())); }
 
 		// clang-format off
 		template<typename T>
@@ -559,6 +526,43 @@ namespace sek::detail
 		}
 		// clang-format on
 
+		template<typename P>
+		constexpr size_type erase_if(P &&pred)
+		{
+			/* Move retained entries towards the front (which preserves their insertion order & removes the holes),
+			 * then re-link all chains at once. */
+			auto &values = value_vector();
+			size_type pos = 0, i = 0;
+			try
+			{
+				for (; i < values.size(); ++i)
+					if (!values[i].is_hole() && !pred(*to_iterator(i)))
+					{
+						if (i != pos) values[pos] = std::move(values[i]);
+						++pos;
+					}
+			}
+			catch (...)
+			{
+				/* Moved-from, erased entries & holes are located between `pos` & `i`. */
+				const auto first = values.begin() + static_cast<difference_type>(pos);
+				values.erase(first, values.begin() + static_cast<difference_type>(i));
+				remove_holes();
+				rehash_impl(bucket_vector().size());
+				throw;
+			}
+
+			const auto result = size() - pos;
+			if (pos != values.size())
+			{
+				values.erase(values.begin() + static_cast<difference_type>(pos), values.end());
+				m_begin = 0;
+				m_holes = 0;
+				rehash_impl(bucket_vector().size());
+			}
+			return result;
+		}
+
 		[[nodiscard]] constexpr auto allocator() const noexcept { return value_vector().get_allocator(); }
 		[[nodiscard]] constexpr auto &get_hash() const noexcept { return m_sparse.second(); }
 		[[nodiscard]] constexpr auto &get_comp() const noexcept { return m_dense.second(); }
@@ -568,10 +572,10 @@ namespace sek::detail
 			using std::swap;
 			swap(m_sparse, other.m_sparse);
 			swap(m_dense, other.m_dense);
+			swap(m_small_chain, other.m_small_chain);
+			swap(m_begin, other.m_begin);
+			swap(m_holes, other.m_holes);
 			swap(max_load_factor, other.max_load_factor);
-
-			/* Head nodes should be swapped in-place. */
-			m_head.swap_head(other.m_head);
 		}
 
 	private:
@@ -580,56 +584,48 @@ namespace sek::detail
 		[[nodiscard]] constexpr auto &bucket_vector() noexcept { return m_sparse.first(); }
 		[[nodiscard]] constexpr const auto &bucket_vector() const noexcept { return m_sparse.first(); }
 
-		constexpr void rebase_nodes(const ordered_hash_table &other)
-		{
-			for (const auto diff = value_vector().begin() - other.value_vector().begin(); entry_node & node : value_vector())
-			{
-				/* Rebase next pointer. */
-				if (node.next != &other.m_head) [[likely]]
-					node.next += diff;
-				else
-				{
-					node.next = &m_head;
-					m_head.prev = &node;
-				}
-
-				/* Rebase previous pointer. */
-				if (node.prev != &other.m_head) [[likely]]
-					node.prev += diff;
-				else
-				{
-					node.prev = &m_head;
-					m_head.next = &node;
-				}
-			}
-		}
-
 		[[nodiscard]] constexpr auto key_hash(const auto &k) const { return m_sparse.second()(k); }
 		[[nodiscard]] constexpr auto key_comp(const auto &a, const auto &b) const { return m_dense.second()(a, b); }
-		[[nodiscard]] constexpr auto *get_chain(std::size_t h) noexcept
+		[[nodiscard]] constexpr std::size_t entry_hash(const entry_type &entry) const
 		{
-			auto idx = h % bucket_count();
-			return bucket_vector().data() + idx;
+			if constexpr (table_traits::cache_hash)
+				return entry.hash;
+			else
+				return key_hash(entry.key());
 		}
-		[[nodiscard]] constexpr auto *get_chain(std::size_t h) const noexcept
+		[[nodiscard]] constexpr bool is_small() const noexcept { return bucket_vector().empty(); }
+		[[nodiscard]] constexpr const index_type *get_bucket(size_type bucket) const noexcept
 		{
-			auto idx = h % bucket_count();
+			return is_small() ? &m_small_chain : bucket_vector().data() + bucket;
+		}
+		[[nodiscard]] constexpr index_type *get_chain(std::size_t h) noexcept
+		{
+			return const_cast<index_type *>(std::as_const(*this).get_chain(h));
+		}
+		[[nodiscard]] constexpr const index_type *get_chain(std::size_t h) const noexcept
+		{
+			/* Small tables keep all entries within a single chain. */
+			if (is_small()) return &m_small_chain;
+
+			auto idx = bucket_policy::index(h, bucket_count());
 			return bucket_vector().data() + idx;
 		}
 
-		[[nodiscard]] constexpr auto to_iterator(auto idx) noexcept
+		[[nodiscard]] constexpr iterator to_iterator(size_type idx) noexcept
 		{
-			return iterator{value_vector().data() + static_cast<difference_type>(idx)};
+			auto *data = value_vector().data();
+			return iterator{data + idx, data + value_vector().size()};
 		}
-		[[nodiscard]] constexpr auto to_iterator(auto idx) const noexcept
+		[[nodiscard]] constexpr const_iterator to_iterator(size_type idx) const noexcept
 		{
-			return const_iterator{value_vector().data() + static_cast<difference_type>(idx)};
+			auto *data = value_vector().data();
+			return const_iterator{data + idx, data + value_vector().size()};
 		}
 
 		[[nodiscard]] constexpr size_type find_impl(std::size_t h, const auto &key) const noexcept
 		{
 			for (auto *idx = get_chain(h); *idx != npos;)
-				if (auto &entry = value_vector()[*idx]; entry.hash == h && key_comp(key, entry.key()))
+				if (auto &entry = value_vector()[*idx]; entry.hash_eq(h) && key_comp(key, entry.key()))
 					return *idx;
 				else
 					idx = &entry.bucket_next;
@@ -639,8 +635,10 @@ namespace sek::detail
 		template<typename... Args>
 		[[nodiscard]] constexpr iterator insert_new(std::size_t h, auto *chain_idx, Args &&...args) noexcept
 		{
-			const auto pos = *chain_idx = size();
-			value_vector().emplace_back(m_head, h, std::forward<Args>(args)...);
+			const auto pos = value_vector().size();
+			SEK_ASSERT(pos <= max_index, "Table size exceeds the range of chain indices");
+			*chain_idx = static_cast<index_type>(pos);
+			value_vector().emplace_back(std::forward<Args>(args)...).set_hash(h);
 			maybe_rehash();
 			return to_iterator(pos);
 		}
@@ -648,10 +646,11 @@ namespace sek::detail
 		[[nodiscard]] constexpr std::pair<iterator, bool> insert_impl(const auto &key, T &&value) noexcept
 		{
 			/* See if we can replace any entry. */
+			maybe_compact();
 			const auto h = key_hash(key);
 			auto *chain_idx = get_chain(h);
 			while (*chain_idx != npos)
-				if (auto &candidate = value_vector()[*chain_idx]; candidate.hash == h && key_comp(key, candidate.key()))
+				if (auto &candidate = value_vector()[*chain_idx]; candidate.hash_eq(h) && key_comp(key, candidate.key()))
 				{
 					/* Found a candidate for replacing, replace the value & hash. */
 					if constexpr (requires { candidate.value = std::forward<T>(value); })
@@ -661,8 +660,8 @@ namespace sek::detail
 						std::destroy_at(&candidate.value);
 						std::construct_at(&candidate.value, std::forward<T>(value));
 					}
-					candidate.hash = h;
-					return {to_iterator(*chain_idx), false};
+					candidate.set_hash(h);
+					return {to_iterator(static_cast<size_type>(*chain_idx)), false};
 				}
 				else
 					chain_idx = &candidate.bucket_next;
@@ -674,11 +673,12 @@ namespace sek::detail
 		[[nodiscard]] constexpr std::pair<iterator, bool> try_insert_impl(const auto &key, Args &&...args) noexcept
 		{
 			/* See if an entry already exists. */
+			maybe_compact();
 			const auto h = key_hash(key);
 			auto *chain_idx = get_chain(h);
 			while (*chain_idx != npos)
-				if (auto &existing = value_vector()[*chain_idx]; existing.hash == h && key_comp(key, existing.key()))
-					return {to_iterator(*chain_idx), false};
+				if (auto &existing = value_vector()[*chain_idx]; existing.hash_eq(h) && key_comp(key, existing.key()))
+					return {to_iterator(static_cast<size_type>(*chain_idx)), false};
 				else
 					chain_idx = &existing.bucket_next;
 
@@ -688,24 +688,67 @@ namespace sek::detail
 
 		constexpr void maybe_rehash()
 		{
-			if (load_factor() > max_load_factor) [[unlikely]]
-				rehash(bucket_count() * 2);
+			/* Holes are not removed here, since positions of entries must remain valid. */
+			if (is_small())
+			{
+				/* The bucket array is only built once the table outgrows the small chain. */
+				if (size() > small_size) [[unlikely]]
+					rehash_impl(adjust_bucket_count(0));
+			}
+			else if (load_factor() > max_load_factor) [[unlikely]]
+				rehash_impl(bucket_policy::round_count(bucket_count() * 2));
+		}
+		constexpr void maybe_compact()
+		{
+			/* Holes are removed once they make up more than half of the dense array. */
+			if (m_holes > size()) [[unlikely]]
+				compact();
+		}
+		[[nodiscard]] constexpr size_type adjust_bucket_count(size_type n) const noexcept
+		{
+			using std::max;
+
+			/* Small tables stay small unless either the size or the requested capacity exceed the small size. */
+			if (is_small() && size() <= small_size && static_cast<float>(n) * max_load_factor <= small_size)
+				return 0;
+
+			/* Adjust the capacity to be at least large enough to fit the current size. */
+			n = max(max(static_cast<size_type>(static_cast<float>(size()) / max_load_factor), n), initial_capacity);
+			return bucket_policy::round_count(n);
+		}
+		[[nodiscard]] constexpr static size_type small_bucket_count(size_type n) noexcept
+		{
+			return n > small_size ? bucket_policy::round_count(n) : 0;
+		}
+		constexpr void remove_holes()
+		{
+			if (m_holes != 0)
+			{
+				const auto pred = [](const entry_type &e) { return e.is_hole(); };
+				const auto tail = std::remove_if(value_vector().begin(), value_vector().end(), pred);
+				value_vector().erase(tail, value_vector().end());
+				m_holes = 0;
+			}
+			m_begin = 0;
 		}
 		constexpr void rehash_impl(size_type new_cap)
 		{
-			/* Clear & reserve the vector filled with npos. */
+			/* Clear & reserve the vector filled with npos. Zero capacity switches the table to the small chain. */
 			bucket_vector().clear();
 			bucket_vector().resize(new_cap, npos);
+			m_small_chain = npos;
 
-			/* Go through each entry & re-insert it. No need to re-link insertion order, as we are not moving elements. */
+			/* Go through each entry & re-insert it. Entries are not moved, thus the insertion order is preserved. */
 			for (size_type i = 0; i < value_vector().size(); ++i)
 			{
 				auto &entry = value_vector()[i];
-				auto *chain_idx = get_chain(entry.hash);
+				if (entry.is_hole()) [[unlikely]]
+					continue;
+				auto *chain_idx = get_chain(entry_hash(entry));
 
 				/* Will also handle cases where chain_idx is npos (empty chain). */
 				entry.bucket_next = *chain_idx;
-				*chain_idx = i;
+				*chain_idx = static_cast<index_type>(i);
 			}
 		}
 
@@ -717,36 +760,27 @@ namespace sek::detail
 				const auto pos = *chain_idx;
 				auto entry_ptr = value_vector().data() + static_cast<difference_type>(pos);
 
-				if (entry_ptr->hash == h && key_comp(key, entry_ptr->key()))
+				if (entry_ptr->hash_eq(h) && key_comp(key, entry_ptr->key()))
 				{
-					/* Unlink the entry from the bucket and insertion order. */
-					auto old_next = entry_ptr->next;
+					/* Un-link the entry from the chain & release the value. Other entries are never moved. */
 					*chain_idx = entry_ptr->bucket_next;
-					entry_ptr->unlink();
+					[[maybe_unused]] const auto released = std::move(entry_ptr->value);
+					entry_ptr->bucket_next = entry_type::hole_bit;
+					++m_holes;
 
-					/* If the entry is not at the end, replace it with the last entry. */
-					if (const auto end_pos = size() - 1; pos != end_pos)
+					auto &values = value_vector();
+					if (pos + 1 == values.size())
 					{
-						/* Move & re-link the last entry. */
-						const auto back_ptr = &value_vector().back();
-						*entry_ptr = std::move(*back_ptr);
-
-						/* Find the chain offset pointing to the old position & replace it with the new position. */
-						for (chain_idx = get_chain(entry_ptr->hash); *chain_idx != npos;
-							 chain_idx = &value_vector()[*chain_idx].bucket_next)
-							if (*chain_idx == end_pos)
-							{
-								*chain_idx = pos;
-								break;
-							}
-
-						/* If the back pointer is the same as old_next, update old_next. */
-						if (old_next == back_ptr) [[unlikely]]
-							old_next = entry_ptr;
+						/* Trailing holes are removed immediately, thus the last entry is never a hole. */
+						for (; !values.empty() && values.back().is_hole(); --m_holes) values.pop_back();
+						m_begin = std::min(m_begin, values.size());
+						return end();
 					}
 
-					value_vector().pop_back();
-					return iterator{old_next};
+					/* Skip leading holes, so that `begin` does not need to. */
+					if (pos == m_begin)
+						while (values[m_begin].is_hole()) ++m_begin;
+					return to_iterator(static_cast<size_type>(pos) + 1);
 				}
 				chain_idx = &entry_ptr->bucket_next;
 			}
@@ -754,9 +788,13 @@ namespace sek::detail
 		}
 
 		packed_pair<dense_data, Cmp> m_dense;
-		packed_pair<sparse_data, Hash> m_sparse = {sparse_data(initial_capacity, npos), Hash{}};;
+		packed_pair<sparse_data, Hash> m_sparse = {sparse_data{}, Hash{}};
+		/* Head of the only chain of a small table. */
+		index_type m_small_chain = npos;
 
-		entry_node m_head = {&m_head, &m_head};
+		/* Index of the first entry that is not a hole & amount of holes left by erasure. */
+		size_type m_begin = 0;
+		size_type m_holes = 0;
 
 	public:
 		float max_load_factor = initial_load_factor;
@@ -5,12 +5,16 @@
 #pragma once
 
 #include <algorithm>
+#include <bit>
+#include <cstdint>
 
 #include "../assert.hpp"
 #include "../hash.hpp"
 #include "../math/utility.hpp"
 #include "alloc_util.hpp"
+#include "basic_pool.hpp"
 #include "ebo_base_helper.hpp"
+#include "flat_table_group.hpp"
 #include "table_util.hpp"
 
 namespace sek::detail
@@ -56,49 +60,24 @@ namespace sek::detail
 	 * both your position in the table and within the node, which if you implement multimap as map of vectors, you'd
 	 * need to do the same, but will avoid the use of linked lists.
 	 * A multiset can be easily implemented as a map of counters that would be used to track the amount of specific keys within the set.
+	 *
+	 * Every bucket has a control byte, stored in a separate array from the bucket pointers. Control bytes contain 7 bits
+	 * of the bucket's hash, or mark the bucket as empty or deleted (tombstone). Control bytes are probed in groups of 16
+	 * (using SSE2 if available), thus probing does not touch the pointer array & only pointers of buckets with
+	 * a matching control byte are de-referenced. Bucket pointers of empty & deleted buckets are null, which allows
+	 * iterators to skip them without accessing the control bytes.
 	 * */
-	template<typename KeyType, typename ValueType, typename KeyHash, typename KeyCompare, typename KeyExtract, typename Allocator>
-	class sparse_hash_table;
-
-	template<typename KeyType, typename ValueType, typename KeyExtract>
-	struct sparse_table_bucket
-	{
-		[[nodiscard]] constexpr static auto tombstone_ptr() noexcept
-		{
-			return std::bit_cast<ValueType *>(std::numeric_limits<std::intptr_t>::max());
-		}
-
-		constexpr sparse_table_bucket() noexcept = default;
-		constexpr explicit sparse_table_bucket(ValueType *ptr, std::size_t hash) noexcept : hash(hash), data(ptr) {}
-
-		[[nodiscard]] constexpr bool is_empty() const noexcept { return data == nullptr; }
-		[[nodiscard]] constexpr bool is_tombstone() const noexcept { return data == tombstone_ptr(); }
-		[[nodiscard]] constexpr bool is_occupied() const noexcept { return !is_empty() && !is_tombstone(); }
-		constexpr void set_empty() noexcept { data = nullptr; }
-		constexpr void set_tombstone() noexcept { data = tombstone_ptr(); }
-
-		[[nodiscard]] constexpr decltype(auto) value() const noexcept { return *data; }
-		[[nodiscard]] constexpr decltype(auto) key() const noexcept { return KeyExtract{}(value()); }
-
-		constexpr void swap(sparse_table_bucket &other) noexcept
-		{
-			using std::swap;
-			swap(hash, other.hash);
-			swap(data, other.data);
-		}
-
-		std::size_t hash = 0;
-		ValueType *data;
-	};
-
 	template<typename KeyType, typename ValueType, typename KeyHash, typename KeyCompare, typename KeyExtract, typename Allocator>
 	class sparse_hash_table
 		: ebo_base_helper<Allocator>,
-		  ebo_base_helper<rebind_alloc_t<Allocator, sparse_table_bucket<KeyType, ValueType, KeyExtract>>>,
+		  ebo_base_helper<rebind_alloc_t<Allocator, ValueType *>>,
 		  ebo_base_helper<KeyCompare>,
-		  ebo_base_helper<KeyHash>
+		  ebo_base_helper<KeyHash>,
+		  ebo_base_helper<std::conditional_t<table_node_pool_v<KeyHash>, basic_pool<ValueType, Allocator>, void>>
 	{
-		using bucket_type = sparse_table_bucket<KeyType, ValueType, KeyExtract>;
+		using bucket_type = ValueType *;
+		using group_type = flat_table_group;
+		using probe_seq = flat_table_probe_seq;
 
 	public:
 		typedef KeyType key_type;
@@ -120,10 +99,15 @@ namespace sek::detail
 		using value_ebo_base = ebo_base_helper<allocator_type>;
 		using bucket_alloc_traits = std::allocator_traits<bucket_allocator_type>;
 		using bucket_ebo_base = ebo_base_helper<bucket_allocator_type>;
+		using ctrl_allocator_type = rebind_alloc_t<Allocator, std::int8_t>;
 
 		using compare_ebo_base = ebo_base_helper<key_equal>;
 		using hash_ebo_base = ebo_base_helper<hash_type>;
 
+		constexpr static bool pooled = table_node_pool_v<KeyHash>;
+		using pool_type = basic_pool<value_type, allocator_type>;
+		using pool_ebo_base = ebo_base_helper<std::conditional_t<pooled, pool_type, void>>;
+
 		template<bool IsConst>
 		class sparse_table_iterator
 		{
@@ -171,7 +155,7 @@ namespace sek::detail
 			}
 
 			/** Returns pointer to the target element. */
-			[[nodiscard]] constexpr pointer get() const noexcept { return &m_bucket_ptr->value(); }
+			[[nodiscard]] constexpr pointer get() const noexcept { return *m_bucket_ptr; }
 			/** @copydoc value */
 			[[nodiscard]] constexpr pointer operator->() const noexcept { return get(); }
 			/** Returns reference to the target element. */
@@ -193,7 +177,7 @@ namespace sek::detail
 		private:
 			constexpr void skip_to_next_occupied() noexcept
 			{
-				while (m_bucket_ptr != m_end_ptr && !m_bucket_ptr->is_occupied()) ++m_bucket_ptr;
+				while (m_bucket_ptr != m_end_ptr && *m_bucket_ptr == nullptr) ++m_bucket_ptr;
 			}
 
 			bucket_ptr_type m_bucket_ptr;
@@ -202,7 +186,7 @@ namespace sek::detail
 
 		constexpr static float initial_load_factor = .65f;
 		constexpr static float initial_tombstone_factor = .36f;
-		constexpr static size_type initial_capacity = 8;
+		constexpr static size_type initial_capacity = group_type::size;
 
 	public:
 		typedef sparse_table_iterator<false> iterator;
@@ -214,10 +198,7 @@ namespace sek::detail
 
 			using ebo_base = ebo_base_helper<allocator_type>;
 
-			constexpr explicit node_handle(bucket_type &b, const allocator_type &a) noexcept : ebo_base(a), m_bucket(b)
-			{
-				b.set_tombstone();
-			}
+			constexpr explicit node_handle(value_type *v, const allocator_type &a) noexcept : ebo_base(a), m_value(v) {}
 
 		public:
 			node_handle(const node_handle &) = delete;
@@ -227,19 +208,19 @@ namespace sek::detail
 			constexpr ~node_handle() { destroy(); }
 
 			constexpr node_handle(node_handle &&other) noexcept
-				: ebo_base(std::move(other.get_allocator())), m_bucket(other.reset())
+				: ebo_base(std::move(other.get_allocator())), m_value(other.reset())
 			{
 			}
 			constexpr node_handle &operator=(node_handle &&other) noexcept
 			{
 				destroy();
 				get_allocator() = std::move(other.get_allocator());
-				m_bucket = other.reset();
+				m_value = other.reset();
 				return *this;
 			}
 
-			[[nodiscard]] constexpr bool empty() const noexcept { return !m_bucket.is_occupied(); }
-			[[nodiscard]] constexpr value_type &value() const noexcept { return m_bucket.value(); }
+			[[nodiscard]] constexpr bool empty() const noexcept { return m_value == nullptr; }
+			[[nodiscard]] constexpr value_type &value() const noexcept { return *m_value; }
 
 			[[nodiscard]] constexpr allocator_type &get_allocator() noexcept { return *ebo_base::get(); }
 			[[nodiscard]] constexpr const allocator_type &get_allocator() const noexcept { return *ebo_base::get(); }
@@ -248,7 +229,7 @@ namespace sek::detail
 			{
 				using std::swap;
 				ebo_base::swap(other);
-				swap(m_bucket, other.m_bucket);
+				swap(m_value, other.m_value);
 			}
 
 			friend constexpr void swap(node_handle &a, node_handle &b) noexcept { a.swap(b); }
@@ -258,13 +239,15 @@ namespace sek::detail
 			{
 				if (!empty())
 				{
-					std::destroy_at(&m_bucket.value());
-					get_allocator().deallocate(&m_bucket.value(), 1);
+					std::destroy_at(m_value);
+
+					/* Nodes of pooled tables are owned by the pool. */
+					if constexpr (!pooled) get_allocator().deallocate(m_value, 1);
 				}
 			}
-			constexpr bucket_type reset() noexcept { return std::exchange(m_bucket, {}); }
+			constexpr value_type *reset() noexcept { return std::exchange(m_value, nullptr); }
 
-			bucket_type m_bucket = {};
+			value_type *m_value = nullptr;
 		};
 
 	private:
@@ -273,44 +256,28 @@ namespace sek::detail
 			return KeyExtract{}(value);
 		}
 
-		[[nodiscard]] constexpr static size_type next_probe_index(size_type index, size_type i, size_type m) noexcept
+		/* Rounds bucket count to a power of 2 multiple of group size. */
+		[[nodiscard]] constexpr static size_type round_capacity(size_type n) noexcept
 		{
-			return (index + i / 2 + (i * i) / 2) % m;
+			return next_pow_2(std::max(n, initial_capacity));
 		}
-
-		template<bool RequireOccupied>
-		[[nodiscard]] constexpr static bucket_type *
-			find_bucket_impl(bucket_type *data, size_type capacity, const auto &key, auto hash, const key_equal &compare) noexcept
+		/* Mixes the hash, so that weak hashes (ex. identity hashes of integers) are spread across groups. */
+		[[nodiscard]] constexpr static std::size_t mix_hash(std::size_t h) noexcept
 		{
-			if (capacity != 0) [[likely]] /* Initially, capacity is 0, so need to check. */
-			{
-				size_type index = static_cast<size_type>(hash % capacity), i = 0;
-				for (; i < capacity; index = next_probe_index(index, ++i, capacity))
-				{
-					auto &bucket = data[index];
-					if constexpr (!RequireOccupied)
-					{
-						if (!bucket.is_occupied()) return &bucket;
-					}
-					else
-					{
-						/* If we are not allowed to have empty buckets,
-						 * tombstones need to be skipped and empty buckets
-						 * should return end. */
-						if (bucket.is_empty())
-							break;
-						else if (bucket.is_tombstone())
-							continue;
-					}
-
-					if (bucket.hash != hash) [[likely]] /* If hashes don't match, keys are definitely different. */
-						continue;
-					else if (compare(key, bucket.key()))
-						return &bucket; /* Keys can still be different, but we expect the hash function to be good so if hashes match, keys are likely to match too. */
-				}
-			}
+			return pow2_bucket_policy::mix(h);
+		}
+		[[nodiscard]] constexpr static std::int8_t ctrl_hash(std::size_t m) noexcept
+		{
+			return static_cast<std::int8_t>(m & 0x7f);
+		}
 
-			return data + capacity;
+		/* Returns first empty or deleted bucket in the probe sequence of the (mixed) hash. */
+		[[nodiscard]] constexpr static size_type
+			find_available(const std::int8_t *ctrl, size_type cap, std::size_t m) noexcept
+		{
+			for (probe_seq seq{m >> 7, cap / group_type::size - 1};; seq.next())
+				if (const auto bits = group_type{ctrl + seq.offset()}.match_available(); bits != 0)
+					return seq.offset(static_cast<std::uint32_t>(std::countr_zero(bits)));
 		}
 
 	public:
@@ -320,17 +287,19 @@ namespace sek::detail
 			: value_ebo_base(alloc),
 			  bucket_ebo_base(bucket_allocator_type{alloc}),
 			  compare_ebo_base(key_compare),
-			  hash_ebo_base(key_hash)
+			  hash_ebo_base(key_hash),
+			  pool_ebo_base(make_pool(alloc))
 		{
 			if (capacity) [[likely]]
-				m_buckets_data = allocate_buckets(m_buckets_capacity = next_pow_2(capacity));
+				allocate_data(round_capacity(capacity));
 		}
 
 		constexpr sparse_hash_table(const sparse_hash_table &other)
 			: value_ebo_base(alloc_copy(other.get_allocator())),
 			  bucket_ebo_base(alloc_copy(other.get_bucket_allocator())),
 			  compare_ebo_base(other.get_comp()),
-			  hash_ebo_base(other.get_hash())
+			  hash_ebo_base(other.get_hash()),
+			  pool_ebo_base(make_pool(get_allocator()))
 		{
 			insert(other.begin(), other.end());
 		}
@@ -338,7 +307,8 @@ namespace sek::detail
 			: value_ebo_base(alloc),
 			  bucket_ebo_base(bucket_allocator_type{alloc}),
 			  compare_ebo_base(other.get_comp()),
-			  hash_ebo_base(other.get_hash())
+			  hash_ebo_base(other.get_hash()),
+			  pool_ebo_base(make_pool(get_allocator()))
 		{
 			insert(other.begin(), other.end());
 		}
@@ -347,7 +317,8 @@ namespace sek::detail
 			: value_ebo_base(alloc),
 			  bucket_ebo_base(std::move(other.get_bucket_allocator())),
 			  compare_ebo_base(std::move(other.get_comp())),
-			  hash_ebo_base(std::move(other.get_hash()))
+			  hash_ebo_base(std::move(other.get_hash())),
+			  pool_ebo_base(make_pool(get_allocator()))
 		{
 			if (alloc_eq(get_allocator(), other.get_allocator()))
 				take_data(std::move(other));
@@ -358,7 +329,8 @@ namespace sek::detail
 			: value_ebo_base(std::move(other.get_allocator())),
 			  bucket_ebo_base(std::move(other.get_bucket_allocator())),
 			  compare_ebo_base(std::move(other.get_comp())),
-			  hash_ebo_base(std::move(other.get_hash()))
+			  hash_ebo_base(std::move(other.get_hash())),
+			  pool_ebo_base(make_pool(get_allocator()))
 		{
 			take_data(std::move(other));
 		}
@@ -376,11 +348,7 @@ namespace sek::detail
 			return *this;
 		}
 
-		constexpr ~sparse_hash_table()
-		{
-			clear();
-			delete_buckets(m_buckets_data, m_buckets_capacity);
-		}
+		constexpr ~sparse_hash_table() { clear(); }
 
 		[[nodiscard]] constexpr iterator begin() noexcept { return iterator_from_bucket(buckets_start()); }
 		[[nodiscard]] constexpr iterator end() noexcept { return iterator_from_bucket(buckets_end()); }
@@ -405,98 +373,120 @@ namespace sek::detail
 
 		[[nodiscard]] constexpr iterator find(const auto &key) noexcept
 		{
-			return iterator_from_bucket(find_bucket<true>(key));
+			return iterator_from_bucket(m_buckets_data + find_bucket(key, get_hash()(key)));
 		}
 		[[nodiscard]] constexpr const_iterator find(const auto &key) const noexcept
 		{
-			return iterator_from_bucket(find_bucket<true>(key));
+			return iterator_from_bucket(m_buckets_data + find_bucket(key, get_hash()(key)));
 		}
 
 		constexpr void clear()
 		{
-			for (auto item = begin(), last = end(); item != last; ++item) erase_bucket_impl(item.m_bucket_ptr);
+			for (auto item = begin(), last = end(); item != last; ++item) destroy_value(*item.m_bucket_ptr);
 			destroy_data();
+
+			if constexpr (pooled) get_pool().release();
 		}
 
 		constexpr void rehash(size_type new_cap)
 		{
-			/* Adjust the capacity to be at least large enough to fit the current load count. */
-			new_cap = std::max(std::max(static_cast<size_type>(static_cast<float>(size()) / max_load_factor), new_cap),
-							   initial_capacity);
+			/* Adjust the capacity to be at least large enough to fit the current load count & an empty bucket. */
+			new_cap = std::max(static_cast<size_type>(static_cast<float>(size()) / max_load_factor) + 1, new_cap);
 
-			/* Quadratic search implementation requires power of 2 capacity, since the c1 and c2 constants are 0.5. */
-			new_cap = next_pow_2(new_cap);
+			/* Groups are probed via a triangular sequence, which requires power of 2 capacity. */
+			new_cap = round_capacity(new_cap);
 
 			/* Don't do anything if the capacity did not change after the adjustment. */
 			if (new_cap != m_buckets_capacity) [[likely]]
 				rehash_impl(new_cap);
 		}
 		constexpr void reserve(size_type n) { rehash(static_cast<size_type>(static_cast<float>(n) / max_load_factor)); }
+		constexpr void shrink_to_fit()
+		{
+			if (size() == 0) [[unlikely]]
+				clear();
+			else
+			{
+				rehash(0);
+				if constexpr (pooled) compact_nodes();
+			}
+		}
 
 		template<typename... Args>
 		constexpr std::pair<iterator, bool> emplace(Args &&...args)
 		{
 			maybe_rehash();
 
-			auto new_bucket = make_bucket(std::forward<Args>(args)...);
-			auto dest = find_bucket<false>(new_bucket.key(), new_bucket.hash);
-			auto inserted = insert_impl(dest, new_bucket);
-			return {iterator_from_bucket(dest), inserted};
+			const auto value = make_value(std::forward<Args>(args)...);
+			const auto h = get_hash()(key_extract(*value));
+			const auto dest = find_insert_bucket(key_extract(*value), h);
+			const auto inserted = insert_impl(dest, h, value);
+			return {iterator_from_bucket(m_buckets_data + dest), inserted};
 		}
 		template<typename... Args>
 		constexpr std::pair<iterator, bool> try_emplace(const auto &key, Args &&...args)
 		{
 			maybe_rehash();
 
-			auto dest = find_bucket<false>(key);
-			auto inserted = try_emplace_impl(
-				dest, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
-			return {iterator_from_bucket(dest), inserted};
+			const auto h = get_hash()(key);
+			const auto dest = find_insert_bucket(key, h);
+			const auto inserted = try_emplace_impl(dest,
+												   h,
+												   std::piecewise_construct,
+												   std::forward_as_tuple(key),
+												   std::forward_as_tuple(std::forward<Args>(args)...));
+			return {iterator_from_bucket(m_buckets_data + dest), inserted};
 		}
 		template<typename... Args>
 		constexpr std::pair<iterator, bool> try_emplace(key_type &&key, Args &&...args)
 		{
 			maybe_rehash();
 
-			auto dest = find_bucket<false>(key);
-			auto inserted = try_emplace_impl(dest,
-											 std::piecewise_construct,
-											 std::forward_as_tuple(std::forward<key_type>(key)),
-											 std::forward_as_tuple(std::forward<Args>(args)...));
-			return {iterator_from_bucket(dest), inserted};
+			const auto h = get_hash()(key);
+			const auto dest = find_insert_bucket(key, h);
+			const auto inserted = try_emplace_impl(dest,
+												   h,
+												   std::piecewise_construct,
+												   std::forward_as_tuple(std::forward<key_type>(key)),
+												   std::forward_as_tuple(std::forward<Args>(args)...));
+			return {iterator_from_bucket(m_buckets_data + dest), inserted};
 		}
 
 		constexpr std::pair<iterator, bool> insert(const value_type &value)
 		{
 			maybe_rehash();
 
-			auto dest = find_bucket<false>(key_extract(value));
-			auto inserted = insert_impl(dest, make_bucket(value));
-			return {iterator_from_bucket(dest), inserted};
+			const auto h = get_hash()(key_extract(value));
+			const auto dest = find_insert_bucket(key_extract(value), h);
+			const auto inserted = insert_impl(dest, h, make_value(value));
+			return {iterator_from_bucket(m_buckets_data + dest), inserted};
 		}
 		constexpr std::pair<iterator, bool> insert(value_type &&value)
 		{
 			maybe_rehash();
 
-			auto dest = find_bucket<false>(key_extract(value));
-			auto inserted = insert_impl(dest, make_bucket(std::forward<value_type>(value)));
-			return {iterator_from_bucket(dest), inserted};
+			const auto h = get_hash()(key_extract(value));
+			const auto dest = find_insert_bucket(key_extract(value), h);
+			const auto inserted = insert_impl(dest, h, make_value(std::forward<value_type>(value)));
+			return {iterator_from_bucket(m_buckets_data + dest), inserted};
 		}
 		constexpr std::pair<iterator, bool> try_insert(const value_type &value)
 		{
 			maybe_rehash();
 
-			auto dest = find_bucket<false>(key_extract(value));
-			auto inserted = try_emplace_impl(dest, value);
-			return {iterator_from_bucket(dest), inserted};
+			const auto h = get_hash()(key_extract(value));
+			const auto dest = find_insert_bucket(key_extract(value), h);
+			const auto inserted = try_emplace_impl(dest, h, value);
+			return {iterator_from_bucket(m_buckets_data + dest), inserted};
 		}
 		constexpr std::pair<iterator, bool> try_insert(value_type &&value)
 		{
 			maybe_rehash();
 
-			auto dest = find_bucket<false>(key_extract(value));
-			auto inserted = try_emplace_impl(dest, std::forward<value_type>(value));
-			return {iterator_from_bucket(dest), inserted};
+			const auto h = get_hash()(key_extract(value));
+			const auto dest = find_insert_bucket(key_extract(value), h);
+			const auto inserted = try_emplace_impl(dest, h, std::forward<value_type>(value));
+			return {iterator_from_bucket(m_buckets_data + dest), inserted};
 		}
 
 		template<std::forward_iterator Iter>
@@ -530,46 +520,70 @@ namespace sek::detail
 		[[nodiscard]] constexpr node_handle extract_node(const_iterator where)
 		{
 			SEK_ASSERT(where >= begin() && where < end());
-			SEK_ASSERT(where.m_bucket_ptr->is_occupied());
+			SEK_ASSERT(*where.m_bucket_ptr != nullptr);
 
-			erase_aux(1);
-			return node_handle{*where.m_bucket_ptr, get_allocator()};
+			const auto value = *where.m_bucket_ptr;
+			erase_bucket_impl(bucket_index(where));
+			return node_handle{value, get_allocator()};
 		}
 		constexpr std::pair<iterator, bool> insert_node(node_handle &&handle)
 		{
+			if (handle.empty()) [[unlikely]]
+				return {end(), false};
+
 			maybe_rehash();
 
-			auto dest = find_bucket<false>(handle.m_bucket.key(), handle.m_bucket.hash);
-			auto inserted = insert_impl(dest, handle.reset());
-			return {iterator_from_bucket(dest), inserted};
+			const auto h = get_hash()(key_extract(handle.value()));
+			const auto dest = find_insert_bucket(key_extract(handle.value()), h);
+			const auto inserted = insert_impl(dest, h, adopt_node(handle));
+			return {iterator_from_bucket(m_buckets_data + dest), inserted};
 		}
 		constexpr std::pair<iterator, bool> try_insert_node(node_handle &&handle)
 		{
+			if (handle.empty()) [[unlikely]]
+				return {end(), false};
+
 			maybe_rehash();
 
-			if (auto dest = find_bucket<false>(handle.m_bucket.key(), handle.m_bucket.hash); dest->is_occupied())
-				return {iterator_from_bucket(dest), false};
-			else
-			{
-				insert_aux(dest);
-				*dest = handle.reset();
-				return {iterator_from_bucket(dest), true};
-			}
+			const auto h = get_hash()(key_extract(handle.value()));
+			const auto dest = find_insert_bucket(key_extract(handle.value()), h);
+			if (m_buckets_data[dest] != nullptr) return {iterator_from_bucket(m_buckets_data + dest), false};
+
+			insert_aux(dest, h, adopt_node(handle));
+			return {iterator_from_bucket(m_buckets_data + dest), true};
 		}
 
 		constexpr iterator erase(const_iterator where)
 		{
-			erase_bucket_impl(where.m_bucket_ptr);
-			erase_aux(1);
+			destroy_value(*where.m_bucket_ptr);
+			erase_bucket_impl(bucket_index(where));
 			return iterator_from_bucket(where.m_bucket_ptr);
 		}
 		constexpr iterator erase(const_iterator first, const_iterator last)
 		{
-			size_type amount = 0;
-			for (; first < last; ++first, ++amount) erase_bucket_impl(first.m_bucket_ptr);
-			erase_aux(amount);
+			for (; first < last; ++first)
+			{
+				destroy_value(*first.m_bucket_ptr);
+				erase_bucket_impl(bucket_index(first));
+			}
 			return iterator_from_bucket(first.m_bucket_ptr);
 		}
+		template<typename P>
+		constexpr size_type erase_if(P &&pred)
+		{
+			/* Erase all matching buckets in a single pass, then get rid of the tombstones at once if needed. */
+			size_type amount = 0;
+			for (auto item = begin(), last = end(); item != last; ++item)
+				if (pred(*item))
+				{
+					destroy_value(*item.m_bucket_ptr);
+					erase_bucket_impl(bucket_index(item));
+					++amount;
+				}
+
+			if (amount != 0 && tombstone_factor() > max_tombstone_factor) rehash_impl(m_buckets_capacity);
+			return amount;
+		}
 
 		[[nodiscard]] constexpr auto load_factor() const noexcept
 		{
@@ -593,6 +607,7 @@ namespace sek::detail
 
 		[[nodiscard]] constexpr const key_equal &get_comp() const noexcept { return *compare_ebo_base::get(); }
 		[[nodiscard]] constexpr const hash_type &get_hash() const noexcept { return *hash_ebo_base::get(); }
+		[[nodiscard]] constexpr pool_type &get_pool() noexcept { return *pool_ebo_base::get(); }
 
 		constexpr void swap(sparse_hash_table &other) noexcept
 		{
@@ -610,8 +625,18 @@ namespace sek::detail
 		float max_tombstone_factor = initial_tombstone_factor;
 
 	private:
+		[[nodiscard]] constexpr static pool_ebo_base make_pool(const allocator_type &alloc) noexcept
+		{
+			if constexpr (pooled)
+				return pool_ebo_base{pool_type{alloc}};
+			else
+				return pool_ebo_base{};
+		}
+
 		constexpr void take_data(sparse_hash_table &&other) noexcept
 		{
+			pool_ebo_base::swap(other);
+			m_ctrl_data = std::exchange(other.m_ctrl_data, nullptr);
 			m_buckets_data = std::exchange(other.m_buckets_data, nullptr);
 			m_buckets_capacity = std::exchange(other.m_buckets_capacity, 0);
 			m_load_count = std::exchange(other.m_load_count, 0);
@@ -622,8 +647,10 @@ namespace sek::detail
 		{
 			compare_ebo_base::swap(other);
 			hash_ebo_base::swap(other);
+			pool_ebo_base::swap(other);
 
 			using std::swap;
+			swap(m_ctrl_data, other.m_ctrl_data);
 			swap(m_buckets_data, other.m_buckets_data);
 			swap(m_buckets_capacity, other.m_buckets_capacity);
 			swap(m_load_count, other.m_load_count);
@@ -670,7 +697,6 @@ namespace sek::detail
 						  bucket_alloc_traits::propagate_on_container_copy_assignment::value ||
 						  !bucket_alloc_traits::is_always_equal::value)
 			{
-				destroy_data();
 				alloc_copy_assign(get_allocator(), other.get_allocator());
 				alloc_copy_assign(get_bucket_allocator(), other.get_bucket_allocator());
 			}
@@ -692,139 +718,250 @@ namespace sek::detail
 		{
 			return m_buckets_data + m_buckets_capacity;
 		}
-
-		constexpr bucket_type *allocate_buckets(size_type capacity)
+		template<bool IsConst>
+		[[nodiscard]] constexpr size_type bucket_index(sparse_table_iterator<IsConst> iter) const noexcept
 		{
-			auto data = get_bucket_allocator().allocate(capacity);
-			std::fill_n(data, capacity, bucket_type{});
-			return data;
+			return static_cast<size_type>(iter.m_bucket_ptr - m_buckets_data);
 		}
-		constexpr void delete_buckets(bucket_type *data, size_type capacity)
+
+		constexpr void allocate_data(size_type capacity)
 		{
-			get_bucket_allocator().deallocate(data, capacity);
+			/* Control bytes are allocated first, so that the table is left intact if any allocation fails. */
+			ctrl_allocator_type ctrl_alloc{get_bucket_allocator()};
+			auto ctrl = ctrl_alloc.allocate(capacity);
+			try
+			{
+				m_buckets_data = get_bucket_allocator().allocate(capacity);
+			}
+			catch (...)
+			{
+				ctrl_alloc.deallocate(ctrl, capacity);
+				throw;
+			}
+			std::fill_n(m_ctrl_data = ctrl, capacity, group_type::empty);
+			std::fill_n(m_buckets_data, m_buckets_capacity = capacity, nullptr);
 		}
 		constexpr void destroy_data()
 		{
-			delete_buckets(std::exchange(m_buckets_data, nullptr), std::exchange(m_buckets_capacity, 0));
+			if (m_buckets_data) [[likely]]
+			{
+				ctrl_allocator_type{get_bucket_allocator()}.deallocate(m_ctrl_data, m_buckets_capacity);
+				get_bucket_allocator().deallocate(m_buckets_data, m_buckets_capacity);
+			}
+			m_ctrl_data = nullptr;
+			m_buckets_data = nullptr;
+			m_buckets_capacity = 0;
 			m_consider_shrink = false;
 			m_load_count = 0;
 			m_tombstone_count = 0;
 		}
 
-		template<bool RequireOccupied = true>
-		[[nodiscard]] constexpr bucket_type *find_bucket(const auto &key) const noexcept
+		/* Returns index of the bucket containing the specified key, or bucket count if no such bucket exists. */
+		[[nodiscard]] constexpr size_type find_bucket(const auto &key, std::size_t h) const noexcept
 		{
-			return find_bucket<RequireOccupied>(key, get_hash()(key));
+			if (m_buckets_capacity == 0) [[unlikely]] /* Initially, capacity is 0, so need to check. */
+				return 0;
+
+			const auto m = mix_hash(h);
+			for (probe_seq seq{m >> 7, m_buckets_capacity / group_type::size - 1};; seq.next())
+			{
+				/* Only buckets with a matching control byte are de-referenced. */
+				const group_type group{m_ctrl_data + seq.offset()};
+				for (auto bits = group.match(ctrl_hash(m)); bits != 0; bits &= bits - 1)
+					if (const auto idx = seq.offset(static_cast<std::uint32_t>(std::countr_zero(bits)));
+						get_comp()(key, key_extract(*m_buckets_data[idx]))) [[likely]]
+						return idx;
+				if (group.match_empty() != 0) [[likely]]
+					return m_buckets_capacity;
+			}
 		}
-		template<bool RequireOccupied = true>
-		[[nodiscard]] constexpr bucket_type *find_bucket(const auto &key, auto hash) const noexcept
+		/* Returns index of the bucket containing the specified key, or first available bucket of its probe sequence. */
+		[[nodiscard]] constexpr size_type find_insert_bucket(const auto &key, std::size_t h) const noexcept
 		{
-			return find_bucket_impl<RequireOccupied>(m_buckets_data, m_buckets_capacity, key, hash, get_comp());
+			if (const auto idx = find_bucket(key, h); idx != m_buckets_capacity) return idx;
+			return find_available(m_ctrl_data, m_buckets_capacity, mix_hash(h));
 		}
 
 		constexpr void rehash_impl(size_type new_cap)
 		{
+			SEK_ASSERT(new_cap > size(), "Re-hashed table must have at least one empty bucket");
+
+			/* Allocate new arrays, move all current elements to the new arrays, then destroy the current ones. */
+			auto old_ctrl = m_ctrl_data;
+			auto old_data = m_buckets_data;
+			auto old_cap = m_buckets_capacity;
+			allocate_data(new_cap);
+
 			/* Reset tombstones & shrink flag since the new bucket list will have no tombstones. */
 			m_tombstone_count = 0;
 			m_consider_shrink = false;
 
-			/* Allocate new array, move all current elements to the new array, then destroy the current one. */
-			auto new_data = allocate_buckets(new_cap);
-			if (m_buckets_data) [[likely]]
+			if (old_data) [[likely]]
 			{
-				auto src_begin = begin(), src_end = end();
-				for (; src_begin != src_end; ++src_begin)
-					if (auto *src = src_begin.m_bucket_ptr; src->is_occupied()) [[likely]]
+				/* Hashes are not stored, thus need to be re-calculated. */
+				for (auto src = old_data, src_end = old_data + old_cap; src != src_end; ++src)
+					if (const auto value = *src; value != nullptr) [[likely]]
 					{
-						auto dest = find_bucket_impl<false>(new_data, new_cap, src->key(), src->hash, get_comp());
-						*dest = std::move(*src);
+						const auto m = mix_hash(get_hash()(key_extract(*value)));
+						const auto dest = find_available(m_ctrl_data, new_cap, m);
+						m_ctrl_data[dest] = ctrl_hash(m);
+						m_buckets_data[dest] = value;
 					}
 
-				/* It is safe to deallocate the current node array, since all
-				 * pointers should be transferred by now. */
-				delete_buckets(m_buckets_data, m_buckets_capacity);
+				/* It is safe to deallocate the old arrays, since all pointers should be transferred by now. */
+				ctrl_allocator_type{get_bucket_allocator()}.deallocate(old_ctrl, old_cap);
+				get_bucket_allocator().deallocate(old_data, old_cap);
 			}
-			m_buckets_data = new_data;
-			m_buckets_capacity = new_cap;
 		}
 		constexpr void maybe_rehash()
 		{
+			/* At least 1 bucket must always remain empty, otherwise probing would never terminate. */
 			if (!m_buckets_capacity) [[unlikely]]
-				m_buckets_data = allocate_buckets(m_buckets_capacity = initial_capacity);
-			else if (load_factor() > max_load_factor)
+				allocate_data(initial_capacity);
+			else if (load_factor() > max_load_factor || size() + 2 > m_buckets_capacity)
 				rehash_impl(m_buckets_capacity * 2);
-			else if (m_consider_shrink && tombstone_factor() > max_tombstone_factor)
-				rehash_impl(next_pow_2(static_cast<size_type>(static_cast<float>(size()) / max_load_factor)));
+			else if ((m_consider_shrink && tombstone_factor() > max_tombstone_factor) ||
+					 size() + m_tombstone_count + 2 > m_buckets_capacity)
+			{
+				auto new_cap = round_capacity(static_cast<size_type>(static_cast<float>(size()) / max_load_factor) + 1);
+				rehash_impl(new_cap < size() + 2 ? new_cap * 2 : new_cap);
+			}
 		}
 
-		template<typename... Args>
-		constexpr bucket_type make_bucket(Args &&...args)
+		constexpr value_type *allocate_node()
 		{
-			auto &alloc = get_allocator();
-			auto *value = alloc.allocate(1);
-			alloc_traits::construct(alloc, value, std::forward<Args>(args)...);
-			auto hash = get_hash()(key_extract(*value));
-
-			return bucket_type{value, hash};
+			if constexpr (pooled)
+				return get_pool().allocate();
+			else
+				return get_allocator().allocate(1);
 		}
-		constexpr void reset_bucket(bucket_type *bucket)
+		constexpr void deallocate_node(value_type *node)
 		{
-			if (bucket->is_occupied()) [[likely]]
+			if constexpr (pooled)
+				get_pool().deallocate(node);
+			else
+				get_allocator().deallocate(node, 1);
+		}
+
+		template<typename... Args>
+		constexpr value_type *make_value(Args &&...args)
+		{
+			auto *value = allocate_node();
+			try
 			{
-				std::destroy_at(bucket->data);
-				get_allocator().deallocate(bucket->data, 1);
+				alloc_traits::construct(get_allocator(), value, std::forward<Args>(args)...);
 			}
+			catch (...)
+			{
+				deallocate_node(value);
+				throw;
+			}
+			return value;
+		}
+		constexpr void destroy_value(value_type *value)
+		{
+			std::destroy_at(value);
+			deallocate_node(value);
 		}
 
-		constexpr void insert_aux(bucket_type *dest)
+		/* Nodes of pooled tables can only be re-used by the table owning them, values of other nodes are moved. */
+		constexpr value_type *adopt_node(node_handle &handle)
+		{
+			if constexpr (pooled)
+				if (!get_pool().owns(handle.m_value)) [[unlikely]]
+				{
+					const auto value = make_value(std::move(handle.value()));
+					handle.destroy();
+					handle.reset();
+					return value;
+				}
+			return handle.reset();
+		}
+		/* Moves all values into a single page of a new pool, in iteration order. */
+		constexpr void compact_nodes()
+		{
+			pool_type new_pool{get_allocator()};
+			new_pool.make_page(size());
+
+			for (auto bucket = buckets_start(), last = buckets_end(); bucket != last; ++bucket)
+				if (auto &value = *bucket; value != nullptr)
+				{
+					auto *node = new_pool.allocate();
+					try
+					{
+						alloc_traits::construct(get_allocator(), node, std::move_if_noexcept(*value));
+					}
+					catch (...)
+					{
+						/* Values are split between both pools, thus the old pool needs to own the new pages. */
+						get_pool().splice(new_pool);
+						throw;
+					}
+					std::destroy_at(value);
+					value = node;
+				}
+
+			/* All values are transferred, old pages are released by `new_pool`. */
+			get_pool().swap(new_pool);
+		}
+
+		constexpr void insert_aux(size_type idx, std::size_t h, value_type *value) noexcept
 		{
 			m_load_count++;
-			if (dest->is_tombstone()) [[unlikely]]
+			if (m_ctrl_data[idx] == group_type::deleted) [[unlikely]]
 				m_tombstone_count--;
+
+			m_ctrl_data[idx] = ctrl_hash(mix_hash(h));
+			m_buckets_data[idx] = value;
 		}
-		constexpr bool insert_impl(bucket_type *dest_bucket, bucket_type new_bucket)
+		constexpr bool insert_impl(size_type idx, std::size_t h, value_type *value)
 		{
-			SEK_ASSERT(dest_bucket >= buckets_start() && dest_bucket < buckets_end());
+			SEK_ASSERT(idx < m_buckets_capacity);
 
-			bool inserted_new = !dest_bucket->is_occupied();
-			if (inserted_new)
-				insert_aux(dest_bucket);
-			else
-				reset_bucket(dest_bucket);
+			if (auto &bucket = m_buckets_data[idx]; bucket != nullptr)
+			{
+				destroy_value(bucket);
+				bucket = value;
+				return false;
+			}
 
-			*dest_bucket = new_bucket;
-			return inserted_new;
+			insert_aux(idx, h, value);
+			return true;
 		}
 		template<typename... Args>
-		constexpr bool try_emplace_impl(bucket_type *dest_bucket, Args &&...args)
+		constexpr bool try_emplace_impl(size_type idx, std::size_t h, Args &&...args)
 		{
-			SEK_ASSERT(dest_bucket >= buckets_start() && dest_bucket < buckets_end());
+			SEK_ASSERT(idx < m_buckets_capacity);
 
-			if (dest_bucket->is_occupied())
-				return false;
+			if (m_buckets_data[idx] != nullptr) return false;
+
+			insert_aux(idx, h, make_value(std::forward<Args>(args)...));
+			return true;
+		}
+
+		constexpr void erase_bucket_impl(size_type idx) noexcept
+		{
+			SEK_ASSERT(idx < m_buckets_capacity);
+			SEK_ASSERT(m_buckets_data[idx] != nullptr);
+
+			/* If the group already has an empty bucket, no probe sequence could have continued past it,
+			 * thus the bucket can be marked empty. Otherwise, mark it deleted. */
+			const auto group_offset = idx - idx % group_type::size;
+			if (group_type{m_ctrl_data + group_offset}.match_empty() != 0)
+				m_ctrl_data[idx] = group_type::empty;
 			else
 			{
-				insert_aux(dest_bucket);
-				*dest_bucket = make_bucket(std::forward<Args>(args)...);
-				return true;
+				m_ctrl_data[idx] = group_type::deleted;
+				m_tombstone_count++;
 			}
-		}
+			m_buckets_data[idx] = nullptr;
 
-		constexpr void erase_aux(size_type amount)
-		{
-			m_load_count -= amount;
-			m_tombstone_count += amount;
+			m_load_count--;
 			m_consider_shrink = true;
 		}
-		constexpr void erase_bucket_impl(bucket_type *bucket)
-		{
-			SEK_ASSERT(bucket >= buckets_start() && bucket < buckets_end());
-			SEK_ASSERT(bucket->is_occupied());
-
-			reset_bucket(bucket);
-			bucket->set_tombstone();
-		}
 
+		/** Pointer to the control byte array. */
+		std::int8_t *m_ctrl_data = nullptr;
 		/** Pointer to the bucket array. */
 		bucket_type *m_buckets_data = nullptr;
 		/** Total amount of buckets in the node array. */
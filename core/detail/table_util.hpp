@@ -4,8 +4,16 @@
 
 #pragma once
 
+#include <bit>
+#include <cstdint>
 #include <utility>
 
+#include "arch.h"
+
+#if !defined(__clang__) && !defined(__GNUC__) && defined(SEK_ARCH_x86)
+#include <xmmintrin.h>
+#endif
+
 namespace sek
 {
 	/** @brief Forwards the passed argument. */
@@ -27,4 +35,171 @@ namespace sek
 			return value.first;
 		}
 	};
+
+	/** @brief Bucket policy which maps hashes to buckets via modulo of the bucket count.
+	 * Bucket count is not rounded, at the cost of an integer division for every bucket lookup. */
+	struct modulo_bucket_policy
+	{
+		/** Rounds the requested bucket count to a bucket count supported by the policy. */
+		[[nodiscard]] constexpr static std::size_t round_count(std::size_t n) noexcept { return n; }
+		/** Returns index of the bucket for the hash. */
+		[[nodiscard]] constexpr static std::size_t index(std::size_t h, std::size_t n) noexcept { return h % n; }
+	};
+	/** @brief Bucket policy which keeps bucket counts at powers of 2 and maps hashes to buckets via a bit mask.
+	 * Hashes are mixed via fibonacci hashing before masking, thus weak hashes (ex. identity hashes of integers)
+	 * are still spread across buckets. */
+	struct pow2_bucket_policy
+	{
+		/** Mixes bits of the hash, so that every bit of the result depends on upper bits of the hash. */
+		[[nodiscard]] constexpr static std::size_t mix(std::size_t h) noexcept
+		{
+			const auto m = static_cast<std::uint64_t>(h) * 0x9e3779b97f4a7c15;
+			return static_cast<std::size_t>(m ^ (m >> 32));
+		}
+
+		/** @copydoc modulo_bucket_policy::round_count */
+		[[nodiscard]] constexpr static std::size_t round_count(std::size_t n) noexcept { return std::bit_ceil(n); }
+		/** @copydoc modulo_bucket_policy::index */
+		[[nodiscard]] constexpr static std::size_t index(std::size_t h, std::size_t n) noexcept
+		{
+			return mix(h) & (n - 1);
+		}
+	};
+
+	struct default_hash;
+
+	/** @brief Hasher adaptor which selects compact entry storage for dense hash tables.
+	 *
+	 * Tables using a compact hasher store 32-bit bucket chain indices (thus can contain at most `2^32 - 2` elements)
+	 * and do not cache hashes of their entries, re-hashing keys whenever the hash is needed instead. This reduces
+	 * per-element memory overhead from 16 to 4 bytes on 64-bit platforms, and is beneficial for small keys which are
+	 * cheap to hash & compare (ex. integer ids).
+	 *
+	 * @tparam Hash Underlying hasher. */
+	template<typename Hash = default_hash>
+	struct compact_hash : Hash
+	{
+		/** Type of bucket chain indices. */
+		typedef std::uint32_t table_index_type;
+		/** Hashes of table entries are not cached. */
+		constexpr static bool table_cache_hash = false;
+
+		using Hash::Hash;
+		constexpr compact_hash() = default;
+		constexpr compact_hash(const Hash &hash) : Hash(hash) {}
+	};
+	/** @brief Hasher adaptor which selects tombstone erasure for dense hash tables.
+	 *
+	 * Tables using tombstone erasure do not move elements on erasure. Instead, erased elements are left as holes
+	 * which are skipped by iterators & re-used by subsequent insertions. Holes are removed by an explicit call to
+	 * `compact` or `rehash`. As such, erasure does not invalidate iterators to other elements, at the cost of
+	 * iterators being bidirectional instead of random-access.
+	 *
+	 * @tparam Hash Underlying hasher. */
+	template<typename Hash = default_hash>
+	struct tombstone_hash : Hash
+	{
+		/** Erased entries are left as holes. */
+		constexpr static bool table_tombstones = true;
+
+		using Hash::Hash;
+		constexpr tombstone_hash() = default;
+		constexpr tombstone_hash(const Hash &hash) : Hash(hash) {}
+	};
+	/** @brief Hasher adaptor which selects pooled node allocation for sparse hash tables.
+	 *
+	 * Tables using pooled nodes allocate their values from pages of an internal pool instead of allocating every value
+	 * individually. Nodes of erased values are re-used by subsequent insertions, and `shrink_to_fit` compacts values
+	 * into a single contiguous page in iteration order. Node handles extracted from a pooled table must not outlive
+	 * the table, and are invalidated by `clear` & `shrink_to_fit`.
+	 *
+	 * @tparam Hash Underlying hasher. */
+	template<typename Hash = default_hash>
+	struct pooled_hash : Hash
+	{
+		/** Values are allocated from a node pool. */
+		constexpr static bool table_node_pool = true;
+
+		using Hash::Hash;
+		constexpr pooled_hash() = default;
+		constexpr pooled_hash(const Hash &hash) : Hash(hash) {}
+	};
+
+	namespace detail
+	{
+		/* Hints the CPU to fetch the cache line containing `ptr`, so that batched table operations can overlap
+		 * cache misses of multiple lookups. */
+		inline void table_prefetch(const void *ptr) noexcept
+		{
+#if defined(__clang__) || defined(__GNUC__)
+			__builtin_prefetch(ptr);
+#elif defined(SEK_ARCH_x86)
+			_mm_prefetch(static_cast<const char *>(ptr), _MM_HINT_T0);
+#else
+			static_cast<void>(ptr);
+#endif
+		}
+
+		template<typename Hash>
+		struct table_bucket_policy
+		{
+			using type = pow2_bucket_policy;
+		};
+		template<typename Hash>
+			requires requires { typename Hash::bucket_policy; }
+		struct table_bucket_policy<Hash>
+		{
+			using type = typename Hash::bucket_policy;
+		};
+
+		/* Hash tables use `pow2_bucket_policy` by default. A different policy (ex. `modulo_bucket_policy`)
+		 * can be selected by defining a `bucket_policy` member type of the hasher. */
+		template<typename Hash>
+		using table_bucket_policy_t = typename table_bucket_policy<Hash>::type;
+
+		template<typename Hash>
+		struct table_index
+		{
+			using type = std::size_t;
+		};
+		template<typename Hash>
+			requires requires { typename Hash::table_index_type; }
+		struct table_index<Hash>
+		{
+			using type = typename Hash::table_index_type;
+		};
+
+		/* Dense hash tables use `std::size_t` chain indices, cache entry hashes & move elements on erasure by default.
+		 * Compact storage can be selected by defining a `table_index_type` member type and a `table_cache_hash`
+		 * constant of the hasher, while tombstone erasure is selected via a `table_tombstones` constant. */
+		template<typename Hash>
+		using table_index_t = typename table_index<Hash>::type;
+		template<typename Hash>
+		constexpr bool table_cache_hash_v = []()
+		{
+			if constexpr (requires { Hash::table_cache_hash; })
+				return static_cast<bool>(Hash::table_cache_hash);
+			else
+				return true;
+		}();
+		template<typename Hash>
+		constexpr bool table_tombstones_v = []()
+		{
+			if constexpr (requires { Hash::table_tombstones; })
+				return static_cast<bool>(Hash::table_tombstones);
+			else
+				return false;
+		}();
+
+		/* Sparse hash tables allocate every value individually by default. Pooled allocation is selected
+		 * via a `table_node_pool` constant of the hasher. */
+		template<typename Hash>
+		constexpr bool table_node_pool_v = []()
+		{
+			if constexpr (requires { Hash::table_node_pool; })
+				return static_cast<bool>(Hash::table_node_pool);
+			else
+				return false;
+		}();
+	}	 // namespace detail
 }
\ No newline at end of file
@@ -4,8 +4,28 @@
 
 #include "../thread_pool.hpp"
 
+#include <algorithm>
+#include <bit>
+
 #include "../assert.hpp"
 #include "../logger.hpp"
+#include "basic_pool.hpp"
+
+#if defined(SEK_ARCH_x86)
+#include <immintrin.h>
+#endif
+
+#if defined(SEK_OS_LINUX)
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 namespace sek
 {
@@ -14,23 +34,223 @@ namespace sek
 		if (!n && !(n = std::thread::hardware_concurrency())) [[unlikely]]
 			throw std::runtime_error("`std::thread::hardware_concurrency` returned 0");
 	}
+	static void cpu_relax() noexcept
+	{
+#if defined(SEK_ARCH_x86)
+		_mm_pause();
+#elif defined(SEK_ARCH_ARM) && (defined(__GNUC__) || defined(__clang__))
+		__asm__ __volatile__("yield");
+#endif
+	}
+
+#if defined(SEK_OS_LINUX)
+	/* CPUs available to the process, grouped by NUMA node. */
+	struct cpu_topology
+	{
+		static const cpu_topology &instance()
+		{
+			static const cpu_topology value;
+			return value;
+		}
+
+		/* Parses a sysfs CPU list (ex. `0-3,8-11`). */
+		static std::vector<int> parse_cpu_list(std::istream &is)
+		{
+			std::vector<int> result;
+			for (int first; is >> first;)
+			{
+				int last = first;
+				if (is.peek() == '-') is.ignore() >> last;
+				for (auto cpu = first; cpu <= last; ++cpu) result.push_back(cpu);
+				if (is.peek() == ',') is.ignore();
+			}
+			return result;
+		}
+
+		cpu_topology()
+		{
+			CPU_ZERO(&process_set);
+			if (sched_getaffinity(0, sizeof(process_set), &process_set) != 0) [[unlikely]]
+				return;
+
+			/* Nodes may be numbered sparsely, thus node directories are sorted by node id. */
+			std::vector<std::pair<int, std::filesystem::path>> node_dirs;
+			std::error_code err;
+			for (std::filesystem::directory_iterator iter{"/sys/devices/system/node", err}, end; !err && iter != end;
+				 iter.increment(err))
+			{
+				const auto name = iter->path().filename().string();
+				if (name.size() > 4 && name.starts_with("node") && std::isdigit(static_cast<unsigned char>(name[4])))
+					node_dirs.emplace_back(std::atoi(name.c_str() + 4), iter->path());
+			}
+			std::sort(node_dirs.begin(), node_dirs.end());
+
+			for (auto &dir : node_dirs)
+			{
+				std::ifstream file{dir.second / "cpulist"};
+				auto cpus = parse_cpu_list(file);
+				std::erase_if(cpus, [&](int cpu) { return cpu >= CPU_SETSIZE || !CPU_ISSET(cpu, &process_set); });
+				if (!cpus.empty()) nodes.push_back(std::move(cpus));
+			}
+
+			/* If NUMA information is not available, treat all CPUs as a single node. */
+			if (nodes.empty())
+			{
+				auto &cpus = nodes.emplace_back();
+				for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+					if (CPU_ISSET(cpu, &process_set)) cpus.push_back(cpu);
+				if (cpus.empty()) nodes.clear();
+			}
+		}
+
+		cpu_set_t process_set;
+		std::vector<std::vector<int>> nodes;
+	};
+#endif
 
-	thread_pool::control_block::control_block(std::size_t n, thread_pool::queue_mode mode) : dispatch_mode(mode)
+	/* Task blocks are allocated from a per-thread slab. Blocks freed by other threads are returned to the
+	 * owning slab via a lock-free list. Slabs are reference-counted by the owner thread & every allocated
+	 * block, which allows in-flight tasks & futures to outlive the thread that has allocated them. */
+	struct thread_pool::task_slab
+	{
+		struct block_t
+		{
+			union
+			{
+				task_slab *slab;
+				block_t *next; /* Used by the remote free list. */
+			};
+			alignas(std::max_align_t) std::byte data[task_block_size];
+		};
+		struct handle_t
+		{
+			~handle_t()
+			{
+				if (slab != nullptr) slab->release();
+			}
+
+			task_slab *get()
+			{
+				if (slab == nullptr) [[unlikely]]
+					slab = new task_slab();
+				return slab;
+			}
+
+			task_slab *slab = nullptr;
+		};
+
+		static handle_t &local() noexcept
+		{
+			static thread_local handle_t handle;
+			return handle;
+		}
+
+		void release() noexcept
+		{
+			if (ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1) [[unlikely]]
+				delete this;
+		}
+
+		block_t *allocate()
+		{
+			/* If there are no free local blocks, reclaim blocks released by other threads. */
+			if (pool.m_next_free == nullptr)
+				for (auto block = remote_free.exchange(nullptr, std::memory_order_acquire); block != nullptr;)
+					pool.deallocate(std::exchange(block, block->next));
+
+			const auto result = pool.allocate();
+			ref_count.fetch_add(1, std::memory_order_relaxed);
+			result->slab = this;
+			return result;
+		}
+		void deallocate_local(block_t *block) noexcept
+		{
+			pool.deallocate(block);
+			ref_count.fetch_sub(1, std::memory_order_relaxed);
+		}
+		void deallocate_remote(block_t *block) noexcept
+		{
+			block->next = remote_free.load(std::memory_order_relaxed);
+			while (!remote_free.compare_exchange_weak(block->next, block, std::memory_order_release, std::memory_order_relaxed))
+				;
+			release();
+		}
+
+		detail::basic_pool<block_t> pool;
+		std::atomic<block_t *> remote_free = nullptr;
+		std::atomic<std::size_t> ref_count = 1;
+	};
+
+	void *thread_pool::allocate_task_block() { return task_slab::local().get()->allocate()->data; }
+	void thread_pool::deallocate_task_block(void *ptr) noexcept
+	{
+		using block_t = task_slab::block_t;
+		const auto block = std::bit_cast<block_t *>(static_cast<std::byte *>(ptr) - offsetof(block_t, data));
+		if (const auto slab = block->slab; slab == task_slab::local().slab)
+			slab->deallocate_local(block);
+		else
+			slab->deallocate_remote(block);
+	}
+	void thread_pool::unhandled_exception() noexcept
+	{
+		try
+		{
+			throw;
+		}
+		catch (std::exception &e)
+		{
+			logger::error()->log(fmt::format("Unhandled exception in thread pool task: {}", e.what()));
+		}
+		catch (...)
+		{
+			logger::error()->log("Unhandled exception in thread pool task");
+		}
+	}
+
+	/* Context of the current worker thread, used to push tasks to the local deque. */
+	struct worker_context
+	{
+		const void *cb = nullptr;
+		void *queue = nullptr;
+	};
+	static thread_local worker_context this_worker;
+
+	thread_pool::control_block::control_block(std::size_t n, thread_pool::queue_mode mode, const worker_config &config)
+		: spin_count(config.spin_count),
+		  yield_count(config.yield_count),
+		  affinity(config.affinity),
+		  measure_time(config.measure_time),
+		  begin_hook(config.on_task_begin),
+		  end_hook(config.on_task_end),
+		  dispatch_mode(mode)
 	{
 		adjust_worker_count(n);
 
 		/* Initialize n workers. */
 		realloc_workers(n);
-		// clang-format off
-		for (auto begin = workers_data, end = workers_data + n; begin != end; ++begin)
-			std::construct_at(begin, this);
-		// clang-format on
-		workers_count = n;
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			std::construct_at(workers_data + i, this);
+			workers_count = i + 1;
+			if (affinity != affinity_mode::none) pin_worker(workers_data[i], i);
+		}
 	}
 	thread_pool::control_block::~control_block()
 	{
-		for (auto task = queue_head.front, end = queue_head.back; task != end;)
-			delete static_cast<task_base *>(std::exchange(task, task->next));	 // NOLINT
+		/* Discarded coroutines are resumed & may queue more tasks, thus repeat until all queues are empty.
+		 * Workers should be terminated by now, any tasks left in worker deques are leftovers of detached workers. */
+		for (bool discarded = true; discarded;)
+		{
+			discarded = false;
+			for (auto &lane : lanes)
+				for (auto list : {&lane.queue, &lane.deadlines})
+					for (; list->front != list; discarded = true)
+						static_cast<task_base *>(list->front->unlink())->discard(); // NOLINT
+			for (auto queue = queues_head.load(std::memory_order_acquire); queue != nullptr; queue = queue->next)
+				for (; auto task = queue->pop(); discarded = true) task->discard();
+		}
+		for (auto queue = queues_head.load(std::memory_order_acquire); queue != nullptr;)
+			delete std::exchange(queue, queue->next);
 
 		/* Workers should be terminated by now, no need to destroy them again. */
 		::operator delete[](static_cast<void *>(workers_data), workers_capacity * sizeof(worker_t));
@@ -38,7 +258,11 @@ namespace sek
 
 	void thread_pool::control_block::destroy_workers(worker_t *first, worker_t *last)
 	{
-		std::destroy(first, last);
+		{
+			/* Stop requests must be synchronized with waiting workers to avoid missed wake-ups. */
+			std::lock_guard<std::mutex> l(mtx);
+			std::destroy(first, last);
+		}
 		cv.notify_all();
 	}
 	void thread_pool::control_block::realloc_workers(std::size_t n)
@@ -51,13 +275,58 @@ namespace sek
 				std::construct_at(dst, std::move(*src));
 				std::destroy_at(src);
 			}
-			::operator delete[](static_cast<void *>(workers_data), n * sizeof(worker_t));
+			::operator delete[](static_cast<void *>(workers_data), workers_capacity * sizeof(worker_t));
 		}
 
 		workers_data = new_workers;
 		workers_capacity = n;
 	}
 
+	void thread_pool::control_block::pin_worker([[maybe_unused]] worker_t &worker,
+												[[maybe_unused]] std::size_t idx) const noexcept
+	{
+#if defined(SEK_OS_LINUX)
+		const auto &topology = cpu_topology::instance();
+		if (topology.nodes.empty()) [[unlikely]]
+			return;
+
+		/* Workers are distributed round-robin across NUMA nodes. */
+		const auto &node = topology.nodes[idx % topology.nodes.size()];
+		cpu_set_t set;
+		switch (affinity)
+		{
+			case affinity_mode::none: set = topology.process_set; break;
+			case affinity_mode::cpu:
+			{
+				CPU_ZERO(&set);
+				CPU_SET(node[(idx / topology.nodes.size()) % node.size()], &set);
+				break;
+			}
+			case affinity_mode::numa_node:
+			{
+				CPU_ZERO(&set);
+				for (auto cpu : node) CPU_SET(cpu, &set);
+				break;
+			}
+		}
+
+		if (const auto err = pthread_setaffinity_np(worker.thread.native_handle(), sizeof(set), &set); err != 0)
+			logger::warn()->log(fmt::format("Failed to set affinity of worker thread: {}", std::strerror(err)));
+#endif
+	}
+
+	void thread_pool::control_block::configure(const worker_config &config)
+	{
+		spin_count.store(config.spin_count, std::memory_order_relaxed);
+		yield_count.store(config.yield_count, std::memory_order_relaxed);
+		measure_time.store(config.measure_time, std::memory_order_relaxed);
+		begin_hook.store(config.on_task_begin, std::memory_order_relaxed);
+		end_hook.store(config.on_task_end, std::memory_order_relaxed);
+
+		/* Re-pin existing workers. If affinity was disabled, workers are allowed to run on any CPU again. */
+		if (std::exchange(affinity, config.affinity) != affinity_mode::none || affinity != affinity_mode::none)
+			for (std::size_t i = 0; i < workers_count; ++i) pin_worker(workers_data[i], i);
+	}
 	void thread_pool::control_block::resize(std::size_t n)
 	{
 		adjust_worker_count(n);
@@ -70,8 +339,12 @@ namespace sek
 		{
 			if (n > workers_capacity) [[unlikely]]
 				realloc_workers(n);
-			for (auto worker = workers_data + workers_count, end = workers_data + n; worker != end; ++worker)
-				std::construct_at(worker, this);
+			for (auto i = workers_count; i < n; ++i)
+			{
+				std::construct_at(workers_data + i, this);
+				workers_count = i + 1;
+				if (affinity != affinity_mode::none) pin_worker(workers_data[i], i);
+			}
 		}
 		workers_count = n;
 	}
@@ -83,32 +356,441 @@ namespace sek
 			delete this;
 	}
 
-	void thread_pool::worker_t::thread_main(std::stop_token st, control_block *cb) noexcept
+	void thread_pool::control_block::push_task(task_base *task, task_priority priority)
 	{
-		cb->acquire();
-		for (;;)
+		/* Only normal-priority tasks without a deadline are pushed to local deques, other tasks must be visible
+		 * to all workers to be dispatched in priority order. */
+		const auto has_deadline = task->deadline != time_point::max();
+		task->priority = priority;
+		if (measure_time.load(std::memory_order_relaxed)) task->queued_at = std::chrono::steady_clock::now();
+		if (priority == task_priority::normal && !has_deadline &&
+			(dispatch_mode.load(std::memory_order_relaxed) & work_stealing) && this_worker.cb == this)
 		{
-			task_base *task;
+			static_cast<worker_queue *>(this_worker.queue)->push(task);
+
+			/* Wake up an idle worker to steal the task. The fence pairs with the one in `wait_task`. */
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (idle_count.load(std::memory_order_relaxed) != 0)
+			{
+				{ std::lock_guard<std::mutex> l(mtx); }
+				cv.notify_one();
+			}
+			return;
+		}
+
+		auto &lane = lanes[static_cast<std::size_t>(priority)];
+		{
+			std::lock_guard<std::mutex> l(mtx);
+			if (has_deadline)
+			{
+				/* Deadline list is sorted by deadline, tasks with equal deadlines are kept in FIFO order. */
+				auto pos = &lane.deadlines;
+				while (pos->next != &lane.deadlines && static_cast<task_base *>(pos->next)->deadline <= task->deadline)
+					pos = pos->next;
+				task->link_after(*pos);
+				deadline_count.fetch_add(1, std::memory_order_relaxed);
+			}
+			else
+				task->link_after(lane.queue);
+			lane.size.fetch_add(1, std::memory_order_relaxed);
+			queue_size.fetch_add(1, std::memory_order_relaxed);
+			update_high_water();
+		}
+		cv.notify_one();
+	}
+	void thread_pool::control_block::push_batch(task_batch &batch, task_priority priority) noexcept
+	{
+		const auto n = batch.size;
+		if (n == 0) [[unlikely]]
+			return;
+
+		const auto now = measure_time.load(std::memory_order_relaxed) ? std::chrono::steady_clock::now() : time_point{};
+		for (auto task = batch.front; task != nullptr; task = task->next)
+		{
+			static_cast<task_base *>(task)->queued_at = now; // NOLINT
+			static_cast<task_base *>(task)->priority = priority; // NOLINT
+		}
+
+		if (priority == task_priority::normal && (dispatch_mode.load(std::memory_order_relaxed) & work_stealing) &&
+			this_worker.cb == this)
+		{
+			const auto queue = static_cast<worker_queue *>(this_worker.queue);
 			try
 			{
-				/* Wait for termination or available tasks. */
-				std::unique_lock<std::mutex> lock(cb->mtx);
-				cb->cv.wait(lock, [&]() { return st.stop_requested() || cb->queue_head.next != &cb->queue_head; });
+				for (; batch.back != nullptr; --batch.size)
+				{
+					queue->push(static_cast<task_base *>(batch.back)); // NOLINT
+					batch.back = batch.back->previous;
+				}
+			}
+			catch (...)
+			{
+				/* If the local deque failed to grow, the rest of the batch is pushed to the shared queue. */
+			}
+
+			if (batch.size == 0)
+			{
+				/* The fence pairs with the one in `wait_task`. */
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				if (idle_count.load(std::memory_order_relaxed) != 0)
+				{
+					{ std::lock_guard<std::mutex> l(mtx); }
+					notify_idle(n);
+				}
+				return;
+			}
+		}
+
+		/* Splice the whole batch to the front of the lane. */
+		auto &lane = lanes[static_cast<std::size_t>(priority)];
+		{
+			std::lock_guard<std::mutex> l(mtx);
+			batch.front->previous = &lane.queue;
+			batch.back->next = lane.queue.next;
+			lane.queue.next->previous = batch.back;
+			lane.queue.next = batch.front;
+
+			lane.size.fetch_add(batch.size, std::memory_order_relaxed);
+			queue_size.fetch_add(batch.size, std::memory_order_relaxed);
+			update_high_water();
+		}
+		notify_idle(n);
+	}
+	void thread_pool::control_block::notify_idle(std::size_t n) noexcept
+	{
+		/* Wake up at most n idle workers. If there are not enough idle workers, wake all of them at once. */
+		if (n >= idle_count.load(std::memory_order_relaxed))
+			cv.notify_all();
+		else
+			while (n-- != 0) cv.notify_one();
+	}
+	void thread_pool::control_block::update_high_water() noexcept
+	{
+		/* Only modified under the lock, thus no need for a CAS loop. */
+		const auto n = queue_size.load(std::memory_order_relaxed);
+		if (n > queue_high_water.load(std::memory_order_relaxed)) queue_high_water.store(n, std::memory_order_relaxed);
+	}
+	std::size_t thread_pool::control_block::queue_depth(task_priority priority) const noexcept
+	{
+		auto result = lanes[static_cast<std::size_t>(priority)].size.load(std::memory_order_relaxed);
+		if (priority == task_priority::normal)
+			for (auto queue = queues_head.load(std::memory_order_acquire); queue != nullptr; queue = queue->next)
+				result += queue->size();
+		return result;
+	}
+
+	thread_pool::worker_queue *thread_pool::control_block::attach_queue()
+	{
+		worker_queue *result = nullptr;
+		{
+			std::lock_guard<std::mutex> l(mtx);
 
-				/* Break out of the loop if termination was requested, otherwise get the next task. */
-				if (st.stop_requested()) [[unlikely]]
+			/* Re-use deques of terminated workers if possible. */
+			for (auto queue = queues_head.load(std::memory_order_relaxed); queue != nullptr; queue = queue->next)
+				if (!queue->in_use)
+				{
+					queue->in_use = true;
+					result = queue;
 					break;
-				else
-					task = cb->pop_task();
+				}
+			if (result == nullptr)
+			{
+				result = new worker_queue();
+				result->id = queues_count.load(std::memory_order_relaxed);
+				result->next = queues_head.load(std::memory_order_relaxed);
+				queues_head.store(result, std::memory_order_release);
+				queues_count.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		this_worker = {this, result};
+		return result;
+	}
+	void thread_pool::control_block::detach_queue(worker_queue *queue)
+	{
+		this_worker = {};
+
+		/* Move any tasks left in the local deque to the shared queue, so that they are not lost. Tasks are popped
+		 * newest-first, thus every task is linked after the previous one to keep the oldest task at the back. */
+		bool has_leftovers = false;
+		{
+			std::lock_guard<std::mutex> l(mtx);
+			task_node *positions[priority_levels];
+			for (std::size_t i = 0; i < priority_levels; ++i) positions[i] = &lanes[i].queue;
+			while (auto task = queue->pop())
+			{
+				const auto lane_idx = static_cast<std::size_t>(task->priority);
+				task->link_after(*std::exchange(positions[lane_idx], task));
+				lanes[lane_idx].size.fetch_add(1, std::memory_order_relaxed);
+				queue_size.fetch_add(1, std::memory_order_relaxed);
+				has_leftovers = true;
 			}
-			catch (std::system_error &e) /* Mutex error. */
+			update_high_water();
+			queue->in_use = false;
+		}
+		if (has_leftovers) cv.notify_all();
+	}
+
+	bool thread_pool::control_block::has_tasks() const noexcept
+	{
+		if (queue_size.load(std::memory_order_relaxed) != 0) return true;
+		for (auto queue = queues_head.load(std::memory_order_acquire); queue != nullptr; queue = queue->next)
+			if (!queue->empty()) return true;
+		return false;
+	}
+	thread_pool::task_base *thread_pool::control_block::pop_task(bool urgent) noexcept
+	{
+		/* Tasks with expired deadlines take precedence over all lanes. */
+		if (deadline_count.load(std::memory_order_relaxed) != 0)
+		{
+			const auto now = std::chrono::steady_clock::now();
+			task_lane *expired = nullptr;
+			for (auto lane = std::end(lanes); lane-- != std::begin(lanes);)
 			{
-				logger::error()->log(fmt::format("Mutex error in worker thread: {}", e.what()));
+				if (lane->deadlines.next == &lane->deadlines) continue;
+				const auto deadline = static_cast<task_base *>(lane->deadlines.next)->deadline;
+				if (deadline > now) continue;
+				if (expired == nullptr || deadline < static_cast<task_base *>(expired->deadlines.next)->deadline)
+					expired = lane;
 			}
+			if (expired != nullptr) return pop_lane(*expired);
+		}
+
+		/* Select the highest non-empty lane, unless a lower lane has been skipped too many times. */
+		const auto limit = starvation_limit.load(std::memory_order_relaxed);
+		task_lane *selected = nullptr;
+		for (auto lane = std::end(lanes); lane-- != std::begin(lanes);)
+		{
+			if (lane->size.load(std::memory_order_relaxed) == 0)
+				continue;
+			else if (selected == nullptr || lane->skipped >= limit)
+				selected = lane;
+		}
+
+		/* Urgent pops are only used to pre-empt the local deque, thus only the high lane qualifies. */
+		if (selected == nullptr || (urgent && selected != &lanes[static_cast<std::size_t>(task_priority::high)]))
+			return nullptr;
 
-			/* Execute & delete the task. */
-			delete task->invoke();
+		for (auto lane = std::begin(lanes); lane != selected; ++lane)
+			if (lane->size.load(std::memory_order_relaxed) != 0) ++lane->skipped;
+		selected->skipped = 0;
+		return pop_lane(*selected);
+	}
+	thread_pool::task_base *thread_pool::control_block::pop_lane(task_lane &lane) noexcept
+	{
+		task_node *node;
+		if (lane.deadlines.next != &lane.deadlines)
+		{
+			node = lane.deadlines.next;
+			deadline_count.fetch_sub(1, std::memory_order_relaxed);
+		}
+		else if (dispatch_mode.load(std::memory_order_relaxed) & filo)
+			node = lane.queue.front;
+		else
+			node = lane.queue.back;
+
+		lane.size.fetch_sub(1, std::memory_order_relaxed);
+		queue_size.fetch_sub(1, std::memory_order_relaxed);
+
+		// NOLINTNEXTLINE static cast is fine here since there is no virtual inheritance
+		return static_cast<task_base *>(node->unlink());
+	}
+	thread_pool::task_base *thread_pool::control_block::pop_local(worker_queue *queue) noexcept
+	{
+		/* In FIFO mode the owner takes the oldest task from the top of it's own deque. */
+		if (dispatch_mode.load(std::memory_order_relaxed) & filo)
+			return queue->pop();
+		else
+			return queue->steal();
+	}
+	thread_pool::task_base *thread_pool::control_block::pop_global(bool urgent) noexcept
+	{
+		if (urgent)
+		{
+			const auto &high = lanes[static_cast<std::size_t>(task_priority::high)];
+			if (high.size.load(std::memory_order_relaxed) == 0 && deadline_count.load(std::memory_order_relaxed) == 0)
+				return nullptr;
 		}
+		else if (queue_size.load(std::memory_order_relaxed) == 0)
+			return nullptr;
+
+		std::lock_guard<std::mutex> l(mtx);
+		return queue_size.load(std::memory_order_relaxed) != 0 ? pop_task(urgent) : nullptr;
+	}
+	thread_pool::task_base *thread_pool::control_block::steal_task(worker_queue *queue, std::uint32_t &seed) noexcept
+	{
+		const auto count = queues_count.load(std::memory_order_relaxed);
+		if (count < 2) [[unlikely]]
+			return nullptr;
+
+		/* Select a random victim (xorshift32), then try every other deque starting from it. */
+		seed ^= seed << 13;
+		seed ^= seed >> 17;
+		seed ^= seed << 5;
+
+		const auto head = queues_head.load(std::memory_order_acquire);
+		auto victim = head;
+		for (auto i = seed % count; i != 0 && victim->next != nullptr; --i) victim = victim->next;
+
+		worker_counters::add(queue->stats.steal_attempts, 1);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			if (victim != queue)
+				if (auto task = victim->steal(); task != nullptr)
+				{
+					worker_counters::add(queue->stats.steals, 1);
+					return task;
+				}
+			if ((victim = victim->next) == nullptr) victim = head;
+		}
+		return nullptr;
+	}
+	thread_pool::task_base *thread_pool::control_block::spin_task(worker_queue *queue,
+																  std::uint32_t &seed,
+																  std::stop_token &st) noexcept
+	{
+		const auto try_pop = [&]() -> task_base *
+		{
+			if (!has_tasks()) return nullptr;
+			if (auto task = pop_global(false); task != nullptr) return task;
+			return steal_task(queue, seed);
+		};
+
+		/* Spin & yield before parking, to avoid the latency of a wake-up for short bursts of tasks. */
+		for (auto i = spin_count.load(std::memory_order_relaxed); i != 0 && !st.stop_requested(); --i)
+		{
+			cpu_relax();
+			if (auto task = try_pop(); task != nullptr) return task;
+		}
+		for (auto i = yield_count.load(std::memory_order_relaxed); i != 0 && !st.stop_requested(); --i)
+		{
+			std::this_thread::yield();
+			if (auto task = try_pop(); task != nullptr) return task;
+		}
+		return nullptr;
+	}
+	thread_pool::task_base *thread_pool::control_block::wait_task(std::stop_token &st) noexcept
+	{
+		try
+		{
+			/* Wait for termination or available tasks. */
+			std::unique_lock<std::mutex> lock(mtx);
+			idle_count.fetch_add(1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			cv.wait(lock, [&]() { return st.stop_requested() || has_tasks(); });
+			idle_count.fetch_sub(1, std::memory_order_relaxed);
+
+			/* Take a task from the shared queue if possible, otherwise let the worker try to steal. */
+			if (!st.stop_requested() && queue_size.load(std::memory_order_relaxed) != 0) [[likely]]
+				return pop_task(false);
+		}
+		catch (std::system_error &e) /* Mutex error. */
+		{
+			logger::error()->log(fmt::format("Mutex error in worker thread: {}", e.what()));
+		}
+		return nullptr;
+	}
+
+	void thread_pool::control_block::execute_task(worker_queue *queue, task_base *task, time_point &last) noexcept
+	{
+		using namespace std::chrono;
+
+		/* Idle time is measured from the end of the previous task. */
+		time_point start = {};
+		if (measure_time.load(std::memory_order_relaxed))
+		{
+			start = steady_clock::now();
+			if (last != time_point{})
+				worker_counters::add(queue->stats.idle_ns, static_cast<std::uint64_t>((start - last).count()));
+			if (task->queued_at != time_point{})
+			{
+				const auto latency = duration_cast<microseconds>(start - task->queued_at);
+				const auto bucket = std::min<std::size_t>(std::bit_width(static_cast<std::uint64_t>(latency.count())),
+														  latency_buckets - 1);
+				worker_counters::add(queue->stats.latency[bucket], 1);
+			}
+		}
+
+		/* Task may be destroyed by `invoke`, thus it is only used as an id by the end hook. */
+		if (const auto hook = begin_hook.load(std::memory_order_relaxed); hook != nullptr) hook(queue->id, task);
+		task->invoke();
+		if (const auto hook = end_hook.load(std::memory_order_relaxed); hook != nullptr) hook(queue->id, task);
+		worker_counters::add(queue->stats.tasks_executed, 1);
+
+		if (start != time_point{})
+		{
+			last = steady_clock::now();
+			worker_counters::add(queue->stats.busy_ns, static_cast<std::uint64_t>((last - start).count()));
+		}
+		else
+			last = {};
+	}
+	thread_pool::pool_stats thread_pool::control_block::stats() const
+	{
+		pool_stats result;
+		result.queue_high_water = queue_high_water.load(std::memory_order_relaxed);
+		for (auto queue = queues_head.load(std::memory_order_acquire); queue != nullptr; queue = queue->next)
+		{
+			const auto &counters = queue->stats;
+			auto &worker = result.workers.emplace_back();
+			worker.id = queue->id;
+			worker.tasks_executed = counters.tasks_executed.load(std::memory_order_relaxed);
+			worker.steal_attempts = counters.steal_attempts.load(std::memory_order_relaxed);
+			worker.steals = counters.steals.load(std::memory_order_relaxed);
+			worker.busy_time = std::chrono::nanoseconds{counters.busy_ns.load(std::memory_order_relaxed)};
+			worker.idle_time = std::chrono::nanoseconds{counters.idle_ns.load(std::memory_order_relaxed)};
+			worker.queue_high_water = counters.queue_high_water.load(std::memory_order_relaxed);
+			for (std::size_t i = 0; i < latency_buckets; ++i)
+				worker.latency[i] = counters.latency[i].load(std::memory_order_relaxed);
+		}
+
+		/* Queues are linked newest-first. */
+		std::reverse(result.workers.begin(), result.workers.end());
+		return result;
+	}
+
+	void thread_pool::worker_t::thread_main(std::stop_token st, control_block *cb) noexcept
+	{
+		worker_queue *queue;
+		try
+		{
+			queue = cb->attach_queue();
+		}
+		catch (std::exception &e)
+		{
+			logger::error()->log(fmt::format("Failed to initialize worker thread: {}", e.what()));
+			cb->release();
+			return;
+		}
+
+		auto seed = static_cast<std::uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id())) | 1;
+		std::size_t local_streak = 0;
+		time_point last = {};
+		while (!st.stop_requested())
+		{
+			/* High-priority & overdue tasks pre-empt the local deque. The local deque is bypassed periodically,
+			 * so that it can not starve tasks of the shared lanes. */
+			task_base *task;
+			if (local_streak >= cb->starvation_limit.load(std::memory_order_relaxed))
+			{
+				local_streak = 0;
+				task = cb->pop_global(false);
+			}
+			else
+				task = cb->pop_global(true);
+
+			/* Try the local deque first, then the shared queue, then steal from other workers. */
+			if (task == nullptr && (task = cb->pop_local(queue)) != nullptr) ++local_streak;
+			if (task == nullptr) task = cb->pop_global(false);
+			if (task == nullptr) task = cb->steal_task(queue, seed);
+			if (task == nullptr) task = cb->spin_task(queue, seed, st);
+			if (task == nullptr) task = cb->wait_task(st);
+
+			/* Execute the task. Tasks release themselves once complete. */
+			if (task != nullptr) cb->execute_task(queue, task, last);
+		}
+
+		cb->detach_queue(queue);
 		cb->release();
 	}
 }	 // namespace sek
\ No newline at end of file
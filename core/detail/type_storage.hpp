@@ -6,6 +6,7 @@
 
 #include <bit>
 #include <cstddef>
+#include <type_traits>
 
 namespace sek
 {
@@ -15,6 +16,10 @@ namespace sek
 	{
 	public:
 		constexpr type_storage() noexcept : m_bytes() {}
+		/* Storage does not manage lifetime of the contained objects. */
+		constexpr ~type_storage() requires std::is_trivially_destructible_v<T> = default;
+		constexpr ~type_storage() {}
+
 		constexpr type_storage(const type_storage &other) noexcept : m_bytes(other.m_bytes) {}
 		constexpr type_storage &operator=(const type_storage &other) noexcept
 		{
@@ -0,0 +1,154 @@
+/*
+ * Created by switchblade on 2026-10-16
+ */
+
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <memory>
+
+#include "../define.h"
+
+namespace sek::detail
+{
+	/** @brief Lock-free single-owner work-stealing deque of pointers.
+	 *
+	 * Implementation of the Chase-Lev deque as described in
+	 * "Correct and Efficient Work-Stealing for Weak Memory Models" (Lê, Pop, Cohen & Nardelli).
+	 * Only the owner thread may push & pop from the bottom, while any thread may steal from the top. */
+	template<typename T>
+	class work_deque
+	{
+		struct buffer_t
+		{
+			static buffer_t *make(std::size_t cap, buffer_t *prev)
+			{
+				const auto bytes = sizeof(buffer_t) + cap * sizeof(std::atomic<T *>);
+				auto result = static_cast<buffer_t *>(::operator new(bytes));
+				result->previous = prev;
+				result->mask = cap - 1;
+				for (std::size_t i = 0; i < cap; ++i) std::construct_at(result->data() + i, nullptr);
+				return result;
+			}
+			static buffer_t *destroy(buffer_t *buff) noexcept
+			{
+				const auto bytes = sizeof(buffer_t) + buff->capacity() * sizeof(std::atomic<T *>);
+				const auto previous = buff->previous;
+				::operator delete(static_cast<void *>(buff), bytes);
+				return previous;
+			}
+
+			[[nodiscard]] std::atomic<T *> *data() noexcept { return std::bit_cast<std::atomic<T *> *>(this + 1); }
+			[[nodiscard]] std::size_t capacity() const noexcept { return mask + 1; }
+
+			[[nodiscard]] T *get(std::ptrdiff_t i) noexcept
+			{
+				return data()[static_cast<std::size_t>(i) & mask].load(std::memory_order_relaxed);
+			}
+			void put(std::ptrdiff_t i, T *value) noexcept
+			{
+				data()[static_cast<std::size_t>(i) & mask].store(value, std::memory_order_relaxed);
+			}
+
+			/* Replaced buffers are kept alive until the deque is destroyed, since thieves may still read them. */
+			buffer_t *previous;
+			std::size_t mask;
+		};
+
+		constexpr static std::size_t initial_capacity = 64;
+
+	public:
+		work_deque(const work_deque &) = delete;
+		work_deque &operator=(const work_deque &) = delete;
+
+		work_deque() : work_deque(initial_capacity) {}
+		explicit work_deque(std::size_t cap) : m_buffer(buffer_t::make(std::bit_ceil(cap), nullptr)) {}
+		~work_deque()
+		{
+			for (auto buff = m_buffer.load(std::memory_order_relaxed); buff != nullptr;) buff = buffer_t::destroy(buff);
+		}
+
+		/** Checks if the deque is empty. Result is approximate if the deque is accessed concurrently. */
+		[[nodiscard]] bool empty() const noexcept
+		{
+			const auto b = m_bottom.load(std::memory_order_relaxed);
+			const auto t = m_top.load(std::memory_order_relaxed);
+			return b <= t;
+		}
+		/** Returns approximate amount of elements in the deque. */
+		[[nodiscard]] std::size_t size() const noexcept
+		{
+			const auto b = m_bottom.load(std::memory_order_relaxed);
+			const auto t = m_top.load(std::memory_order_relaxed);
+			return b > t ? static_cast<std::size_t>(b - t) : 0;
+		}
+
+		/** Pushes an element to the bottom of the deque. Must only be called by the owner thread. */
+		void push(T *value)
+		{
+			const auto b = m_bottom.load(std::memory_order_relaxed);
+			const auto t = m_top.load(std::memory_order_acquire);
+			auto buff = m_buffer.load(std::memory_order_relaxed);
+			if (b - t > static_cast<std::ptrdiff_t>(buff->mask)) [[unlikely]]
+				buff = grow(buff, b, t);
+
+			buff->put(b, value);
+			m_bottom.store(b + 1, std::memory_order_release);
+		}
+		/** Pops an element from the bottom of the deque. Must only be called by the owner thread.
+		 * @return Pointer to the popped element, or `nullptr` if the deque is empty. */
+		[[nodiscard]] T *pop() noexcept
+		{
+			const auto b = m_bottom.load(std::memory_order_relaxed) - 1;
+			const auto buff = m_buffer.load(std::memory_order_relaxed);
+			m_bottom.store(b, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			auto t = m_top.load(std::memory_order_relaxed);
+
+			T *result = nullptr;
+			if (t <= b)
+			{
+				result = buff->get(b);
+				if (t == b) /* Last element, race against thieves. */
+				{
+					if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+						result = nullptr;
+					m_bottom.store(b + 1, std::memory_order_relaxed);
+				}
+			}
+			else
+				m_bottom.store(b + 1, std::memory_order_relaxed);
+			return result;
+		}
+		/** Steals an element from the top of the deque. May be called by any thread.
+		 * @return Pointer to the stolen element, or `nullptr` if the deque is empty or the steal has lost a race. */
+		[[nodiscard]] T *steal() noexcept
+		{
+			auto t = m_top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			const auto b = m_bottom.load(std::memory_order_acquire);
+
+			if (t < b)
+			{
+				const auto result = m_buffer.load(std::memory_order_acquire)->get(t);
+				if (m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					return result;
+			}
+			return nullptr;
+		}
+
+	private:
+		buffer_t *grow(buffer_t *old, std::ptrdiff_t b, std::ptrdiff_t t)
+		{
+			auto buff = buffer_t::make(old->capacity() * 2, old);
+			for (auto i = t; i != b; ++i) buff->put(i, old->get(i));
+			m_buffer.store(buff, std::memory_order_release);
+			return buff;
+		}
+
+		alignas(64) std::atomic<std::ptrdiff_t> m_top = 0;
+		alignas(64) std::atomic<std::ptrdiff_t> m_bottom = 0;
+		std::atomic<buffer_t *> m_buffer;
+	};
+}	 // namespace sek::detail
\ No newline at end of file
@@ -0,0 +1,104 @@
+/*
+ * Created by switchblade on 2026-10-16
+ */
+
+#pragma once
+
+#include "dense_set.hpp"
+#include "detail/mapped_dense_table.hpp"
+
+namespace sek
+{
+	/** @brief Read-only view of a dense set stored within a flat relocatable image.
+	 *
+	 * Mapped dense sets perform lookups directly over an image produced by `make_image`, without deserializing it.
+	 * Since the image contains only offsets, it can be written to a file & later used straight from a memory-mapped
+	 * region (ex. `native_filemap::bytes()`). The image must be aligned to at least 8 bytes and must outlive the set.
+	 * Values must be either trivially copyable or strings, strings are accessed as string views into the string pool
+	 * of the image.
+	 *
+	 * @tparam T Type of values of the source set.
+	 * @tparam KeyHash Functor used to generate hashes for keys. Must produce the same hashes for the same keys across
+	 * different processes, which is the case for `default_hash` of strings & integers.
+	 * @tparam KeyComp Predicate used to compare keys.
+	 * @note Images are not portable between platforms with different endianness or type layouts. */
+	template<typename T, typename KeyHash = default_hash, typename KeyComp = std::equal_to<>>
+	class mapped_dense_set
+	{
+		using table_type = detail::mapped_dense_table<T, void, KeyHash, KeyComp>;
+
+	public:
+		typedef T key_type;
+		typedef typename table_type::key_view key_view;
+		typedef typename table_type::value_type value_type;
+		typedef KeyHash hash_type;
+		typedef KeyComp key_equal;
+
+		typedef typename table_type::iterator iterator;
+		typedef typename table_type::iterator const_iterator;
+		typedef typename table_type::size_type size_type;
+		typedef typename table_type::difference_type difference_type;
+
+		/** Creates a relocatable image of a dense set.
+		 * @param set Set to create the image of.
+		 * @param key_hash Key hasher used to hash keys of the image.
+		 * @return Vector of bytes containing the image.
+		 * @throw std::length_error If the set contains too many elements. */
+		template<typename H, typename C, typename A>
+		[[nodiscard]] static std::vector<std::byte> make_image(const dense_set<T, H, C, A> &set,
+															   const KeyHash &key_hash = {})
+		{
+			return table_type::make_image(set.begin(), set.size(), key_hash, [](auto &v) -> auto & { return v; });
+		}
+
+	public:
+		/** Initializes an empty set not bound to any image. */
+		constexpr mapped_dense_set() noexcept = default;
+		/** Initializes a set from a relocatable image.
+		 * @param image Span of bytes containing the image created by `make_image`.
+		 * @param key_hash Key hasher.
+		 * @param key_compare Key comparator.
+		 * @throw std::invalid_argument If the image header is invalid or does not match the value type. */
+		explicit mapped_dense_set(std::span<const std::byte> image,
+								  const KeyHash &key_hash = {},
+								  const KeyComp &key_compare = {})
+			: m_table(image, key_hash, key_compare)
+		{
+		}
+
+		/** Returns iterator to the start of the set. */
+		[[nodiscard]] constexpr const_iterator begin() const noexcept { return m_table.begin(); }
+		/** Returns iterator to the end of the set. */
+		[[nodiscard]] constexpr const_iterator end() const noexcept { return m_table.end(); }
+		/** @copydoc begin */
+		[[nodiscard]] constexpr const_iterator cbegin() const noexcept { return begin(); }
+		/** @copydoc end */
+		[[nodiscard]] constexpr const_iterator cend() const noexcept { return end(); }
+
+		/** Locates an element within the set.
+		 * @param key Key to search for.
+		 * @return Iterator to the element with the specified key. */
+		[[nodiscard]] constexpr const_iterator find(key_view key) const noexcept { return m_table.find(key); }
+		/** Checks if the set contains a specific element.
+		 * @param key Key to search for. */
+		[[nodiscard]] constexpr bool contains(key_view key) const noexcept { return find(key) != end(); }
+
+		/** Returns current amount of elements in the set. */
+		[[nodiscard]] constexpr size_type size() const noexcept { return m_table.size(); }
+		/** Checks if the set is empty. */
+		[[nodiscard]] constexpr bool empty() const noexcept { return size() == 0; }
+		/** Returns amount of buckets of the set. */
+		[[nodiscard]] constexpr size_type bucket_count() const noexcept { return m_table.bucket_count(); }
+		/** Returns span of bytes of the underlying image. */
+		[[nodiscard]] constexpr std::span<const std::byte> image() const noexcept { return m_table.image(); }
+
+		[[nodiscard]] constexpr hash_type hash_function() const noexcept { return m_table.get_hash(); }
+		[[nodiscard]] constexpr key_equal key_eq() const noexcept { return m_table.get_comp(); }
+
+		constexpr void swap(mapped_dense_set &other) noexcept { m_table.swap(other.m_table); }
+		friend constexpr void swap(mapped_dense_set &a, mapped_dense_set &b) noexcept { a.swap(b); }
+
+	private:
+		table_type m_table;
+	};
+}	 // namespace sek
\ No newline at end of file
@@ -14,11 +14,15 @@ namespace sek
 {
 	/** @brief One-to-one associative container providing fast insertion while preserving insertion order.
 	 *
-	 * Ordered maps are implemented via a closed-addressing contiguous (packed) storage hash table and a linked list
-	 * used to keep track of the insertion order. This allows for efficient constant-time insertion and optimal cache locality.
-	 * Ordered maps may invalidate iterators on insertion due to the internal packed storage being resized.
+	 * Ordered maps are implemented via a closed-addressing contiguous (packed) storage hash table, elements of which
+	 * are stored in insertion order. This allows for efficient constant-time insertion and optimal cache locality,
+	 * as iteration is a sequential scan of the packed storage.
+	 * Ordered maps may invalidate iterators on insertion due to the internal packed storage being resized or compacted.
 	 * On erasure, iterators to the erased element are invalidated.
 	 *
+	 * Small maps (up to 8 elements) do not allocate a bucket array and instead search all elements linearly.
+	 * The bucket array is built once the map grows past that threshold, or when capacity for more elements is reserved.
+	 *
 	 * @note Due to internal implementation, iterators of the map return a pair of references, instead of reference to a pair.
 	 *
 	 * @tparam K Type of objects used as keys.
@@ -366,6 +370,10 @@ namespace sek
 		constexpr void rehash(size_type capacity) { m_table.rehash(capacity); }
 		/** Resizes the internal storage to have space for at least n elements. */
 		constexpr void reserve(size_type n) { m_table.reserve(n); }
+		/** Removes holes left by erasure from the internal storage.
+		 * @note Holes are also removed on insertion once they make up more than half of the storage.
+		 * Invalidates iterators. */
+		constexpr void compact() { m_table.compact(); }
 
 		/** Attempts to construct a value in-place at the specified key.
 		 * If such key is already associated with a value, does nothing.
@@ -612,6 +620,15 @@ namespace sek
 		constexpr void swap(ordered_map &other) noexcept { m_table.swap(other.m_table); }
 		friend constexpr void swap(ordered_map &a, ordered_map &b) noexcept { a.swap(b); }
 
+		/** Removes all elements that satisfy the predicate `pred` from the map in a single pass.
+		 * @return Amount of elements removed.
+		 * @note Invalidates iterators. */
+		template<typename P>
+		friend constexpr size_type erase_if(ordered_map &map, P pred)
+		{
+			return map.m_table.erase_if(pred);
+		}
+
 	private:
 		/** Hash table used to implement the map. */
 		table_type m_table;
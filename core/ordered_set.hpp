@@ -14,9 +14,10 @@ namespace sek
 {
 	/** @brief Set container providing fast insertion while preserving insertion order.
 	 *
-	 * Ordered sets are implemented via a closed-addressing contiguous (packed) storage hash table and a linked list
-	 * used to keep track of the insertion order. This allows for efficient constant-time insertion and optimal cache locality.
-	 * Ordered sets may invalidate iterators on insertion due to the internal packed storage being resized.
+	 * Ordered sets are implemented via a closed-addressing contiguous (packed) storage hash table, elements of which
+	 * are stored in insertion order. This allows for efficient constant-time insertion and optimal cache locality,
+	 * as iteration is a sequential scan of the packed storage.
+	 * Ordered sets may invalidate iterators on insertion due to the internal packed storage being resized or compacted.
 	 * On erasure, iterators to the erased element are invalidated.
 	 *
 	 * @tparam T Type of objects stored in the set.
@@ -255,6 +256,10 @@ namespace sek
 		constexpr void rehash(size_type capacity) { m_table.rehash(capacity); }
 		/** Resizes the internal storage to have space for at least n elements. */
 		constexpr void reserve(size_type n) { m_table.reserve(n); }
+		/** Removes holes left by erasure from the internal storage.
+		 * @note Holes are also removed on insertion once they make up more than half of the storage.
+		 * Invalidates iterators. */
+		constexpr void compact() { m_table.compact(); }
 
 		/** Constructs a value (of value_type) in-place.
 		 * If the same value is already present within the set, replaces that value.
@@ -464,6 +469,15 @@ namespace sek
 		constexpr void swap(ordered_set &other) noexcept { m_table.swap(other.m_table); }
 		friend constexpr void swap(ordered_set &a, ordered_set &b) noexcept { a.swap(b); }
 
+		/** Removes all elements that satisfy the predicate `pred` from the set in a single pass.
+		 * @return Amount of elements removed.
+		 * @note Invalidates iterators. */
+		template<typename P>
+		friend constexpr size_type erase_if(ordered_set &set, P pred)
+		{
+			return set.m_table.erase_if(pred);
+		}
+
 	private:
 		/** Hash table used to implement the set. */
 		table_type m_table;
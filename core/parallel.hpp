@@ -0,0 +1,298 @@
+/*
+ * Created by switchblade on 2026-10-16
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <iterator>
+#include <optional>
+
+#include "thread_pool.hpp"
+
+namespace sek
+{
+	namespace detail
+	{
+		/* Shared state of a parallel job. The state is reference-counted, since helper tasks may start after the
+		 * job was already completed by other participants (ex. if the pool is saturated). */
+		struct parallel_job
+		{
+			using func_t = void (*)(void *, std::size_t, std::size_t);
+
+			parallel_job(std::size_t total, std::size_t grain, std::size_t participants, func_t func, void *data) noexcept
+				: total(total), grain(grain), participants(participants), ref_count(participants), func(func), data(data)
+			{
+			}
+
+			void release() noexcept
+			{
+				if (ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1) delete this;
+			}
+
+			/* Claims the next chunk. Chunk size is proportional to the remaining work, but no less than the grain size,
+			 * thus the range is split into progressively smaller chunks as the job nears completion. */
+			[[nodiscard]] std::size_t claim(std::size_t &begin) noexcept
+			{
+				for (auto pos = next.load(std::memory_order_relaxed);;)
+				{
+					if (pos >= total) return 0;
+
+					const auto size = std::min(std::max(grain, (total - pos) / (participants * 2)), total - pos);
+					if (next.compare_exchange_weak(pos, pos + size, std::memory_order_relaxed))
+					{
+						begin = pos;
+						return size;
+					}
+				}
+			}
+			void complete(std::size_t n) noexcept
+			{
+				if (completed.fetch_add(n, std::memory_order_acq_rel) + n == total) completed.notify_all();
+			}
+			void fail() noexcept
+			{
+				if (!has_error.test_and_set(std::memory_order_relaxed)) error = std::current_exception();
+
+				/* Prevent other participants from claiming new chunks & mark them as complete. */
+				if (const auto pos = next.exchange(total, std::memory_order_relaxed); pos < total) complete(total - pos);
+			}
+
+			void run() noexcept
+			{
+				std::size_t begin;
+				for (std::size_t n; (n = claim(begin)) != 0;)
+				{
+					try
+					{
+						func(data, begin, begin + n);
+					}
+					catch (...)
+					{
+						fail();
+					}
+					complete(n);
+				}
+			}
+			void wait() const noexcept
+			{
+				for (auto n = completed.load(std::memory_order_acquire); n != total; n = completed.load(std::memory_order_acquire))
+					completed.wait(n, std::memory_order_acquire);
+			}
+
+			const std::size_t total;
+			const std::size_t grain;
+			const std::size_t participants;
+
+			std::atomic<std::size_t> next = 0;
+			std::atomic<std::size_t> completed = 0;
+			std::atomic<std::size_t> ref_count;
+
+			func_t func;
+			void *data;
+
+			std::atomic_flag has_error;
+			std::exception_ptr error;
+		};
+
+		/* Invokes `f(begin, end)` for chunks of range [0, n), using both the calling thread & workers of the pool. */
+		template<typename F>
+		void parallel_chunks(thread_pool &pool, std::size_t n, std::size_t grain, F &&f)
+		{
+			if (n == 0) [[unlikely]]
+				return;
+
+			const auto max_participants = pool.size() + 1;
+			if (grain == 0) grain = std::max<std::size_t>(n / (max_participants * 64), 1);
+
+			const auto participants = std::min(max_participants, (n + grain - 1) / grain);
+			if (participants < 2)
+			{
+				f(std::size_t{0}, n);
+				return;
+			}
+
+			constexpr auto invoke = [](void *data, std::size_t first, std::size_t last)
+			{ (*static_cast<std::remove_reference_t<F> *>(data))(first, last); };
+			const auto data = const_cast<void *>(static_cast<const void *>(std::addressof(f)));
+			const auto job = new parallel_job(n, grain, participants, invoke, data);
+
+			/* If a helper could not be posted, the rest of the work is done by other participants. */
+			for (std::size_t i = 1; i < participants; ++i)
+			{
+				try
+				{
+					pool.post(
+						[job]()
+						{
+							job->run();
+							job->release();
+						});
+				}
+				catch (...)
+				{
+					job->ref_count.fetch_sub(participants - i, std::memory_order_relaxed);
+					break;
+				}
+			}
+
+			job->run();
+			job->wait();
+
+			auto error = job->has_error.test(std::memory_order_relaxed) ? job->error : nullptr;
+			job->release();
+			if (error) [[unlikely]]
+				std::rethrow_exception(std::move(error));
+		}
+	}	 // namespace detail
+
+	/** Invokes `f` for every element of range [first, last) using workers of the pool.
+	 * The calling thread participates in the work & returns once every element has been processed.
+	 * @param pool Thread pool used to execute the job.
+	 * @param first Iterator to the first element of the range.
+	 * @param last Sentinel for the range.
+	 * @param f Functor invoked with a reference to every element of the range.
+	 * @param grain Minimum amount of elements processed at a time. If set to 0, the grain size is selected automatically.
+	 * @note If `f` throws an exception, the first exception is re-thrown once all workers have finished. */
+	template<std::random_access_iterator I, std::sized_sentinel_for<I> S, typename F>
+	void parallel_for(thread_pool &pool, I first, S last, F &&f, std::size_t grain = 0)
+	{
+		const auto n = static_cast<std::size_t>(last - first);
+		detail::parallel_chunks(pool,
+								n,
+								grain,
+								[&](std::size_t begin, std::size_t end)
+								{
+									auto chunk_first = first + static_cast<std::iter_difference_t<I>>(begin);
+									const auto chunk_last = first + static_cast<std::iter_difference_t<I>>(end);
+									for (; chunk_first != chunk_last; ++chunk_first) f(*chunk_first);
+								});
+	}
+	/** Invokes `f` for every index of range [first, last) using workers of the pool.
+	 * @copydetails parallel_for */
+	template<std::integral I, typename F>
+	void parallel_for(thread_pool &pool, I first, I last, F &&f, std::size_t grain = 0)
+	{
+		if (last <= first) [[unlikely]]
+			return;
+
+		const auto n = static_cast<std::size_t>(last - first);
+		detail::parallel_chunks(pool,
+								n,
+								grain,
+								[&](std::size_t begin, std::size_t end)
+								{
+									for (auto i = begin; i != end; ++i) f(static_cast<I>(first + static_cast<I>(i)));
+								});
+	}
+
+	/** Applies `op` to every element of range [first, last) and stores the result to the range beginning at `out`.
+	 * @param pool Thread pool used to execute the job.
+	 * @param first Iterator to the first element of the input range.
+	 * @param last Sentinel for the input range.
+	 * @param out Iterator to the first element of the output range.
+	 * @param op Unary operation applied to every element.
+	 * @param grain Minimum amount of elements processed at a time. If set to 0, the grain size is selected automatically.
+	 * @return Iterator to the element past the last transformed element. */
+	template<std::random_access_iterator I, std::sized_sentinel_for<I> S, std::random_access_iterator O, typename Op>
+	O parallel_transform(thread_pool &pool, I first, S last, O out, Op &&op, std::size_t grain = 0)
+	{
+		const auto n = static_cast<std::size_t>(last - first);
+		detail::parallel_chunks(pool,
+								n,
+								grain,
+								[&](std::size_t begin, std::size_t end)
+								{
+									auto chunk_first = first + static_cast<std::iter_difference_t<I>>(begin);
+									const auto chunk_last = first + static_cast<std::iter_difference_t<I>>(end);
+									auto chunk_out = out + static_cast<std::iter_difference_t<O>>(begin);
+									for (; chunk_first != chunk_last; ++chunk_first, ++chunk_out) *chunk_out = op(*chunk_first);
+								});
+		return out + static_cast<std::iter_difference_t<O>>(n);
+	}
+
+	/** Reduces range [first, last) using workers of the pool.
+	 * @param pool Thread pool used to execute the job.
+	 * @param first Iterator to the first element of the range.
+	 * @param last Sentinel for the range.
+	 * @param init Initial value of the reduction.
+	 * @param op Binary reduction operation. Must be associative & commutative, since the order of
+	 * reduction is unspecified.
+	 * @param grain Minimum amount of elements processed at a time. If set to 0, the grain size is selected automatically.
+	 * @return Result of the reduction. */
+	template<std::random_access_iterator I, std::sized_sentinel_for<I> S, typename T, typename Op = std::plus<>>
+	T parallel_reduce(thread_pool &pool, I first, S last, T init, Op op = {}, std::size_t grain = 0)
+	{
+		const auto n = static_cast<std::size_t>(last - first);
+
+		/* Every chunk is reduced locally, partial results are merged under a lock. */
+		std::optional<T> result;
+		std::mutex mtx;
+		detail::parallel_chunks(pool,
+								n,
+								grain,
+								[&](std::size_t begin, std::size_t end)
+								{
+									auto chunk_first = first + static_cast<std::iter_difference_t<I>>(begin);
+									const auto chunk_last = first + static_cast<std::iter_difference_t<I>>(end);
+
+									T partial = *chunk_first;
+									while (++chunk_first != chunk_last) partial = op(std::move(partial), *chunk_first);
+
+									std::lock_guard<std::mutex> l(mtx);
+									if (result.has_value())
+										result.emplace(op(std::move(*result), std::move(partial)));
+									else
+										result.emplace(std::move(partial));
+								});
+		return result.has_value() ? op(std::move(init), std::move(*result)) : init;
+	}
+
+	/** Sorts range [first, last) using workers of the pool.
+	 * The range is split into runs which are sorted in parallel, then merged pairwise in parallel.
+	 * @param pool Thread pool used to execute the job.
+	 * @param first Iterator to the first element of the range.
+	 * @param last Iterator past the last element of the range.
+	 * @param comp Comparator used to order the elements.
+	 * @param grain Minimum amount of elements in a run. If set to 0, the grain size is selected automatically.
+	 * @note Sort is not stable. */
+	template<std::random_access_iterator I, typename C = std::less<>>
+	void parallel_sort(thread_pool &pool, I first, I last, C comp = {}, std::size_t grain = 0)
+	{
+		using diff_t = std::iter_difference_t<I>;
+
+		const auto n = static_cast<std::size_t>(last - first);
+		if (grain == 0) grain = 2048;
+
+		/* Select amount of runs as a power of 2, so that runs can be merged pairwise. */
+		const auto max_runs = std::bit_floor(std::max<std::size_t>(n / grain, 1));
+		const auto runs = std::min(std::bit_ceil(pool.size() + 1), max_runs);
+		if (runs < 2)
+		{
+			std::sort(first, last, comp);
+			return;
+		}
+
+		const auto run_size = (n + runs - 1) / runs;
+		const auto run_iter = [&](std::size_t i) { return first + static_cast<diff_t>(std::min(i * run_size, n)); };
+
+		detail::parallel_chunks(pool,
+								runs,
+								1,
+								[&](std::size_t begin, std::size_t end)
+								{
+									for (auto i = begin; i != end; ++i) std::sort(run_iter(i), run_iter(i + 1), comp);
+								});
+		for (std::size_t width = 1; width < runs; width *= 2)
+			detail::parallel_chunks(pool,
+									runs / (width * 2),
+									1,
+									[&](std::size_t begin, std::size_t end)
+									{
+										for (auto i = begin * width * 2; i != end * width * 2; i += width * 2)
+											std::inplace_merge(run_iter(i), run_iter(i + width), run_iter(i + width * 2), comp);
+									});
+	}
+}	 // namespace sek
\ No newline at end of file
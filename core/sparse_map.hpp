@@ -312,6 +312,10 @@ namespace sek
 		constexpr void rehash(size_type capacity) { m_table.rehash(capacity); }
 		/** Resizes the internal storage to have space for at least n elements. */
 		constexpr void reserve(size_type n) { m_table.reserve(n); }
+		/** Shrinks the internal storage to fit the current size of the map.
+		 * @note For maps using pooled nodes (see `pooled_hash`), moves all values into a single contiguous page,
+		 * which invalidates pointers & references to the values. Invalidates iterators. */
+		constexpr void shrink_to_fit() { m_table.shrink_to_fit(); }
 
 		/** Attempts to construct a value in-place at the specified key.
 		 * If such key is already associated with a value, does nothing.
@@ -585,6 +589,15 @@ namespace sek
 		constexpr void swap(sparse_map &other) noexcept { m_table.swap(other.m_table); }
 		friend constexpr void swap(sparse_map &a, sparse_map &b) noexcept { a.swap(b); }
 
+		/** Removes all elements that satisfy the predicate `pred` from the map in a single pass.
+		 * @return Amount of elements removed.
+		 * @note Invalidates iterators. */
+		template<typename P>
+		friend constexpr size_type erase_if(sparse_map &map, P pred)
+		{
+			return map.m_table.erase_if(pred);
+		}
+
 	private:
 		/** Hash table used to implement the map. */
 		table_type m_table;
@@ -234,6 +234,10 @@ namespace sek
 		constexpr void rehash(size_type capacity) { m_table.rehash(capacity); }
 		/** Resizes the internal storage to have space for at least n elements. */
 		constexpr void reserve(size_type n) { m_table.reserve(n); }
+		/** Shrinks the internal storage to fit the current size of the set.
+		 * @note For sets using pooled nodes (see `pooled_hash`), moves all values into a single contiguous page,
+		 * which invalidates pointers & references to the values. Invalidates iterators. */
+		constexpr void shrink_to_fit() { m_table.shrink_to_fit(); }
 
 		/** Constructs a value (of value_type) in-place.
 		 * If the same value is already present within the set, replaces that value.
@@ -475,6 +479,15 @@ namespace sek
 		constexpr void swap(sparse_set &other) noexcept { m_table.swap(other.m_table); }
 		friend constexpr void swap(sparse_set &a, sparse_set &b) noexcept { a.swap(b); }
 
+		/** Removes all elements that satisfy the predicate `pred` from the set in a single pass.
+		 * @return Amount of elements removed.
+		 * @note Invalidates iterators. */
+		template<typename P>
+		friend constexpr size_type erase_if(sparse_set &set, P pred)
+		{
+			return set.m_table.erase_if(pred);
+		}
+
 	private:
 		/** Hash table used to implement the set. */
 		table_type m_table;
@@ -0,0 +1,261 @@
+/*
+ * Created by switchblade on 2026-10-16
+ */
+
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+
+#include "thread_pool.hpp"
+
+namespace sek
+{
+	namespace detail
+	{
+		/* Eagerly started coroutine which destroys itself on completion. */
+		struct detached_task
+		{
+			struct promise_type
+			{
+				constexpr detached_task get_return_object() const noexcept { return {}; }
+				constexpr std::suspend_never initial_suspend() const noexcept { return {}; }
+				constexpr std::suspend_never final_suspend() const noexcept { return {}; }
+				constexpr void return_void() const noexcept {}
+				[[noreturn]] void unhandled_exception() const noexcept { std::terminate(); }
+			};
+		};
+
+		template<typename T>
+		class task_promise_base
+		{
+			struct final_awaiter
+			{
+				[[nodiscard]] constexpr bool await_ready() const noexcept { return false; }
+				template<typename P>
+				std::coroutine_handle<> await_suspend(std::coroutine_handle<P> handle) const noexcept
+				{
+					/* Resume the continuation in-place via symmetric transfer, so that awaiting a task never blocks. */
+					if (const auto next = handle.promise().m_continuation; next) [[likely]]
+						return next;
+					return std::noop_coroutine();
+				}
+				constexpr void await_resume() const noexcept {}
+			};
+
+		public:
+			constexpr std::suspend_always initial_suspend() const noexcept { return {}; }
+			constexpr final_awaiter final_suspend() const noexcept { return {}; }
+			void unhandled_exception() noexcept { m_error = std::current_exception(); }
+
+			constexpr void continuation(std::coroutine_handle<> handle) noexcept { m_continuation = handle; }
+
+		protected:
+			void rethrow_if_failed()
+			{
+				if (m_error) [[unlikely]]
+					std::rethrow_exception(std::exchange(m_error, nullptr));
+			}
+
+		private:
+			std::coroutine_handle<> m_continuation;
+			std::exception_ptr m_error;
+		};
+		template<typename T>
+		class task_promise : public task_promise_base<T>
+		{
+		public:
+			[[nodiscard]] task<T> get_return_object() noexcept;
+
+			template<typename U = T>
+			void return_value(U &&value) noexcept(std::is_nothrow_constructible_v<T, U>)
+				requires std::constructible_from<T, U>
+			{
+				m_result.emplace(std::forward<U>(value));
+			}
+			T result()
+			{
+				this->rethrow_if_failed();
+				return std::move(*m_result);
+			}
+
+		private:
+			std::optional<T> m_result;
+		};
+		template<typename T>
+		class task_promise<T &> : public task_promise_base<T &>
+		{
+		public:
+			[[nodiscard]] task<T &> get_return_object() noexcept;
+
+			constexpr void return_value(T &value) noexcept { m_result = std::addressof(value); }
+			T &result()
+			{
+				this->rethrow_if_failed();
+				return *m_result;
+			}
+
+		private:
+			T *m_result = nullptr;
+		};
+		template<>
+		class task_promise<void> : public task_promise_base<void>
+		{
+		public:
+			[[nodiscard]] inline task<void> get_return_object() noexcept;
+
+			constexpr void return_void() const noexcept {}
+			void result() { this->rethrow_if_failed(); }
+		};
+	}	 // namespace detail
+
+	/** @brief Lazily-started coroutine task.
+	 *
+	 * A task starts executing only once it is awaited (or scheduled via `thread_pool::schedule`). Once the task
+	 * is complete, the awaiting coroutine is resumed in-place on the same thread, thus a chain of tasks scheduled on
+	 * a thread pool stays on the worker threads without blocking any of them.
+	 *
+	 * @example
+	 * @code{cpp}
+	 * sek::task<int> load(sek::thread_pool &pool)
+	 * {
+	 * 	co_await pool.schedule();
+	 * 	co_return 1;
+	 * }
+	 * sek::task<int> process(sek::thread_pool &pool) { co_return co_await load(pool) + 1; }
+	 *
+	 * auto future = pool.schedule(process(pool));
+	 * @endcode */
+	template<typename T = void>
+	class task
+	{
+		template<typename>
+		friend class detail::task_promise;
+
+	public:
+		typedef detail::task_promise<T> promise_type;
+
+	private:
+		using handle_t = std::coroutine_handle<promise_type>;
+
+		class awaiter
+		{
+		public:
+			constexpr explicit awaiter(handle_t handle) noexcept : m_handle(handle) {}
+
+			[[nodiscard]] bool await_ready() const noexcept { return !m_handle || m_handle.done(); }
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<> handle) noexcept
+			{
+				/* Start the task via symmetric transfer. */
+				m_handle.promise().continuation(handle);
+				return m_handle;
+			}
+			decltype(auto) await_resume() { return m_handle.promise().result(); }
+
+		private:
+			handle_t m_handle;
+		};
+
+		constexpr explicit task(handle_t handle) noexcept : m_handle(handle) {}
+
+	public:
+		task(const task &) = delete;
+		task &operator=(const task &) = delete;
+
+		/** Initializes an empty task. */
+		constexpr task() noexcept = default;
+		constexpr task(task &&other) noexcept : m_handle(std::exchange(other.m_handle, {})) {}
+		constexpr task &operator=(task &&other) noexcept
+		{
+			swap(other);
+			return *this;
+		}
+		~task()
+		{
+			if (m_handle) m_handle.destroy();
+		}
+
+		/** Checks if the task references a coroutine. */
+		[[nodiscard]] constexpr bool valid() const noexcept { return static_cast<bool>(m_handle); }
+		/** Checks if the task has completed execution. */
+		[[nodiscard]] bool done() const noexcept { return !m_handle || m_handle.done(); }
+
+		/** Starts the task & suspends the awaiting coroutine until the task is complete.
+		 * @return Result of the task. If the task has thrown an exception, re-throws the exception.
+		 * @note Result of a task can only be retrieved once. */
+		[[nodiscard]] awaiter operator co_await() const noexcept { return awaiter{m_handle}; }
+
+		constexpr void swap(task &other) noexcept { std::swap(m_handle, other.m_handle); }
+		friend constexpr void swap(task &a, task &b) noexcept { a.swap(b); }
+
+	private:
+		handle_t m_handle;
+	};
+
+	namespace detail
+	{
+		template<typename T>
+		task<T> task_promise<T>::get_return_object() noexcept
+		{
+			return task<T>{std::coroutine_handle<task_promise>::from_promise(*this)};
+		}
+		template<typename T>
+		task<T &> task_promise<T &>::get_return_object() noexcept
+		{
+			return task<T &>{std::coroutine_handle<task_promise>::from_promise(*this)};
+		}
+		task<void> task_promise<void>::get_return_object() noexcept
+		{
+			return task<void>{std::coroutine_handle<task_promise>::from_promise(*this)};
+		}
+	}	 // namespace detail
+
+	template<typename T>
+	task_future<T> thread_pool::schedule(task<T> task, task_priority priority)
+	{
+		auto state = make_task<coroutine_state<T>>();
+		launch_task(*this, std::move(task), state, priority);
+		return task_future<T>{state};
+	}
+	template<typename T>
+	detail::detached_task thread_pool::launch_task(thread_pool &pool, task<T> task, task_state<T> *state, task_priority p)
+	{
+		/* If the coroutine is destroyed before completion (ex. if the pool is destroyed), the future is notified. */
+		struct state_guard
+		{
+			~state_guard()
+			{
+				if (state == nullptr) [[likely]]
+					return;
+
+				state->set_error(std::make_exception_ptr(std::future_error(std::future_errc::broken_promise)));
+				state->notify(task_state<T>::has_error);
+				state->release();
+			}
+
+			task_state<T> *state;
+		} guard = {state};
+
+		auto status = task_state<T>::has_value;
+		try
+		{
+			co_await pool.schedule(p);
+			if constexpr (std::is_void_v<T>)
+				co_await task;
+			else if constexpr (std::is_reference_v<T>)
+				std::construct_at(&state->result, std::addressof(co_await task));
+			else
+				std::construct_at(&state->result, co_await task);
+		}
+		catch (...)
+		{
+			state->set_error(std::current_exception());
+			status = task_state<T>::has_error;
+		}
+
+		guard.state = nullptr;
+		state->notify(status);
+		state->release();
+	}
+}	 // namespace sek
\ No newline at end of file
@@ -0,0 +1,256 @@
+/*
+ * Created by switchblade on 2026-10-16
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "assert.hpp"
+#include "thread_pool.hpp"
+
+namespace sek
+{
+	/** @brief Graph of tasks with dependencies, executed on a thread pool.
+	 *
+	 * Every node of the graph keeps an atomic counter of it's unfinished predecessors. A node is pushed to the queue of
+	 * the pool only once all of it's predecessors are complete, thus workers never block on dependencies.
+	 * Graph nodes are allocated only when the graph is built (and completion state on the first run), which allows
+	 * for the same graph to be executed repeatedly (ex. once per frame) without allocation.
+	 *
+	 * @note Graph must be acyclic, and must not be modified or destroyed while it is being executed. */
+	class task_graph
+	{
+		struct node_t : thread_pool::task_base
+		{
+			explicit node_t(task_graph *graph) noexcept : graph(graph) {}
+			virtual ~node_t() = default;
+
+			virtual void execute() = 0;
+
+			void invoke() noexcept final { graph->run_node(this, false); }
+			void discard() noexcept final { graph->run_node(this, true); }
+
+			task_graph *graph;
+			std::vector<node_t *> successors;
+			std::size_t dependencies = 0;
+			std::atomic<std::size_t> pending = 0;
+		};
+		/* Completion state is allocated separately from the graph & is shared between the graph and it's current
+		 * execution, so that the last node can notify the waiters even if the graph was destroyed in the meantime. */
+		struct state_t
+		{
+			void acquire() noexcept { ref_count.fetch_add(1, std::memory_order_relaxed); }
+			void release() noexcept
+			{
+				if (ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1) delete this;
+			}
+
+			std::atomic<std::size_t> remaining = 0;
+			std::atomic<std::size_t> ref_count = 1;
+		};
+		template<typename F>
+		struct func_node final : node_t, ebo_base_helper<F>
+		{
+			using ebo_t = ebo_base_helper<F>;
+
+			template<typename U>
+			func_node(task_graph *graph, U &&f) : node_t(graph), ebo_t(std::forward<U>(f))
+			{
+			}
+
+			void execute() final { (*ebo_t::get())(); }
+		};
+
+	public:
+		/** @brief Handle to a node of a task graph. */
+		class node
+		{
+			friend class task_graph;
+
+			constexpr explicit node(node_t *ptr) noexcept : m_ptr(ptr) {}
+
+		public:
+			constexpr node() noexcept = default;
+
+			/** Makes this node a predecessor of `other`, meaning `other` will only be executed after this node.
+			 * @return Reference to this node. */
+			node &precede(node other)
+			{
+				m_ptr->successors.push_back(other.m_ptr);
+				++other.m_ptr->dependencies;
+				return *this;
+			}
+			/** Makes this node a successor of `other`, meaning this node will only be executed after `other`.
+			 * @return Reference to this node. */
+			node &succeed(node other)
+			{
+				other.precede(*this);
+				return *this;
+			}
+
+			[[nodiscard]] constexpr bool operator==(const node &) const noexcept = default;
+
+		private:
+			node_t *m_ptr = nullptr;
+		};
+
+	public:
+		task_graph(const task_graph &) = delete;
+		task_graph &operator=(const task_graph &) = delete;
+		task_graph(task_graph &&) = delete;
+		task_graph &operator=(task_graph &&) = delete;
+
+		task_graph() noexcept = default;
+		~task_graph()
+		{
+			SEK_ASSERT(is_done(), "Task graph must not be destroyed while it is being executed");
+			clear();
+			if (m_state != nullptr) m_state->release();
+		}
+
+		/** Checks if the graph is empty. */
+		[[nodiscard]] constexpr bool empty() const noexcept { return m_nodes.empty(); }
+		/** Returns the amount of nodes in the graph. */
+		[[nodiscard]] constexpr std::size_t size() const noexcept { return m_nodes.size(); }
+
+		/** Adds a new node to the graph.
+		 * @param f Functor invoked when the node is executed.
+		 * @return Handle to the created node. */
+		template<std::invocable F>
+		node emplace(F &&f)
+		{
+			SEK_ASSERT(is_done(), "Task graph must not be modified while it is being executed");
+
+			m_nodes.reserve(m_nodes.size() + 1);
+			auto ptr = new func_node<std::decay_t<F>>(this, std::forward<F>(f));
+			m_nodes.push_back(ptr);
+			return node{ptr};
+		}
+		/** Removes all nodes from the graph. */
+		void clear()
+		{
+			SEK_ASSERT(is_done(), "Task graph must not be modified while it is being executed");
+
+			for (auto ptr : m_nodes) delete ptr;
+			m_nodes.clear();
+		}
+
+		/** Starts execution of the graph on a thread pool. Nodes without predecessors are scheduled immediately,
+		 * other nodes are scheduled once all of their predecessors have been executed.
+		 * @note If a node throws an exception, nodes that have not been started yet are skipped.
+		 * @note Nodes that could not be scheduled on the pool are executed in-place. */
+		void run(thread_pool &pool)
+		{
+			SEK_ASSERT(is_done(), "Task graph is already being executed");
+
+			if (m_state == nullptr) m_state = new state_t;
+			m_pool = &pool;
+			m_has_error.clear(std::memory_order_relaxed);
+			m_error = nullptr;
+			if (m_nodes.empty()) [[unlikely]]
+				return;
+
+			for (auto ptr : m_nodes) ptr->pending.store(ptr->dependencies, std::memory_order_relaxed);
+			m_state->remaining.store(m_nodes.size(), std::memory_order_relaxed);
+			m_state->acquire(); /* Released by the last node. */
+
+			for (auto ptr : m_nodes)
+			{
+				if (ptr->dependencies != 0) continue;
+				try
+				{
+					pool.m_cb->push_task(ptr);
+				}
+				catch (...)
+				{
+					run_node(ptr, false);
+				}
+			}
+		}
+
+		/** Checks if execution of the graph is complete. Once complete, the graph may be destroyed. */
+		[[nodiscard]] bool is_done() const noexcept
+		{
+			return m_state == nullptr || m_state->remaining.load(std::memory_order_acquire) == 0;
+		}
+		/** Blocks until execution of the graph is complete.
+		 * If any node has thrown an exception, re-throws the first exception. */
+		void wait()
+		{
+			if (m_state == nullptr) [[unlikely]]
+				return;
+
+			auto &remaining = m_state->remaining;
+			for (auto n = remaining.load(std::memory_order_acquire); n != 0; n = remaining.load(std::memory_order_acquire))
+				remaining.wait(n, std::memory_order_acquire);
+			if (m_error) [[unlikely]]
+				std::rethrow_exception(std::exchange(m_error, nullptr));
+		}
+
+	private:
+		void fail(std::exception_ptr error) noexcept
+		{
+			if (!m_has_error.test_and_set(std::memory_order_relaxed)) m_error = std::move(error);
+		}
+
+		/* Executes a node, then schedules successors that have become ready. One of the ready successors is executed
+		 * in-place, to avoid a round-trip through the queue. Discarded nodes (ex. if the pool was destroyed) are
+		 * not executed, and their successors are discarded in-place. */
+		void run_node(node_t *ptr, bool discarded) noexcept
+		{
+			for (node_t *next; ptr != nullptr; ptr = next)
+			{
+				if (discarded)
+					fail(std::make_exception_ptr(std::future_error(std::future_errc::broken_promise)));
+				else if (!m_has_error.test(std::memory_order_relaxed))
+				{
+					try
+					{
+						ptr->execute();
+					}
+					catch (...)
+					{
+						fail(std::current_exception());
+					}
+				}
+
+				next = nullptr;
+				for (auto succ : ptr->successors)
+				{
+					if (succ->pending.fetch_sub(1, std::memory_order_acq_rel) != 1) continue;
+					if (next == nullptr)
+						next = succ;
+					else if (discarded)
+						run_node(succ, true);
+					else
+					{
+						try
+						{
+							m_pool->m_cb->push_task(succ);
+						}
+						catch (...)
+						{
+							run_node(succ, false);
+						}
+					}
+				}
+
+				/* Once the last node is complete the graph may be destroyed, thus only the completion state
+				 * (which is kept alive by the execution's reference) may be accessed. */
+				if (const auto state = m_state; state->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				{
+					state->remaining.notify_all();
+					state->release();
+				}
+			}
+		}
+
+		std::vector<node_t *> m_nodes;
+		thread_pool *m_pool = nullptr;
+
+		state_t *m_state = nullptr;
+		std::atomic_flag m_has_error;
+		std::exception_ptr m_error;
+	};
+}	 // namespace sek
\ No newline at end of file
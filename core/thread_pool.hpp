@@ -4,27 +4,153 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <coroutine>
 #include <future>
 #include <mutex>
+#include <ranges>
 #include <thread>
+#include <utility>
+#include <vector>
 
 #include "define.h"
 #include "detail/ebo_base_helper.hpp"
+#include "detail/work_deque.hpp"
 #include <condition_variable>
 
 namespace sek
 {
+	template<typename>
+	class task_future;
+	template<typename>
+	class task;
+
+	namespace detail
+	{
+		struct detached_task;
+	}
+
+	/** @brief Priority lane of a task scheduled on a `thread_pool`.
+	 * Tasks of higher priority are dispatched before tasks of lower priority. */
+	enum class task_priority : std::uint8_t
+	{
+		low = 0,
+		normal = 1,
+		high = 2,
+	};
+
 	/** @brief Structure used to manage multiple worker threads.
 	 *
 	 * Thread pools provide high-level way to schedule & execute asynchronous tasks.
 	 * Thread pools manage a set of threads which wait for some work to become available.
-	 * Worker threads exist as long as the pool exists. */
+	 * Worker threads exist as long as the pool exists.
+	 *
+	 * If the `work_stealing` mode flag is set, tasks scheduled from within a worker thread are pushed to that
+	 * worker's local deque instead of the shared queue, and idle workers steal tasks from the deques of other workers.
+	 * This avoids contention on the shared queue when tasks spawn other tasks.
+	 *
+	 * Every task is scheduled to one of the priority lanes. High-priority lanes are drained first, however a
+	 * non-empty lower lane is served once it has been skipped `starvation_limit` times in a row. Tasks may also be
+	 * scheduled with a deadline, such tasks are dispatched ahead of other tasks of the same lane in earliest-deadline
+	 * order, and are dispatched ahead of all lanes once the deadline has passed. */
 	class thread_pool
 	{
+		template<typename>
+		friend class task_future;
+		friend class task_graph;
+
 	public:
 		typedef int queue_mode;
 		constexpr static queue_mode fifo = 0;
 		constexpr static queue_mode filo = 1;
+		/** Flag used to enable per-worker task deques & work stealing. Can be combined with `fifo` or `filo`. */
+		constexpr static queue_mode work_stealing = 2;
+
+		typedef std::chrono::steady_clock::time_point time_point;
+		/** Amount of priority lanes of a thread pool. */
+		constexpr static std::size_t priority_levels = 3;
+		/** Default amount of times a non-empty lane may be skipped in favor of higher lanes. */
+		constexpr static std::size_t default_starvation_limit = 16;
+
+		/** @brief Placement of worker threads on CPUs. */
+		enum class affinity_mode : std::uint8_t
+		{
+			/** Worker threads are not pinned. */
+			none,
+			/** Every worker thread is pinned to a single CPU. */
+			cpu,
+			/** Every worker thread is pinned to all CPUs of a NUMA node. */
+			numa_node,
+		};
+
+		/** Hook invoked by a worker thread before or after execution of a task.
+		 * Receives id of the worker & an opaque pointer identifying the task. The task must not be accessed through
+		 * the pointer, since it may already be destroyed once the end hook is invoked. */
+		typedef void (*task_hook)(std::size_t worker, const void *task) noexcept;
+
+		/** @brief Configuration of worker threads.
+		 *
+		 * Idle workers first spin (issuing a CPU pause hint), then yield their time slice, and only then park until a
+		 * task becomes available. Spinning avoids the latency of a wake-up for short bursts of tasks, at the expense
+		 * of CPU time. By default idle workers are parked immediately.
+		 *
+		 * If CPU affinity is enabled, workers are distributed round-robin across NUMA nodes of the system, so that
+		 * workers of a large pool are spread evenly between nodes. Affinity is only supported on Linux, and is
+		 * ignored on other platforms. */
+		struct worker_config
+		{
+			/** Amount of spin iterations an idle worker performs before it starts yielding. */
+			std::uint32_t spin_count = 0;
+			/** Amount of times an idle worker yields before it is parked. */
+			std::uint32_t yield_count = 0;
+			/** Placement of worker threads on CPUs. */
+			affinity_mode affinity = affinity_mode::none;
+
+			/** Enables collection of busy & idle time and enqueue-to-start latency.
+			 * Time statistics require reading the clock when a task is queued, started & completed. */
+			bool measure_time = false;
+			/** Hook invoked by a worker before a task is executed. */
+			task_hook on_task_begin = nullptr;
+			/** Hook invoked by a worker after a task is executed. */
+			task_hook on_task_end = nullptr;
+		};
+
+		/** Amount of buckets of the latency histogram. Bucket 0 counts latencies below 1us, bucket `i` counts
+		 * latencies in range [2^(i-1), 2^i) us, and the last bucket counts all greater latencies. */
+		constexpr static std::size_t latency_buckets = 24;
+
+		/** @brief Statistics of a single worker.
+		 * Statistics are tied to the worker's task deque, thus a worker started after another worker was terminated
+		 * may continue the statistics of the terminated worker. */
+		struct worker_stats
+		{
+			/** Id of the worker, as passed to task hooks. */
+			std::size_t id;
+			/** Amount of tasks executed by the worker. */
+			std::uint64_t tasks_executed;
+			/** Amount of attempts to steal a task from other workers. */
+			std::uint64_t steal_attempts;
+			/** Amount of successfully stolen tasks. */
+			std::uint64_t steals;
+			/** Time spent executing tasks. Only collected if `measure_time` is enabled. */
+			std::chrono::nanoseconds busy_time;
+			/** Time spent waiting for tasks. Only collected if `measure_time` is enabled. */
+			std::chrono::nanoseconds idle_time;
+			/** Maximum amount of tasks in the worker's local deque. */
+			std::size_t queue_high_water;
+			/** Histogram of enqueue-to-start latency. Only collected if `measure_time` is enabled. */
+			std::array<std::uint64_t, latency_buckets> latency;
+		};
+		/** @brief Snapshot of statistics of a thread pool. */
+		struct pool_stats
+		{
+			/** Statistics of individual workers. */
+			std::vector<worker_stats> workers;
+			/** Maximum amount of tasks in the shared queue. */
+			std::size_t queue_high_water;
+		};
 
 	private:
 		struct task_node
@@ -54,20 +180,148 @@ namespace sek
 				task_node *previous;
 			};
 		};
+		/* Base type of all queued tasks. Tasks are responsible for releasing themselves after execution. */
 		struct task_base : task_node
 		{
-			virtual ~task_base() = default;
-			virtual task_base *invoke() noexcept = 0;
+			/* Executes the task. */
+			virtual void invoke() noexcept = 0;
+			/* Releases a task that will never be executed. */
+			virtual void discard() noexcept = 0;
+
+			/* Used only while the task is queued. */
+			time_point deadline = time_point::max();
+			time_point queued_at = {};
+			task_priority priority = task_priority::normal;
 		};
-		template<typename T, typename F, typename U = std::decay_t<F>>
-		struct task_t final : task_base, ebo_base_helper<F>
+
+		/* Shared state of a task, referenced by both the task & the `task_future`. */
+		template<typename T>
+		struct task_state : task_base
+		{
+			// clang-format off
+			using result_t = std::conditional_t<std::is_void_v<T>, std::nullptr_t,
+							 std::conditional_t<std::is_reference_v<T>, std::add_pointer_t<std::remove_reference_t<T>>, T>>;
+			// clang-format on
+
+			constexpr static std::uint32_t pending = 0;
+			constexpr static std::uint32_t has_value = 1;
+			constexpr static std::uint32_t has_error = 2;
+
+			task_state() noexcept {}
+			~task_state()
+			{
+				if (const auto s = status.load(std::memory_order_relaxed); s == has_value)
+					std::destroy_at(&result);
+				else if (s == has_error)
+					std::destroy_at(&error);
+			}
+
+			/* Destroys the task & releases it's storage. */
+			virtual void destroy() noexcept = 0;
+
+			void release() noexcept
+			{
+				if (ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1) destroy();
+			}
+
+			template<typename F>
+			void set_value(F &f)
+			{
+				if constexpr (std::is_void_v<T>)
+					f();
+				else if constexpr (std::is_reference_v<T>)
+					std::construct_at(&result, std::addressof(f()));
+				else
+					std::construct_at(&result, f());
+			}
+			void set_error(std::exception_ptr ptr) noexcept { std::construct_at(&error, std::move(ptr)); }
+			void notify(std::uint32_t s) noexcept
+			{
+				status.store(s, std::memory_order_release);
+				status.notify_all();
+			}
+
+			[[nodiscard]] bool is_ready() const noexcept { return status.load(std::memory_order_acquire) != pending; }
+			void wait() const noexcept
+			{
+				for (auto s = status.load(std::memory_order_acquire); s == pending; s = status.load(std::memory_order_acquire))
+					status.wait(s, std::memory_order_acquire);
+			}
+			T get()
+			{
+				wait();
+				if (status.load(std::memory_order_relaxed) == has_error) [[unlikely]]
+					std::rethrow_exception(error);
+
+				if constexpr (std::is_reference_v<T>)
+					return static_cast<T>(*result);
+				else if constexpr (!std::is_void_v<T>)
+					return std::move(result);
+			}
+
+			std::atomic<std::uint32_t> status = pending;
+			std::atomic<std::uint32_t> ref_count = 2; /* One for the task & one for the future. */
+			union
+			{
+				result_t result;
+				std::exception_ptr error;
+			};
+		};
+
+		/* Task used to implement `schedule`, stores the result within the task node. */
+		template<typename T, typename F>
+		struct future_task final : task_state<T>
+		{
+			template<typename U>
+			explicit future_task(U &&f) : func(std::forward<U>(f))
+			{
+			}
+			~future_task() {}
+
+			void invoke() noexcept final
+			{
+				auto s = task_state<T>::has_value;
+				try
+				{
+					this->set_value(func);
+				}
+				catch (...)
+				{
+					this->set_error(std::current_exception());
+					s = task_state<T>::has_error;
+				}
+
+				/* Release functor state before the result is made available. */
+				std::destroy_at(&func);
+				this->notify(s);
+				this->release();
+			}
+			void discard() noexcept final
+			{
+				std::destroy_at(&func);
+				this->set_error(std::make_exception_ptr(std::future_error(std::future_errc::broken_promise)));
+				this->notify(task_state<T>::has_error);
+				this->release();
+			}
+			void destroy() noexcept final { destroy_task(this); }
+
+			union
+			{
+				F func;
+			};
+		};
+		/* Task used to implement `schedule` with a user-provided promise. */
+		template<typename T, typename F>
+		struct promise_task final : task_base, ebo_base_helper<F>
 		{
 			using ebo_t = ebo_base_helper<F>;
 
-			task_t(std::promise<T> &&p, F &&f) : ebo_t(std::forward<F>(f)), promise(std::forward<std::promise<T>>(p)) {}
-			~task_t() final = default;
+			template<typename U>
+			promise_task(std::promise<T> &&p, U &&f) : ebo_t(std::forward<U>(f)), promise(std::move(p))
+			{
+			}
 
-			task_base *invoke() noexcept final
+			void invoke() noexcept final
 			{
 				try
 				{
@@ -84,21 +338,187 @@ namespace sek
 				{
 					promise.set_exception(std::current_exception());
 				}
-				return this;
+				destroy_task(this);
 			}
+			void discard() noexcept final { destroy_task(this); }
 
 			std::promise<T> promise;
 		};
+		/* Fire-and-forget task used to implement `post`. */
+		template<typename F>
+		struct post_task final : task_base, ebo_base_helper<F>
+		{
+			using ebo_t = ebo_base_helper<F>;
+
+			template<typename U>
+			explicit post_task(U &&f) : ebo_t(std::forward<U>(f))
+			{
+			}
+
+			void invoke() noexcept final
+			{
+				try
+				{
+					(*ebo_t::get())();
+				}
+				catch (...)
+				{
+					unhandled_exception();
+				}
+				destroy_task(this);
+			}
+			void discard() noexcept final { destroy_task(this); }
+		};
+
+		/* Small tasks are allocated from a per-thread pool of fixed-size blocks, other tasks are allocated on the heap. */
+		constexpr static std::size_t task_block_size = 112;
+
+		template<typename Task>
+		constexpr static bool is_pooled_task = sizeof(Task) <= task_block_size && alignof(Task) <= alignof(std::max_align_t);
+
+		struct task_slab;
+
+		SEK_CORE_PUBLIC static void *allocate_task_block();
+		SEK_CORE_PUBLIC static void deallocate_task_block(void *ptr) noexcept;
+		SEK_CORE_PUBLIC static void unhandled_exception() noexcept;
+
+		template<typename Task, typename... Args>
+		static Task *make_task(Args &&...args)
+		{
+			if constexpr (is_pooled_task<Task>)
+			{
+				auto ptr = allocate_task_block();
+				try
+				{
+					return std::construct_at(static_cast<Task *>(ptr), std::forward<Args>(args)...);
+				}
+				catch (...)
+				{
+					deallocate_task_block(ptr);
+					throw;
+				}
+			}
+			else
+				return new Task(std::forward<Args>(args)...);
+		}
+		template<typename Task>
+		static void destroy_task(Task *task) noexcept
+		{
+			if constexpr (is_pooled_task<Task>)
+			{
+				std::destroy_at(task);
+				deallocate_task_block(task);
+			}
+			else
+				delete task;
+		}
+
+		/* State of a coroutine task scheduled via `schedule(task<T>)`. The state is never queued itself. */
+		template<typename T>
+		struct coroutine_state final : task_state<T>
+		{
+			void invoke() noexcept final {}
+			void discard() noexcept final {}
+			void destroy() noexcept final { destroy_task(this); }
+		};
+
+		template<typename T>
+		static detail::detached_task launch_task(thread_pool &pool, task<T> task, task_state<T> *state, task_priority p);
 
 		struct control_block;
 
+		/* Chain of tasks submitted at once. Tasks are linked newest-first, in the same order as within a lane. */
+		struct task_batch
+		{
+			void push(task_base *task) noexcept
+			{
+				task->previous = nullptr;
+				task->next = front;
+				if (front != nullptr)
+					front->previous = task;
+				else
+					back = task;
+				front = task;
+				++size;
+			}
+			void discard() noexcept
+			{
+				for (auto task = back; task != nullptr;)
+					static_cast<task_base *>(std::exchange(task, task->previous))->discard(); // NOLINT
+			}
+
+			task_node *front = nullptr;
+			task_node *back = nullptr;
+			std::size_t size = 0;
+		};
+
+		/* Shared queue of a single priority. Tasks with a deadline are kept in a separate list sorted by deadline. */
+		struct task_lane
+		{
+			task_node queue = {.front = &queue, .back = &queue};
+			task_node deadlines = {.front = &deadlines, .back = &deadlines};
+			std::atomic<std::size_t> size = 0;
+			std::size_t skipped = 0; /* Amount of consecutive dispatches from higher lanes while non-empty. */
+		};
+
+		/* Counters of a worker. Counters are only modified by the owning worker, thus relaxed load-store pairs are
+		 * used instead of read-modify-write operations. */
+		struct alignas(64) worker_counters
+		{
+			static void add(std::atomic<std::uint64_t> &counter, std::uint64_t n) noexcept
+			{
+				counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+			}
+			static void max(std::atomic<std::uint64_t> &counter, std::uint64_t n) noexcept
+			{
+				if (n > counter.load(std::memory_order_relaxed)) counter.store(n, std::memory_order_relaxed);
+			}
+
+			std::atomic<std::uint64_t> tasks_executed = 0;
+			std::atomic<std::uint64_t> steal_attempts = 0;
+			std::atomic<std::uint64_t> steals = 0;
+			std::atomic<std::uint64_t> busy_ns = 0;
+			std::atomic<std::uint64_t> idle_ns = 0;
+			std::atomic<std::uint64_t> queue_high_water = 0;
+			std::atomic<std::uint64_t> latency[latency_buckets] = {};
+		};
+
+		/* Per-worker task deque. Deques are owned by the control block and are re-used by new workers. */
+		struct worker_queue : detail::work_deque<task_base>
+		{
+			void push(task_base *task)
+			{
+				work_deque::push(task);
+				worker_counters::max(stats.queue_high_water, size());
+			}
+
+			worker_queue *next = nullptr; /* Immutable once the queue is published. */
+			std::size_t id = 0;			  /* Immutable once the queue is published. */
+			bool in_use = true;			  /* Guarded by `control_block::mtx`. */
+
+			worker_counters stats;
+		};
+
 		/* Custom worker instead of std::jthread since jthread joins on destruction, and we need to detach. */
 		struct worker_t
 		{
 			static void thread_main(std::stop_token, control_block *) noexcept;
 
 			worker_t(worker_t &&other) noexcept : source(std::move(other.source)), thread(std::move(other.thread)) {}
-			explicit worker_t(control_block *cb) : thread(thread_main, source.get_token(), cb) {}
+			explicit worker_t(control_block *cb)
+			{
+				/* Acquire the control block before the thread is started, in case the pool is destroyed immediately. */
+				cb->acquire();
+				try
+				{
+					thread = std::thread(thread_main, source.get_token(), cb);
+				}
+				catch (...)
+				{
+					cb->release();
+					throw;
+				}
+			}
 			~worker_t()
 			{
 				/* Detach the thread to let the worker terminate on it's own. */
@@ -116,37 +536,124 @@ namespace sek
 		/* Worker threads may outlive the pool, thus the control block must live as long as any worker lives. */
 		struct control_block
 		{
-			SEK_CORE_PUBLIC control_block(std::size_t n, queue_mode mode);
+			SEK_CORE_PUBLIC control_block(std::size_t n, queue_mode mode, const worker_config &config);
 			SEK_CORE_PUBLIC ~control_block();
 
 			SEK_CORE_PUBLIC void resize(std::size_t n);
+			SEK_CORE_PUBLIC void configure(const worker_config &config);
 			SEK_CORE_PUBLIC void terminate();
 			SEK_CORE_PUBLIC void acquire();
 			SEK_CORE_PUBLIC void release();
 
 			template<typename T, typename F>
-			std::future<T> schedule(std::promise<T> &&promise, F &&task)
+			task_future<T> schedule(F &&f, task_priority priority, time_point deadline)
+			{
+				auto task = make_task<future_task<T, std::decay_t<F>>>(std::forward<F>(f));
+				task->deadline = deadline;
+
+				/* Create the future before pushing the task, so that the future's reference is released if the
+				 * task is discarded. */
+				auto result = task_future<T>{task};
+				push_or_discard(task, priority);
+				return result;
+			}
+			template<typename T, typename F>
+			std::future<T> schedule(std::promise<T> &&promise, F &&f, task_priority priority, time_point deadline)
+			{
+				auto result = promise.get_future();
+				auto task = make_task<promise_task<T, std::decay_t<F>>>(std::move(promise), std::forward<F>(f));
+				task->deadline = deadline;
+				push_or_discard(task, priority);
+				return result;
+			}
+			template<typename F>
+			void post(F &&f, task_priority priority, time_point deadline)
 			{
-				std::future<T> result;
+				auto task = make_task<post_task<std::decay_t<F>>>(std::forward<F>(f));
+				task->deadline = deadline;
+				push_or_discard(task, priority);
+			}
+			template<typename T, typename R>
+			std::vector<task_future<T>> schedule_bulk(R &&range, task_priority priority)
+			{
+				std::vector<task_future<T>> result;
+				if constexpr (std::ranges::sized_range<R>) result.reserve(std::ranges::size(range));
+
+				task_batch batch;
+				try
 				{
-					std::lock_guard<std::mutex> l(mtx);
+					for (auto &&f : range)
+					{
+						using task_t = future_task<T, std::decay_t<decltype(f)>>;
+						auto task = make_task<task_t>(std::forward<decltype(f)>(f));
 
-					auto node = new task_t<T, F>(std::forward<std::promise<T>>(promise), std::forward<F>(task));
-					result = node->promise.get_future();
-					node->link_after(queue_head);
+						/* Create the future before pushing it to the result, so that the future's reference
+						 * is released if the result fails to grow. */
+						auto future = task_future<T>{task};
+						batch.push(task);
+						result.push_back(std::move(future));
+					}
+				}
+				catch (...)
+				{
+					batch.discard();
+					throw;
 				}
-				cv.notify_one();
+				push_batch(batch, priority);
 				return result;
 			}
+			template<typename R>
+			void post_bulk(R &&range, task_priority priority)
+			{
+				task_batch batch;
+				try
+				{
+					for (auto &&f : range)
+						batch.push(make_task<post_task<std::decay_t<decltype(f)>>>(std::forward<decltype(f)>(f)));
+				}
+				catch (...)
+				{
+					batch.discard();
+					throw;
+				}
+				push_batch(batch, priority);
+			}
+			SEK_CORE_PUBLIC void push_task(task_base *task, task_priority priority = task_priority::normal);
+			/* Discards the task (which destroys it & releases it's state) if it could not be pushed. */
+			void push_or_discard(task_base *task, task_priority priority)
+			{
+				try
+				{
+					push_task(task, priority);
+				}
+				catch (...)
+				{
+					task->discard();
+					throw;
+				}
+			}
+			SEK_CORE_PUBLIC void push_batch(task_batch &batch, task_priority priority) noexcept;
+			void notify_idle(std::size_t n) noexcept;
+			SEK_CORE_PUBLIC std::size_t queue_depth(task_priority priority) const noexcept;
+			SEK_CORE_PUBLIC pool_stats stats() const;
 
 			void destroy_workers(worker_t *first, worker_t *last);
 			void realloc_workers(std::size_t n);
+			void pin_worker(worker_t &worker, std::size_t idx) const noexcept;
 
-			task_base *pop_task() noexcept
-			{
-				// NOLINTNEXTLINE static cast is fine here since there is no virtual inheritance
-				return static_cast<task_base *>((dispatch_mode == fifo ? queue_head.back : queue_head.front)->unlink());
-			}
+			worker_queue *attach_queue();
+			void detach_queue(worker_queue *queue);
+
+			[[nodiscard]] bool has_tasks() const noexcept;
+			task_base *pop_task(bool urgent) noexcept;
+			task_base *pop_lane(task_lane &lane) noexcept;
+			task_base *pop_local(worker_queue *queue) noexcept;
+			task_base *pop_global(bool urgent) noexcept;
+			task_base *steal_task(worker_queue *queue, std::uint32_t &seed) noexcept;
+			task_base *spin_task(worker_queue *queue, std::uint32_t &seed, std::stop_token &st) noexcept;
+			task_base *wait_task(std::stop_token &st) noexcept;
+			void execute_task(worker_queue *queue, task_base *task, time_point &last) noexcept;
+			void update_high_water() noexcept;
 
 			std::atomic<std::size_t> ref_count = 1;
 
@@ -157,8 +664,74 @@ namespace sek
 			std::size_t workers_capacity = 0;
 			std::size_t workers_count = 0;
 
-			task_node queue_head = {.front = &queue_head, .back = &queue_head};
-			queue_mode dispatch_mode;
+			std::atomic<std::uint32_t> spin_count;
+			std::atomic<std::uint32_t> yield_count;
+			affinity_mode affinity;
+
+			std::atomic<bool> measure_time;
+			std::atomic<task_hook> begin_hook;
+			std::atomic<task_hook> end_hook;
+			std::atomic<std::size_t> queue_high_water = 0;
+
+			/* Shared queues are guarded by `mtx`, queue sizes are used to check for tasks without locking. */
+			task_lane lanes[priority_levels];
+			std::atomic<std::size_t> queue_size = 0;
+			std::atomic<std::size_t> deadline_count = 0;
+			std::atomic<std::size_t> starvation_limit = default_starvation_limit;
+			std::atomic<queue_mode> dispatch_mode;
+
+			/* Worker deques form an append-only list to allow lock-free iteration by thieves. */
+			std::atomic<worker_queue *> queues_head = nullptr;
+			std::atomic<std::size_t> queues_count = 0;
+			std::atomic<std::size_t> idle_count = 0;
+		};
+
+	public:
+		/** @brief Awaitable used to resume a coroutine on one of the worker threads.
+		 * The awaiter itself is queued as a task, thus scheduling a coroutine does not allocate. */
+		class schedule_awaiter : task_base
+		{
+			friend class thread_pool;
+
+			constexpr schedule_awaiter(control_block *cb, task_priority priority) noexcept
+				: m_cb(cb), m_priority(priority)
+			{
+			}
+
+		public:
+			schedule_awaiter(const schedule_awaiter &) = delete;
+			schedule_awaiter &operator=(const schedule_awaiter &) = delete;
+
+			[[nodiscard]] constexpr bool await_ready() const noexcept { return false; }
+			void await_suspend(std::coroutine_handle<> handle)
+			{
+				m_handle = handle;
+				m_cb->push_task(this, m_priority);
+			}
+			/** @throw std::future_error With `broken_promise` error code if the pool was destroyed before the
+			 * coroutine could be resumed. */
+			void await_resume() const
+			{
+				if (m_discarded) [[unlikely]]
+					throw std::future_error(std::future_errc::broken_promise);
+			}
+
+		private:
+			/* The awaiter is a part of the coroutine frame, thus it must not be accessed after the coroutine is resumed. */
+			void invoke() noexcept final { m_handle.resume(); }
+			/* The coroutine frame may be owned by another coroutine (ex. a task awaited by `launch_task`), thus it
+			 * can not be destroyed directly. Instead, resume the coroutine with an error, so that it is unwound by
+			 * it's owner. */
+			void discard() noexcept final
+			{
+				m_discarded = true;
+				m_handle.resume();
+			}
+
+			control_block *m_cb;
+			task_priority m_priority;
+			bool m_discarded = false;
+			std::coroutine_handle<> m_handle;
 		};
 
 	public:
@@ -172,7 +745,15 @@ namespace sek
 		/** Initializes thread pool with n threads & the specified queue mode.
 		 * @param n Amount of worker threads to initialize the pool with. If set to 0 will use `std::thread::hardware_concurrency` workers.
 		 * @param mode Queue mode used for task dispatch. Default is FIFO. */
-		explicit thread_pool(std::size_t n, queue_mode mode = fifo) : m_cb(new control_block(n, mode)) {}
+		explicit thread_pool(std::size_t n, queue_mode mode = fifo) : thread_pool(n, mode, worker_config{}) {}
+		/** Initializes thread pool with n threads, the specified queue mode & worker configuration.
+		 * @param n Amount of worker threads to initialize the pool with. If set to 0 will use `std::thread::hardware_concurrency` workers.
+		 * @param mode Queue mode used for task dispatch.
+		 * @param config Configuration of worker threads. */
+		thread_pool(std::size_t n, queue_mode mode, const worker_config &config)
+			: m_cb(new control_block(n, mode, config))
+		{
+		}
 		/** Terminates all worker threads & releases internal state. */
 		~thread_pool()
 		{
@@ -181,35 +762,221 @@ namespace sek
 		}
 
 		/** Returns the current queue dispatch mode of the pool. */
-		[[nodiscard]] constexpr queue_mode mode() const noexcept { return m_cb->dispatch_mode; }
+		[[nodiscard]] queue_mode mode() const noexcept { return m_cb->dispatch_mode.load(std::memory_order_relaxed); }
 		/** Sets pool's queue dispatch mode. */
-		constexpr void mode(queue_mode mode) noexcept { m_cb->dispatch_mode = mode; }
+		void mode(queue_mode mode) noexcept { m_cb->dispatch_mode.store(mode, std::memory_order_relaxed); }
+
+		/** Returns the current worker configuration of the pool. */
+		[[nodiscard]] worker_config config() const noexcept
+		{
+			return {
+				.spin_count = m_cb->spin_count.load(std::memory_order_relaxed),
+				.yield_count = m_cb->yield_count.load(std::memory_order_relaxed),
+				.affinity = m_cb->affinity,
+				.measure_time = m_cb->measure_time.load(std::memory_order_relaxed),
+				.on_task_begin = m_cb->begin_hook.load(std::memory_order_relaxed),
+				.on_task_end = m_cb->end_hook.load(std::memory_order_relaxed),
+			};
+		}
+		/** Sets worker configuration of the pool. Existing workers are re-pinned according to the new affinity mode. */
+		void config(const worker_config &config) { m_cb->configure(config); }
 
 		/** Returns the current amount of worker threads in the pool. */
 		[[nodiscard]] constexpr std::size_t size() const noexcept { return m_cb->workers_count; }
 		/** Resizes the pool to n workers. If n is set to 0, uses `std::thread::hardware_concurrency` workers. */
 		void resize(std::size_t n) { m_cb->resize(n); }
 
+		/** Returns the amount of times a non-empty lane may be skipped in favor of higher-priority lanes. */
+		[[nodiscard]] std::size_t starvation_limit() const noexcept
+		{
+			return m_cb->starvation_limit.load(std::memory_order_relaxed);
+		}
+		/** Sets the amount of times a non-empty lane may be skipped in favor of higher-priority lanes.
+		 * Once a lane is skipped `n` times in a row, the next task is dispatched from that lane. */
+		void starvation_limit(std::size_t n) noexcept { m_cb->starvation_limit.store(n, std::memory_order_relaxed); }
+
+		/** Returns a snapshot of statistics of the pool. Statistics are collected without synchronization,
+		 * thus the snapshot is approximate if workers are active. */
+		[[nodiscard]] pool_stats stats() const { return m_cb->stats(); }
+
+		/** Returns approximate amount of tasks queued in a priority lane (including tasks in worker deques). */
+		[[nodiscard]] std::size_t queue_depth(task_priority priority) const noexcept
+		{
+			return m_cb->queue_depth(priority);
+		}
+
 		/** Schedules a task to be executed by one of the worker threads.
-		 * Tasks are dispatched according to the current queue mode.
+		 * Tasks are dispatched according to the current queue mode. If work stealing is enabled and
+		 * the calling thread is a worker of this pool, normal-priority tasks are pushed to the worker's local deque.
 		 * @param task Functor to execute on one of the worker threads.
-		 * @return `std::future` used to retrieve task result or exceptions.
-		 * @note Task functor must be invocable with 0 arguments. */
+		 * @param priority Priority lane of the task.
+		 * @return `task_future` used to retrieve task result or exceptions.
+		 * @note Task functor must be invocable with 0 arguments.
+		 * @note Small tasks are allocated from a per-thread pool, and the result is stored within the task itself. */
+		template<std::invocable F>
+		task_future<std::invoke_result_t<F>> schedule(F &&task, task_priority priority = task_priority::normal)
+		{
+			return m_cb->schedule<std::invoke_result_t<F>>(std::forward<F>(task), priority, time_point::max());
+		}
+		/** Schedules a task with a deadline to be executed by one of the worker threads.
+		 * Tasks with a deadline are dispatched before other tasks of the same lane in earliest-deadline order,
+		 * and once the deadline has passed, before tasks of all lanes.
+		 * @param task Functor to execute on one of the worker threads.
+		 * @param deadline Point in time by which the task should be started.
+		 * @param priority Priority lane of the task.
+		 * @return `task_future` used to retrieve task result or exceptions. */
 		template<std::invocable F>
-		std::future<std::invoke_result_t<F>> schedule(F &&task)
+		task_future<std::invoke_result_t<F>> schedule(F &&task,
+													   time_point deadline,
+													   task_priority priority = task_priority::normal)
 		{
-			return schedule(std::promise<std::invoke_result_t<F>>{}, std::forward<F>(task));
+			return m_cb->schedule<std::invoke_result_t<F>>(std::forward<F>(task), priority, deadline);
 		}
-		/** @copydoc schedule
+		/** Schedules a task to be executed by one of the worker threads.
 		 * @param promise Promise used to store task's result & exceptions.
+		 * @param task Functor to execute on one of the worker threads.
+		 * @param priority Priority lane of the task.
+		 * @return `std::future` used to retrieve task result or exceptions.
 		 * @note Task's return type must be implicitly convertible to the promised type. */
 		template<typename T, std::invocable F>
-		std::future<T> schedule(std::promise<T> &&promise, F &&task)
+		std::future<T> schedule(std::promise<T> &&promise, F &&task, task_priority priority = task_priority::normal)
+		{
+			return m_cb->schedule(std::move(promise), std::forward<F>(task), priority, time_point::max());
+		}
+		/** Schedules a task with a deadline to be executed by one of the worker threads.
+		 * @param promise Promise used to store task's result & exceptions.
+		 * @param task Functor to execute on one of the worker threads.
+		 * @param deadline Point in time by which the task should be started.
+		 * @param priority Priority lane of the task.
+		 * @return `std::future` used to retrieve task result or exceptions. */
+		template<typename T, std::invocable F>
+		std::future<T> schedule(std::promise<T> &&promise,
+								F &&task,
+								time_point deadline,
+								task_priority priority = task_priority::normal)
+		{
+			return m_cb->schedule(std::move(promise), std::forward<F>(task), priority, deadline);
+		}
+		/** Schedules a batch of tasks to be executed by worker threads.
+		 * Unlike calling `schedule` for every task, the whole batch is queued at once, and at most
+		 * `min(N, idle workers)` workers are woken up.
+		 * @param tasks Range of functors to execute on worker threads. Functors are forwarded from the range,
+		 * thus elements of an rvalue range (ex. `std::views::as_rvalue`) are moved.
+		 * @param priority Priority lane of the tasks.
+		 * @return Vector of `task_future`s used to retrieve results or exceptions of the tasks, in range order. */
+		template<std::ranges::input_range R>
+		auto schedule_bulk(R &&tasks, task_priority priority = task_priority::normal)
+			requires std::invocable<std::ranges::range_reference_t<R>>
+		{
+			using result_t = std::invoke_result_t<std::ranges::range_reference_t<R>>;
+			return m_cb->schedule_bulk<result_t>(std::forward<R>(tasks), priority);
+		}
+		/** Returns an awaitable used to resume the awaiting coroutine on one of the worker threads.
+		 * @param priority Priority lane used to resume the coroutine.
+		 * @example
+		 * @code{cpp}
+		 * co_await pool.schedule();
+		 * // Coroutine continues on one of the worker threads.
+		 * @endcode */
+		[[nodiscard]] schedule_awaiter schedule(task_priority priority = task_priority::normal) noexcept
 		{
-			return m_cb->schedule(std::forward<std::promise<T>>(promise), std::forward<F>(task));
+			return schedule_awaiter{m_cb, priority};
+		}
+		/** Schedules a coroutine task to be executed by one of the worker threads.
+		 * @param task Coroutine task to execute. The task is started on one of the worker threads.
+		 * @param priority Priority lane used to start the task.
+		 * @return `task_future` used to retrieve task result or exceptions.
+		 * @note Defined in `task.hpp`. */
+		template<typename T>
+		task_future<T> schedule(task<T> task, task_priority priority = task_priority::normal);
+
+		/** Schedules a fire-and-forget task to be executed by one of the worker threads.
+		 * Unlike `schedule`, does not create a future. Exceptions thrown by the task are logged & discarded.
+		 * @param task Functor to execute on one of the worker threads.
+		 * @param priority Priority lane of the task. */
+		template<std::invocable F>
+		void post(F &&task, task_priority priority = task_priority::normal)
+		{
+			m_cb->post(std::forward<F>(task), priority, time_point::max());
+		}
+		/** Schedules a batch of fire-and-forget tasks to be executed by worker threads.
+		 * Unlike calling `post` for every task, the whole batch is queued at once.
+		 * @param tasks Range of functors to execute on worker threads.
+		 * @param priority Priority lane of the tasks. */
+		template<std::ranges::input_range R>
+		void post_bulk(R &&tasks, task_priority priority = task_priority::normal)
+			requires std::invocable<std::ranges::range_reference_t<R>>
+		{
+			m_cb->post_bulk(std::forward<R>(tasks), priority);
+		}
+		/** Schedules a fire-and-forget task with a deadline to be executed by one of the worker threads.
+		 * @param task Functor to execute on one of the worker threads.
+		 * @param deadline Point in time by which the task should be started.
+		 * @param priority Priority lane of the task. */
+		template<std::invocable F>
+		void post(F &&task, time_point deadline, task_priority priority = task_priority::normal)
+		{
+			m_cb->post(std::forward<F>(task), priority, deadline);
 		}
 
 	private:
 		control_block *m_cb;
 	};
+
+	/** @brief Lightweight future used to retrieve result of a task scheduled via `thread_pool::schedule`.
+	 *
+	 * Unlike `std::future`, task futures do not allocate a separate shared state,
+	 * instead the result is stored within the task itself. */
+	template<typename T>
+	class task_future
+	{
+		friend class thread_pool;
+
+		using state_t = thread_pool::task_state<T>;
+
+		constexpr explicit task_future(state_t *state) noexcept : m_state(state) {}
+
+	public:
+		task_future(const task_future &) = delete;
+		task_future &operator=(const task_future &) = delete;
+
+		/** Initializes an empty (invalid) future. */
+		constexpr task_future() noexcept = default;
+		constexpr task_future(task_future &&other) noexcept : m_state(std::exchange(other.m_state, nullptr)) {}
+		constexpr task_future &operator=(task_future &&other) noexcept
+		{
+			swap(other);
+			return *this;
+		}
+		~task_future()
+		{
+			if (m_state != nullptr) m_state->release();
+		}
+
+		/** Checks if the future references a task. */
+		[[nodiscard]] constexpr bool valid() const noexcept { return m_state != nullptr; }
+		/** Checks if the result of the task is available. */
+		[[nodiscard]] bool is_ready() const noexcept { return m_state->is_ready(); }
+
+		/** Blocks until the result of the task is available. */
+		void wait() const noexcept { m_state->wait(); }
+		/** Blocks until the result of the task is available, then returns it (or re-throws the exception).
+		 * Future becomes invalid after the call to `get`. */
+		T get()
+		{
+			auto state = std::exchange(m_state, nullptr);
+			struct releaser
+			{
+				~releaser() { state->release(); }
+				state_t *state;
+			} r = {state};
+			return state->get();
+		}
+
+		constexpr void swap(task_future &other) noexcept { std::swap(m_state, other.m_state); }
+		friend constexpr void swap(task_future &a, task_future &b) noexcept { a.swap(b); }
+
+	private:
+		state_t *m_state = nullptr;
+	};
 }	 // namespace sek
\ No newline at end of file
@@ -0,0 +1,91 @@
+/*
+ * Created by switchblade on 2026-10-16
+ */
+
+#include <core/buffered_vector.hpp>
+
+#include "tests.hpp"
+#include <list>
+#include <string>
+#include <vector>
+
+void test_buffered_vector()
+{
+	sek::buffered_vector<int, 4> ints;
+	SEK_ASSERT_ALWAYS(ints.empty() && ints.local());
+	SEK_ASSERT_ALWAYS(ints.capacity() == 4);
+
+	for (int i = 0; i < 4; ++i) ints.push_back(i);
+	SEK_ASSERT_ALWAYS(ints.local() && ints.back() == 3);
+
+	/* Exceeding the local buffer re-allocates according to the growth factor. */
+	ints.push_back(4);
+	SEK_ASSERT_ALWAYS(!ints.local() && ints.capacity() == 8);
+	SEK_ASSERT_ALWAYS(ints.front() == 0 && ints.back() == 4);
+
+	ints.insert(ints.begin() + 1, 3, -1);
+	SEK_ASSERT_ALWAYS(ints.size() == 8);
+	SEK_ASSERT_ALWAYS(ints[0] == 0 && ints[1] == -1 && ints[3] == -1 && ints[4] == 1);
+
+	/* Appended ranges grow the vector once. */
+	const std::vector<int> tail = {5, 6, 7, 8, 9, 10, 11, 12, 13};
+	ints.append_range(tail);
+	SEK_ASSERT_ALWAYS(ints.size() == 17 && ints.capacity() == 17);
+	SEK_ASSERT_ALWAYS(std::equal(tail.begin(), tail.end(), ints.end() - 9));
+
+	ints.reserve_exact(20);
+	SEK_ASSERT_ALWAYS(ints.capacity() == 20);
+	ints.reserve(21);
+	SEK_ASSERT_ALWAYS(ints.capacity() == 40);
+
+	ints.erase(ints.begin() + 1, ints.begin() + 4);
+	SEK_ASSERT_ALWAYS(ints.size() == 14 && ints[1] == 1);
+	SEK_ASSERT_ALWAYS(sek::erase_if(ints, [](int i) { return i > 4; }) == 9);
+	ints.shrink_to_fit();
+	SEK_ASSERT_ALWAYS(!ints.local() && ints.capacity() == 5 && ints.back() == 4);
+	ints.pop_back();
+	ints.shrink_to_fit();
+	SEK_ASSERT_ALWAYS(ints.local() && ints.size() == 4 && ints.back() == 3);
+
+	/* Inserted values may reference elements of the vector. */
+	sek::buffered_vector<int, 2> alias = {0, 10, 20, 30};
+	alias.reserve(16);
+	alias.insert(alias.begin(), alias.back());
+	SEK_ASSERT_ALWAYS(alias.size() == 5 && alias[0] == 30 && alias.back() == 30);
+	alias.insert(alias.begin() + 1, 2, alias[2]);
+	SEK_ASSERT_ALWAYS(alias.size() == 7 && alias[1] == 10 && alias[2] == 10 && alias[3] == 0);
+	alias.emplace(alias.begin(), alias[6]);
+	SEK_ASSERT_ALWAYS(alias[0] == 30 && alias[7] == 30);
+
+	using growth_vector = sek::buffered_vector<int, 2, std::allocator<int>, std::ratio<3, 2>>;
+	growth_vector grow = {0, 1, 2};
+	SEK_ASSERT_ALWAYS(grow.capacity() == 3);
+	grow.push_back(3);
+	SEK_ASSERT_ALWAYS(grow.capacity() == 4);
+	grow.push_back(4);
+	SEK_ASSERT_ALWAYS(grow.capacity() == 6);
+
+	sek::buffered_vector<std::string, 2> strings;
+	for (int i = 0; i < 8; ++i) strings.emplace_back(fmt::format("heap-allocated string #{}", i));
+	strings.insert(strings.begin(), "front");
+	SEK_ASSERT_ALWAYS(strings.size() == 9 && strings.front() == "front");
+	SEK_ASSERT_ALWAYS(strings[1] == "heap-allocated string #0");
+
+	strings.reserve(32);
+	strings.insert(strings.begin() + 1, strings.back());
+	SEK_ASSERT_ALWAYS(strings[1] == "heap-allocated string #7" && strings[2] == "heap-allocated string #0");
+	strings.erase(strings.begin() + 1);
+
+	const std::list<std::string> list = {"list0", "list1"};
+	strings.append_range(list);
+	SEK_ASSERT_ALWAYS(strings.size() == 11 && strings.back() == "list1");
+
+	auto copy = strings;
+	SEK_ASSERT_ALWAYS(copy == strings);
+	auto moved = std::move(copy);
+	SEK_ASSERT_ALWAYS(moved == strings);
+
+	sek::buffered_vector<std::string, 2> small = {"small"};
+	small.swap(moved);
+	SEK_ASSERT_ALWAYS(small == strings && moved.size() == 1 && moved.local());
+}
\ No newline at end of file
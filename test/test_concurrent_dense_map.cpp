@@ -0,0 +1,66 @@
+/*
+ * Created by switchblade on 2026-10-16
+ */
+
+#include <core/concurrent_dense_map.hpp>
+
+#include "tests.hpp"
+#include <thread>
+#include <vector>
+
+void test_concurrent_dense_map()
+{
+	sek::concurrent_dense_map<std::string, std::string> map(4);
+
+	SEK_ASSERT_ALWAYS(map.shard_count() == 4);
+	SEK_ASSERT_ALWAYS(map.empty());
+	SEK_ASSERT_ALWAYS(!map.contains("key0"));
+	SEK_ASSERT_ALWAYS(!map.find("key0").has_value());
+
+	SEK_ASSERT_ALWAYS(map.try_emplace("key0", "value0"));
+	SEK_ASSERT_ALWAYS(!map.try_emplace("key0", "value1"));
+	SEK_ASSERT_ALWAYS(map.find("key0") == "value0");
+	SEK_ASSERT_ALWAYS(!map.insert({"key0", "value1"}));
+	SEK_ASSERT_ALWAYS(map.find("key0") == "value1");
+
+	SEK_ASSERT_ALWAYS(map.visit("key0", [](const std::string &, std::string &value) { value = "value2"; }));
+	SEK_ASSERT_ALWAYS(!map.visit("key1", [](const std::string &, std::string &) {}));
+	SEK_ASSERT_ALWAYS(map.find("key0") == "value2");
+
+	SEK_ASSERT_ALWAYS(!map.erase_if("key0", [](const std::string &, const std::string &v) { return v == "value0"; }));
+	SEK_ASSERT_ALWAYS(map.erase_if("key0", [](const std::string &, const std::string &v) { return v == "value2"; }));
+	SEK_ASSERT_ALWAYS(!map.erase("key0"));
+	SEK_ASSERT_ALWAYS(map.empty());
+
+	/* Insert & look up disjoint key ranges from multiple threads. */
+	const std::size_t count = 1000;
+	const std::size_t threads = 4;
+	sek::concurrent_dense_map<std::size_t, std::size_t> int_map;
+	std::vector<std::thread> workers;
+	for (std::size_t t = 0; t < threads; ++t)
+		workers.emplace_back(
+			[&, t]()
+			{
+				for (std::size_t i = t * count; i < (t + 1) * count; ++i)
+				{
+					SEK_ASSERT_ALWAYS(int_map.try_emplace(i, i * 2));
+					SEK_ASSERT_ALWAYS(int_map.find(i) == i * 2);
+				}
+				for (std::size_t i = 0; i < threads * count; ++i)
+					int_map.visit(i, [](std::size_t key, std::size_t value) { SEK_ASSERT_ALWAYS(value == key * 2); });
+			});
+	for (auto &worker : workers) worker.join();
+	SEK_ASSERT_ALWAYS(int_map.size() == threads * count);
+
+	std::size_t sum = 0;
+	int_map.visit_all([&](std::size_t key, std::size_t) { sum += key; });
+	SEK_ASSERT_ALWAYS(sum == (threads * count) * (threads * count - 1) / 2);
+
+	const auto erased = int_map.erase_if([](std::size_t key, std::size_t) { return key % 2 == 0; });
+	SEK_ASSERT_ALWAYS(erased == threads * count / 2);
+	SEK_ASSERT_ALWAYS(int_map.size() == threads * count / 2);
+	for (std::size_t i = 0; i < threads * count; ++i) SEK_ASSERT_ALWAYS(int_map.contains(i) == (i % 2 != 0));
+
+	int_map.clear();
+	SEK_ASSERT_ALWAYS(int_map.empty());
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+/*
+ * Created by switchblade on 2026-10-16
+ */
+
+#include <core/dense_count_set.hpp>
+
+#include "tests.hpp"
+#include <string>
+#include <vector>
+
+void test_dense_count_set()
+{
+	sek::dense_count_set<std::string> set;
+
+	SEK_ASSERT_ALWAYS(set.empty());
+	SEK_ASSERT_ALWAYS(set.size() == 0);
+	SEK_ASSERT_ALWAYS(set.count("key0") == 0);
+	SEK_ASSERT_ALWAYS(set.begin() == set.end());
+
+	const auto insert0 = set.insert("key0");
+	SEK_ASSERT_ALWAYS(insert0 != set.end() && *insert0 == "key0");
+	SEK_ASSERT_ALWAYS(set.insert("key0") == insert0);
+	SEK_ASSERT_ALWAYS(set.count("key0") == 2);
+	SEK_ASSERT_ALWAYS(set.size() == 2 && set.run_count() == 1);
+
+	/* Bulk insertion adds copies to the existing run. */
+	SEK_ASSERT_ALWAYS(set.insert_n("key0", 3) == insert0);
+	SEK_ASSERT_ALWAYS(set.insert_n("key1", 4) != set.end());
+	SEK_ASSERT_ALWAYS(set.insert_n("key2", 0) == set.end());
+	SEK_ASSERT_ALWAYS(!set.contains("key2"));
+	SEK_ASSERT_ALWAYS(set.count("key0") == 5 && set.count("key1") == 4);
+	SEK_ASSERT_ALWAYS(set.size() == 9 && set.run_count() == 2);
+	SEK_ASSERT_ALWAYS(static_cast<std::size_t>(std::distance(set.begin(), set.end())) == set.size());
+
+	/* Copies of a key are contiguous. */
+	const auto range = set.equal_range("key1");
+	SEK_ASSERT_ALWAYS(range.first == set.find("key1"));
+	SEK_ASSERT_ALWAYS(std::distance(range.first, range.second) == 4);
+	SEK_ASSERT_ALWAYS(std::all_of(range.first, range.second, [](auto &k) { return k == "key1"; }));
+	SEK_ASSERT_ALWAYS(set.equal_range("key2").first == set.end());
+
+	SEK_ASSERT_ALWAYS(set.erase_n("key0", 2) == 2);
+	SEK_ASSERT_ALWAYS(set.count("key0") == 3 && set.size() == 7);
+	SEK_ASSERT_ALWAYS(set.erase(set.find("key0")) == set.find("key0"));
+	SEK_ASSERT_ALWAYS(set.count("key0") == 2 && set.size() == 6);
+	SEK_ASSERT_ALWAYS(set.erase("key0") == 2);
+	SEK_ASSERT_ALWAYS(!set.contains("key0") && set.size() == 4 && set.run_count() == 1);
+
+	sek::dense_count_set<int> histogram;
+	const std::vector<int> samples = {1, 2, 2, 3, 3, 3, 1, 2};
+	SEK_ASSERT_ALWAYS(histogram.insert(samples.begin(), samples.end()) == 3);
+	SEK_ASSERT_ALWAYS(histogram.count(1) == 2 && histogram.count(2) == 3 && histogram.count(3) == 3);
+	SEK_ASSERT_ALWAYS(histogram == (sek::dense_count_set<int>{3, 2, 1, 3, 2, 1, 3, 2}));
+	histogram.clear();
+	SEK_ASSERT_ALWAYS(histogram.empty() && histogram.run_count() == 0);
+}
\ No newline at end of file
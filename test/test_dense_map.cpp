@@ -5,7 +5,9 @@
 #include <core/dense_map.hpp>
 
 #include "tests.hpp"
+#include <cstdint>
 #include <string_view>
+#include <vector>
 
 void test_dense_map()
 {
@@ -63,6 +65,149 @@ void test_dense_map()
 	}
 
 	SEK_ASSERT_ALWAYS(map.size() == count);
+
+	/* Batch lookup must match individual lookups, including missing keys. */
+	std::vector<std::string> batch_keys;
+	for (std::size_t i = 0; i < count; i += 3) batch_keys.push_back(fmt::format("key{}", i * 2));
+	std::vector<decltype(map)::iterator> batch_iters;
+	std::vector<bool> batch_found;
+	map.find_batch(batch_keys, std::back_inserter(batch_iters));
+	map.contains_batch(batch_keys, std::back_inserter(batch_found));
+	SEK_ASSERT_ALWAYS(batch_iters.size() == batch_keys.size());
+	SEK_ASSERT_ALWAYS(batch_found.size() == batch_keys.size());
+	for (std::size_t i = 0; i < batch_keys.size(); ++i)
+	{
+		SEK_ASSERT_ALWAYS(batch_iters[i] == map.find(batch_keys[i]));
+		SEK_ASSERT_ALWAYS(batch_found[i] == map.contains(batch_keys[i]));
+	}
+
 	map.clear();
 	SEK_ASSERT_ALWAYS(map.size() == 0);
+
+	/* Bucket counts are rounded to powers of 2 by default, while modulo policy keeps the requested count. */
+	struct modulo_hash : sek::default_hash
+	{
+		typedef sek::modulo_bucket_policy bucket_policy;
+	};
+	sek::dense_map<std::size_t, std::size_t> pow2_map;
+	sek::dense_map<std::size_t, std::size_t, modulo_hash> modulo_map;
+	pow2_map.rehash(100);
+	modulo_map.rehash(100);
+	SEK_ASSERT_ALWAYS(pow2_map.bucket_count() == 128);
+	SEK_ASSERT_ALWAYS(modulo_map.bucket_count() == 100);
+
+	/* Identity hashes of sequential integers must be spread across buckets. */
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		SEK_ASSERT_ALWAYS(pow2_map.try_emplace(i << 8, i).second);
+		SEK_ASSERT_ALWAYS(modulo_map.try_emplace(i << 8, i).second);
+	}
+	std::size_t max_bucket = 0;
+	for (std::size_t i = 0; i < pow2_map.bucket_count(); ++i) max_bucket = std::max(max_bucket, pow2_map.bucket_size(i));
+	SEK_ASSERT_ALWAYS(max_bucket < 16);
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		SEK_ASSERT_ALWAYS(pow2_map.at(i << 8) == i);
+		SEK_ASSERT_ALWAYS(modulo_map.at(i << 8) == i);
+	}
+
+	/* Compact tables store 32-bit chain indices & re-hash keys instead of caching hashes. */
+	sek::dense_map<std::uint32_t, std::uint32_t, sek::compact_hash<>> compact_map;
+	for (std::uint32_t i = 0; i < count; ++i) SEK_ASSERT_ALWAYS(compact_map.try_emplace(i, i * 2).second);
+	for (std::uint32_t i = 0; i < count; i += 2) SEK_ASSERT_ALWAYS(compact_map.erase(i));
+	SEK_ASSERT_ALWAYS(compact_map.size() == count / 2);
+	for (std::uint32_t i = 0; i < count; ++i)
+	{
+		SEK_ASSERT_ALWAYS(compact_map.contains(i) == (i % 2 != 0));
+		if (i % 2 != 0) SEK_ASSERT_ALWAYS(compact_map.at(i) == i * 2);
+	}
+
+	/* Incrementally rehashed maps must stay consistent while migration is in progress. */
+	sek::dense_map<std::size_t, std::size_t> incremental_map;
+	incremental_map.incremental_rehash(true);
+	const auto incremental_count = count * 10;
+	for (std::size_t i = 0; i < incremental_count; ++i)
+	{
+		SEK_ASSERT_ALWAYS(incremental_map.try_emplace(i, i).second);
+		SEK_ASSERT_ALWAYS(incremental_map.contains(i));
+		if (i % 3 == 0) SEK_ASSERT_ALWAYS(incremental_map.erase(i / 3));
+	}
+	for (std::size_t i = 0; i < incremental_count; ++i)
+		SEK_ASSERT_ALWAYS(incremental_map.contains(i) == (i > (incremental_count - 1) / 3));
+	incremental_map.rehash(incremental_map.bucket_count());
+	for (std::size_t i = 0; i < incremental_map.bucket_count(); ++i)
+		for (auto iter = incremental_map.begin(i); iter != incremental_map.end(i); ++iter)
+			SEK_ASSERT_ALWAYS(incremental_map.bucket(iter->first) == i);
+
+	/* Bulk insertion replaces values of duplicate keys, including duplicates within the inserted sequence. */
+	std::vector<std::pair<std::size_t, std::size_t>> bulk_values;
+	for (std::size_t i = 0; i < count; ++i) bulk_values.emplace_back(i % (count / 2), i);
+	sek::dense_map<std::size_t, std::size_t> bulk_map = {{0, 0}, {count, count}};
+	SEK_ASSERT_ALWAYS(bulk_map.insert(bulk_values.begin(), bulk_values.end()) == count / 2 - 1);
+	SEK_ASSERT_ALWAYS(bulk_map.size() == count / 2 + 1);
+	SEK_ASSERT_ALWAYS(bulk_map.load_factor() <= bulk_map.max_load_factor());
+	for (std::size_t i = 0; i < count / 2; ++i) SEK_ASSERT_ALWAYS(bulk_map.at(i) == i + count / 2);
+	SEK_ASSERT_ALWAYS(bulk_map.at(count) == count);
+
+	bulk_values.resize(count / 2);
+	const auto unique_map = sek::dense_map<std::size_t, std::size_t>::from_unique_range(bulk_values);
+	SEK_ASSERT_ALWAYS(unique_map.size() == count / 2);
+	for (std::size_t i = 0; i < count / 2; ++i) SEK_ASSERT_ALWAYS(unique_map.at(i) == i);
+
+	/* Tombstone erasure keeps iterators of other elements valid & re-uses holes on insertion. */
+	sek::dense_map<std::size_t, std::size_t, sek::tombstone_hash<>> tombstone_map;
+	for (std::size_t i = 0; i < count; ++i) tombstone_map.emplace(i, i);
+	for (auto iter = tombstone_map.begin(); iter != tombstone_map.end();)
+		if (iter->first % 2 == 0)
+			iter = tombstone_map.erase(iter);
+		else
+			SEK_ASSERT_ALWAYS((iter++)->second % 2 != 0);
+	SEK_ASSERT_ALWAYS(tombstone_map.size() == count / 2);
+	SEK_ASSERT_ALWAYS(static_cast<std::size_t>(std::distance(tombstone_map.begin(), tombstone_map.end())) == count / 2);
+	for (std::size_t i = 0; i < count; ++i) SEK_ASSERT_ALWAYS(tombstone_map.contains(i) == (i % 2 != 0));
+
+	const auto first_odd = tombstone_map.find(1);
+	for (std::size_t i = 0; i < count; i += 4) SEK_ASSERT_ALWAYS(tombstone_map.try_emplace(i, i * 2).second);
+	SEK_ASSERT_ALWAYS(first_odd == tombstone_map.find(1) && first_odd->second == 1);
+	SEK_ASSERT_ALWAYS(tombstone_map.size() == count / 2 + count / 4);
+
+	/* Moved-from tombstone maps are left empty & usable. */
+	auto moved_map = std::move(tombstone_map);
+	SEK_ASSERT_ALWAYS(tombstone_map.empty() && tombstone_map.begin() == tombstone_map.end());
+	SEK_ASSERT_ALWAYS(tombstone_map.try_emplace(count, count).second && tombstone_map.size() == 1);
+	tombstone_map = std::move(moved_map);
+	SEK_ASSERT_ALWAYS(moved_map.empty() && moved_map.try_emplace(count, count).second && moved_map.size() == 1);
+	SEK_ASSERT_ALWAYS(tombstone_map.size() == count / 2 + count / 4 && !tombstone_map.contains(count));
+
+	tombstone_map.compact();
+	SEK_ASSERT_ALWAYS(tombstone_map.size() == count / 2 + count / 4);
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		SEK_ASSERT_ALWAYS(tombstone_map.contains(i) == (i % 2 != 0 || i % 4 == 0));
+		if (i % 4 == 0) SEK_ASSERT_ALWAYS(tombstone_map.at(i) == i * 2);
+	}
+
+	/* Mass erasure keeps the remaining elements reachable. */
+	const auto erase_pred = [](auto &&v) { return v.first % 3 == 0; };
+	const auto erase_expected = std::count_if(tombstone_map.begin(), tombstone_map.end(), erase_pred);
+	SEK_ASSERT_ALWAYS(erase_if(tombstone_map, erase_pred) == static_cast<std::size_t>(erase_expected));
+	for (std::size_t i = 0; i < count; ++i) map.emplace(fmt::format("key{}", i), fmt::format("value{}", i));
+	SEK_ASSERT_ALWAYS(erase_if(map, [](auto &&v) { return v.first.size() % 2 == 0; }) == 910);
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		const auto key = fmt::format("key{}", i);
+		SEK_ASSERT_ALWAYS(tombstone_map.contains(i) == ((i % 2 != 0 || i % 4 == 0) && i % 3 != 0));
+		SEK_ASSERT_ALWAYS(map.contains(key) == (key.size() % 2 != 0));
+	}
+
+	/* Small maps keep entries in a single chain & build the bucket array once outgrown. */
+	sek::dense_map<int, int> small_map;
+	for (int i = 0; i < 8; ++i) SEK_ASSERT_ALWAYS(small_map.try_emplace(i, i).second);
+	SEK_ASSERT_ALWAYS(small_map.bucket_count() == 1);
+	for (int i = 0; i < 8; ++i) SEK_ASSERT_ALWAYS(small_map.at(i) == i);
+	SEK_ASSERT_ALWAYS(small_map.erase(3) && !small_map.contains(3) && small_map.size() == 7);
+
+	for (int i = 8; i < 32; ++i) SEK_ASSERT_ALWAYS(small_map.try_emplace(i, i).second);
+	SEK_ASSERT_ALWAYS(small_map.bucket_count() > 1);
+	for (int i = 0; i < 32; ++i) SEK_ASSERT_ALWAYS(small_map.contains(i) == (i != 3));
 }
\ No newline at end of file
@@ -69,4 +69,16 @@ void test_dense_multiset()
 	SEK_ASSERT_ALWAYS(set.size() == count);
 	set.clear();
 	SEK_ASSERT_ALWAYS(set.size() == 0);
+
+	/* Compact multisets store 32-bit chain indices & re-hash keys instead of caching hashes. */
+	sek::dense_multiset<std::tuple<std::uint32_t, std::string>, sek::compact_hash<>> compact_set;
+	for (std::uint32_t i = 0; i < count; ++i)
+		SEK_ASSERT_ALWAYS(compact_set.insert({i, fmt::format("key{}", i)}).second == 0);
+	SEK_ASSERT_ALWAYS(compact_set.insert({0, "key1"}).second == 2);
+	SEK_ASSERT_ALWAYS(compact_set.size() == count - 1);
+	SEK_ASSERT_ALWAYS(compact_set.find<0>(0) == compact_set.find<1>("key1"));
+	SEK_ASSERT_ALWAYS(!compact_set.contains<0>(1));
+	SEK_ASSERT_ALWAYS(!compact_set.contains<1>("key0"));
+	for (std::uint32_t i = 2; i < count; ++i)
+		SEK_ASSERT_ALWAYS(compact_set.find<0>(i) == compact_set.find<1>(fmt::format("key{}", i)));
 }
\ No newline at end of file
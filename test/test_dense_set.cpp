@@ -5,6 +5,7 @@
 #include <core/dense_set.hpp>
 
 #include "tests.hpp"
+#include <vector>
 
 void test_dense_set()
 {
@@ -56,6 +57,30 @@ void test_dense_set()
 	}
 
 	SEK_ASSERT_ALWAYS(set.size() == count);
+
+	/* Batch lookup must match individual lookups, including missing keys. */
+	std::vector<std::string> batch_keys;
+	for (std::size_t i = 0; i < count; i += 3) batch_keys.push_back(fmt::format("key{}", i * 2));
+	std::vector<decltype(set)::iterator> batch_iters;
+	std::vector<bool> batch_found;
+	set.find_batch(batch_keys, std::back_inserter(batch_iters));
+	set.contains_batch(batch_keys, std::back_inserter(batch_found));
+	for (std::size_t i = 0; i < batch_keys.size(); ++i)
+	{
+		SEK_ASSERT_ALWAYS(batch_iters[i] == set.find(batch_keys[i]));
+		SEK_ASSERT_ALWAYS(batch_found[i] == set.contains(batch_keys[i]));
+	}
+
 	set.clear();
 	SEK_ASSERT_ALWAYS(set.size() == 0);
+
+	const auto unique_set = sek::dense_set<std::string>::from_unique_range(batch_keys);
+	SEK_ASSERT_ALWAYS(unique_set.size() == batch_keys.size());
+	for (auto &key : batch_keys) SEK_ASSERT_ALWAYS(unique_set.contains(key));
+
+	/* Mass erasure keeps the remaining elements reachable. */
+	sek::dense_set<std::size_t> erase_set;
+	for (std::size_t i = 0; i < count; ++i) erase_set.insert(i);
+	SEK_ASSERT_ALWAYS(erase_if(erase_set, [](std::size_t i) { return i % 4 != 0; }) == count - count / 4);
+	for (std::size_t i = 0; i < count; ++i) SEK_ASSERT_ALWAYS(erase_set.contains(i) == (i % 4 == 0));
 }
\ No newline at end of file
@@ -0,0 +1,101 @@
+/*
+ * Created by switchblade on 2026-10-16
+ */
+
+#include <core/flat_dense_map.hpp>
+
+#include "tests.hpp"
+#include <string_view>
+
+void test_flat_dense_map()
+{
+	sek::flat_dense_map<std::string, std::string> map;
+
+	SEK_ASSERT_ALWAYS(map.empty());
+	SEK_ASSERT_ALWAYS(map.size() == 0);
+	SEK_ASSERT_ALWAYS(map.bucket_count() != 0);
+	SEK_ASSERT_ALWAYS(map.load_factor() == 0.0f);
+
+	SEK_ASSERT_ALWAYS(!map.contains("key0"));
+
+	const auto insert0 = map.emplace("key0", "value0");
+	SEK_ASSERT_ALWAYS(insert0.second == true);
+	SEK_ASSERT_ALWAYS(insert0.first != map.end());
+
+	SEK_ASSERT_ALWAYS(map.contains("key0"));
+	SEK_ASSERT_ALWAYS(map.find("key0") == insert0.first);
+	SEK_ASSERT_ALWAYS(map.at("key0") == "value0");
+	SEK_ASSERT_ALWAYS(map.find("key0")->second == "value0");
+
+	const auto insert1 = map.insert({"key0", "value1"});
+	SEK_ASSERT_ALWAYS(insert1.second == false);
+	SEK_ASSERT_ALWAYS(insert1.first == insert0.first);
+	SEK_ASSERT_ALWAYS(map.at("key0") == "value1");
+
+	const auto insert2 = map.insert({"key1", "value1"});
+	SEK_ASSERT_ALWAYS(insert2.second == true);
+	SEK_ASSERT_ALWAYS(insert2.first != map.end());
+	SEK_ASSERT_ALWAYS(map.at("key1") == "value1");
+
+	SEK_ASSERT_ALWAYS(map.contains("key1"));
+	SEK_ASSERT_ALWAYS(map.erase("key1"));
+	SEK_ASSERT_ALWAYS(!map.contains("key1"));
+	SEK_ASSERT_ALWAYS(!map.erase("key1"));
+
+	SEK_ASSERT_ALWAYS(!map.try_emplace("key0", "value0").second);
+	SEK_ASSERT_ALWAYS(map.try_emplace("key1", "value1").second);
+
+	SEK_ASSERT_ALWAYS(!map.empty());
+	map.clear();
+	SEK_ASSERT_ALWAYS(map.empty());
+
+	const std::size_t count = 1000;
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		const auto value = fmt::format("value{}", i);
+		const auto key = fmt::format("key{}", i);
+
+		const auto insert_i = map.insert({key, value});
+		SEK_ASSERT_ALWAYS(insert_i.second == true);
+		SEK_ASSERT_ALWAYS(insert_i.first != map.end());
+		SEK_ASSERT_ALWAYS(map.contains(key));
+		SEK_ASSERT_ALWAYS(map.at(key) == value);
+	}
+
+	SEK_ASSERT_ALWAYS(map.size() == count);
+	map.clear();
+	SEK_ASSERT_ALWAYS(map.size() == 0);
+
+	/* Identity hashes of integers must still be spread across groups, and erased slots must be re-used. */
+	sek::flat_dense_map<std::size_t, std::size_t> int_map;
+	for (std::size_t i = 0; i < count * 10; ++i) SEK_ASSERT_ALWAYS(int_map.try_emplace(i, i * 2).second);
+	SEK_ASSERT_ALWAYS(int_map.size() == count * 10);
+	SEK_ASSERT_ALWAYS(int_map.load_factor() <= int_map.max_load_factor());
+
+	for (std::size_t i = 0; i < count * 10; i += 2) SEK_ASSERT_ALWAYS(int_map.erase(i));
+	SEK_ASSERT_ALWAYS(int_map.size() == count * 5);
+	for (std::size_t i = 0; i < count * 10; ++i)
+	{
+		SEK_ASSERT_ALWAYS(int_map.contains(i) == (i % 2 != 0));
+		if (i % 2 != 0) SEK_ASSERT_ALWAYS(int_map.at(i) == i * 2);
+	}
+	for (auto entry : int_map) SEK_ASSERT_ALWAYS(entry.second == entry.first * 2);
+
+	const auto buckets = int_map.bucket_count();
+	for (std::size_t round = 0; round < 10; ++round)
+	{
+		for (std::size_t i = 0; i < count; i += 2) SEK_ASSERT_ALWAYS(int_map.try_emplace(i, i * 2).second);
+		for (std::size_t i = 0; i < count; i += 2) SEK_ASSERT_ALWAYS(int_map.erase(i));
+	}
+	SEK_ASSERT_ALWAYS(int_map.bucket_count() == buckets);
+	SEK_ASSERT_ALWAYS(int_map.size() == count * 5);
+
+	const auto key = std::size_t{1};
+	const auto bucket = int_map.bucket(key);
+	SEK_ASSERT_ALWAYS(int_map.bucket_size(bucket) == 1);
+	SEK_ASSERT_ALWAYS(int_map.begin(bucket) == int_map.find(key));
+	SEK_ASSERT_ALWAYS(int_map.bucket(int_map.find(key)) == bucket);
+
+	int_map.erase(int_map.begin(), int_map.end());
+	SEK_ASSERT_ALWAYS(int_map.empty());
+}
\ No newline at end of file
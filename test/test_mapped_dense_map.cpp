@@ -0,0 +1,66 @@
+/*
+ * Created by switchblade on 2026-10-16
+ */
+
+#include <core/mapped_dense_map.hpp>
+#include <core/mapped_dense_set.hpp>
+
+#include "tests.hpp"
+#include <cstring>
+#include <vector>
+
+/* Copies an image into 8-byte aligned storage, same as a memory mapping would provide. */
+static std::span<const std::byte> relocate_image(const std::vector<std::byte> &image,
+												 std::vector<std::uint64_t> &storage)
+{
+	storage.resize((image.size() + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t));
+	std::memcpy(storage.data(), image.data(), image.size());
+	return std::as_bytes(std::span{storage}).first(image.size());
+}
+
+void test_mapped_dense_map()
+{
+	constexpr std::size_t count = 1000;
+
+	sek::dense_map<std::string, std::string> map;
+	for (std::size_t i = 0; i < count; ++i) map.emplace(fmt::format("key{}", i), fmt::format("value{}", i));
+
+	using mapped_map_t = sek::mapped_dense_map<std::string, std::string>;
+	const auto image = mapped_map_t::make_image(map);
+	SEK_ASSERT_ALWAYS(mapped_map_t::make_image(map) == image);
+
+	std::vector<std::uint64_t> map_storage;
+	const mapped_map_t mapped_map{relocate_image(image, map_storage)};
+	SEK_ASSERT_ALWAYS(mapped_map.size() == count);
+	SEK_ASSERT_ALWAYS(!mapped_map.contains("key") && mapped_map.find("value0") == mapped_map.end());
+	for (std::size_t i = 0; i < count; ++i)
+		SEK_ASSERT_ALWAYS(mapped_map.at(fmt::format("key{}", i)) == fmt::format("value{}", i));
+	for (auto iter = mapped_map.begin(); iter != mapped_map.end(); ++iter)
+		SEK_ASSERT_ALWAYS(map.at(std::string{iter->first}) == iter->second);
+
+	/* Images of a different type are rejected. */
+	using mapped_int_map_t = sek::mapped_dense_map<int, double>;
+	sek::dense_map<int, double> int_map = {{1, 0.5}, {2, 1.5}};
+	const auto int_image = mapped_int_map_t::make_image(int_map);
+	std::vector<std::uint64_t> int_storage;
+	const auto int_bytes = relocate_image(int_image, int_storage);
+	SEK_ASSERT_ALWAYS(mapped_int_map_t{int_bytes}.at(2) == 1.5);
+	bool rejected = false;
+	try
+	{
+		[[maybe_unused]] const sek::mapped_dense_map<int, float> invalid{int_bytes};
+	}
+	catch (std::invalid_argument &)
+	{
+		rejected = true;
+	}
+	SEK_ASSERT_ALWAYS(rejected);
+
+	const sek::dense_set<std::string> set = {"", "a", "bb", "ccc"};
+	const auto set_image = sek::mapped_dense_set<std::string>::make_image(set);
+	std::vector<std::uint64_t> set_storage;
+	const sek::mapped_dense_set<std::string> mapped_set{relocate_image(set_image, set_storage)};
+	SEK_ASSERT_ALWAYS(mapped_set.size() == set.size());
+	for (auto &value : set) SEK_ASSERT_ALWAYS(mapped_set.contains(value));
+	SEK_ASSERT_ALWAYS(!mapped_set.contains("d"));
+}
\ No newline at end of file
@@ -0,0 +1,179 @@
+/*
+ * Created by switchblade on 2026-10-16
+ */
+
+#include <core/ordered_map.hpp>
+
+#include "tests.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+template<typename M>
+static bool check_order(const M &map, const std::vector<int> &keys)
+{
+	const auto key_eq = [](const auto &value, int key) { return value.first == key; };
+	if (!std::equal(map.begin(), map.end(), keys.begin(), keys.end(), key_eq)) return false;
+	if (!std::equal(map.rbegin(), map.rend(), keys.rbegin(), keys.rend(), key_eq)) return false;
+	return map.size() == keys.size();
+}
+
+void test_ordered_map()
+{
+	sek::ordered_map<int, std::string> map;
+	std::vector<int> keys;
+
+	SEK_ASSERT_ALWAYS(map.empty());
+	SEK_ASSERT_ALWAYS(map.begin() == map.end());
+
+	for (int i = 0; i < 20; ++i)
+	{
+		SEK_ASSERT_ALWAYS(map.try_emplace(i, std::to_string(i)).second);
+		keys.push_back(i);
+	}
+	SEK_ASSERT_ALWAYS(check_order(map, keys));
+
+	/* Interleaved erasure & insertion keeps insertion order. Re-inserted keys are appended. */
+	const auto erase_key = [&](int key)
+	{
+		keys.erase(std::find(keys.begin(), keys.end(), key));
+		return map.erase(key);
+	};
+	SEK_ASSERT_ALWAYS(erase_key(4) && erase_key(7) && erase_key(12));
+	SEK_ASSERT_ALWAYS(!map.erase(4));
+	SEK_ASSERT_ALWAYS(map.try_emplace(4, "4").second && !map.try_emplace(5, "").second);
+	keys.push_back(4);
+	SEK_ASSERT_ALWAYS(map.emplace(20, "20").second);
+	keys.push_back(20);
+	SEK_ASSERT_ALWAYS(erase_key(8));
+	SEK_ASSERT_ALWAYS(check_order(map, keys));
+	for (auto key : keys) SEK_ASSERT_ALWAYS(map.at(key) == std::to_string(key));
+
+	/* Lookup of missing keys yields the end iterator, even if the map contains holes. */
+	SEK_ASSERT_ALWAYS(map.find(7) == map.end() && map.find(100) == map.end());
+	SEK_ASSERT_ALWAYS(std::as_const(map).find(12) == std::as_const(map).end());
+
+	/* Erasing leading entries moves the beginning of the map. */
+	SEK_ASSERT_ALWAYS(erase_key(1));
+	keys.erase(keys.begin());
+	auto result = map.begin();
+	result = map.erase(map.begin());
+	SEK_ASSERT_ALWAYS(result == map.begin() && result->first == 2);
+	SEK_ASSERT_ALWAYS(check_order(map, keys));
+
+	/* Erasing trailing entries removes trailing holes. */
+	SEK_ASSERT_ALWAYS(erase_key(4));
+	keys.pop_back();
+	result = map.erase(std::prev(map.end()));
+	SEK_ASSERT_ALWAYS(result == map.end());
+	SEK_ASSERT_ALWAYS(std::prev(map.end())->first == 19);
+	SEK_ASSERT_ALWAYS(check_order(map, keys));
+	SEK_ASSERT_ALWAYS(map.try_emplace(4, "4").second);
+	keys.push_back(4);
+	SEK_ASSERT_ALWAYS(check_order(map, keys));
+
+	/* Range erasure over entries & holes. */
+	result = map.erase(std::next(map.begin(), 3), std::next(map.begin(), 8));
+	keys.erase(std::next(keys.begin(), 3), std::next(keys.begin(), 8));
+	SEK_ASSERT_ALWAYS(result == std::next(map.begin(), 3) && result->first == keys[3]);
+	SEK_ASSERT_ALWAYS(check_order(map, keys));
+	result = map.erase(std::next(map.begin(), 5), map.end());
+	keys.resize(5);
+	SEK_ASSERT_ALWAYS(result == map.end());
+	SEK_ASSERT_ALWAYS(check_order(map, keys));
+	result = map.erase(map.begin(), map.begin());
+	SEK_ASSERT_ALWAYS(result == map.begin() && map.size() == 5);
+	for (auto key : keys) SEK_ASSERT_ALWAYS(map.at(key) == std::to_string(key));
+
+	/* Copies preserve the order, moved-from maps are empty & usable. */
+	auto copy = map;
+	SEK_ASSERT_ALWAYS(check_order(copy, keys) && copy == map);
+	SEK_ASSERT_ALWAYS(copy.erase(keys[1]) && check_order(map, keys));
+	auto moved = std::move(map);
+	SEK_ASSERT_ALWAYS(check_order(moved, keys));
+	SEK_ASSERT_ALWAYS(map.empty() && map.begin() == map.end());
+	SEK_ASSERT_ALWAYS(map.try_emplace(0, "0").second && check_order(map, {0}));
+	map = std::move(moved);
+	SEK_ASSERT_ALWAYS(check_order(map, keys));
+	map.clear();
+	SEK_ASSERT_ALWAYS(map.empty() && map.try_emplace(1, "1").second && check_order(map, {1}));
+
+	/* Holes are compacted once they make up more than half of the map. */
+	sek::ordered_map<int, int> holes_map;
+	holes_map.reserve(64);
+	keys.clear();
+	for (int i = 0; i < 40; ++i)
+	{
+		holes_map.try_emplace(i, i);
+		if (i == 0 || i > 30) keys.push_back(i);
+	}
+	for (int i = 1; i <= 30; ++i) SEK_ASSERT_ALWAYS(holes_map.erase(i));
+	const auto *last_ptr = &holes_map.at(39);
+	SEK_ASSERT_ALWAYS(check_order(holes_map, keys));
+	SEK_ASSERT_ALWAYS(holes_map.try_emplace(100, 100).second);
+	keys.push_back(100);
+	SEK_ASSERT_ALWAYS(&holes_map.at(39) != last_ptr);
+	SEK_ASSERT_ALWAYS(check_order(holes_map, keys));
+	for (auto key : keys) SEK_ASSERT_ALWAYS(holes_map.at(key) == key);
+
+	SEK_ASSERT_ALWAYS(holes_map.erase(0) && holes_map.erase(35));
+	keys.erase(std::find(keys.begin(), keys.end(), 35));
+	keys.erase(keys.begin());
+	const auto *first_ptr = &holes_map.at(31);
+	holes_map.compact();
+	SEK_ASSERT_ALWAYS(&holes_map.at(31) != first_ptr);
+	SEK_ASSERT_ALWAYS(check_order(holes_map, keys));
+	for (auto key : keys) SEK_ASSERT_ALWAYS(holes_map.at(key) == key);
+
+	/* Predicate erasure keeps the order of retained entries. */
+	SEK_ASSERT_ALWAYS(erase_if(holes_map, [](const auto &v) { return v.first % 2 == 0; }) == 5);
+	std::erase_if(keys, [](int k) { return k % 2 == 0; });
+	SEK_ASSERT_ALWAYS(check_order(holes_map, keys));
+	for (auto key : keys) SEK_ASSERT_ALWAYS(holes_map.at(key) == key);
+
+	/* A throwing predicate erases only the entries preceding the throwing one, the rest of the map is retained. */
+	holes_map.clear();
+	keys.clear();
+	for (int i = 0; i < 30; ++i)
+	{
+		holes_map.try_emplace(i, i);
+		keys.push_back(i);
+	}
+	SEK_ASSERT_ALWAYS(holes_map.erase(0) && holes_map.erase(1) && holes_map.erase(2) && holes_map.erase(3));
+	SEK_ASSERT_ALWAYS(holes_map.erase(4) && holes_map.erase(12) && holes_map.erase(20));
+	std::erase_if(keys, [](int k) { return k < 5 || k == 12 || k == 20; });
+
+	const auto throwing_pred = [](const auto &v)
+	{
+		if (v.first == 15) throw std::runtime_error("erase_if");
+		return v.first % 2 != 0;
+	};
+	bool thrown = false;
+	try
+	{
+		erase_if(holes_map, throwing_pred);
+	}
+	catch (std::runtime_error &)
+	{
+		thrown = true;
+	}
+	SEK_ASSERT_ALWAYS(thrown);
+	std::erase_if(keys, [](int k) { return k < 15 && k % 2 != 0; });
+	SEK_ASSERT_ALWAYS(check_order(holes_map, keys));
+	for (auto key : keys) SEK_ASSERT_ALWAYS(holes_map.at(key) == key);
+	for (int i = 0; i < 30; ++i)
+		SEK_ASSERT_ALWAYS(holes_map.contains(i) == (std::find(keys.begin(), keys.end(), i) != keys.end()));
+	SEK_ASSERT_ALWAYS(holes_map.try_emplace(1, 1).second);
+	keys.push_back(1);
+	SEK_ASSERT_ALWAYS(check_order(holes_map, keys));
+
+	/* Clearing a map with a moved beginning resets the insertion order. */
+	SEK_ASSERT_ALWAYS(holes_map.erase(keys.front()) && holes_map.begin()->first == keys[1]);
+	holes_map.clear();
+	SEK_ASSERT_ALWAYS(holes_map.empty() && holes_map.begin() == holes_map.end());
+	SEK_ASSERT_ALWAYS(holes_map.find(keys[1]) == holes_map.end());
+	for (int i = 10; i > 0; --i) SEK_ASSERT_ALWAYS(holes_map.try_emplace(i, i).second);
+	SEK_ASSERT_ALWAYS(check_order(holes_map, {10, 9, 8, 7, 6, 5, 4, 3, 2, 1}));
+}
@@ -0,0 +1,53 @@
+/*
+ * Created by switchblade on 2026-10-16
+ */
+
+#include <core/parallel.hpp>
+
+#include "tests.hpp"
+#include <numeric>
+#include <random>
+#include <vector>
+
+void test_parallel()
+{
+	sek::thread_pool pool{4, sek::thread_pool::fifo | sek::thread_pool::work_stealing};
+
+	std::vector<std::size_t> data(100000);
+	std::iota(data.begin(), data.end(), std::size_t{0});
+
+	std::vector<std::atomic<std::size_t>> visited(data.size());
+	sek::parallel_for(pool, data.begin(), data.end(), [&](std::size_t i) { visited[i].fetch_add(1); });
+	SEK_ASSERT_ALWAYS(std::all_of(visited.begin(), visited.end(), [](auto &v) { return v.load() == 1; }));
+
+	sek::parallel_for(pool, std::size_t{0}, data.size(), [&](std::size_t i) { visited[i].fetch_add(1); }, 100);
+	SEK_ASSERT_ALWAYS(std::all_of(visited.begin(), visited.end(), [](auto &v) { return v.load() == 2; }));
+
+	std::vector<std::size_t> squares(data.size());
+	const auto out = sek::parallel_transform(pool, data.begin(), data.end(), squares.begin(), [](auto i) { return i * i; });
+	SEK_ASSERT_ALWAYS(out == squares.end());
+	for (std::size_t i = 0; i < data.size(); ++i) SEK_ASSERT_ALWAYS(squares[i] == i * i);
+
+	const auto sum = sek::parallel_reduce(pool, data.begin(), data.end(), std::size_t{10});
+	SEK_ASSERT_ALWAYS(sum == std::accumulate(data.begin(), data.end(), std::size_t{10}));
+	SEK_ASSERT_ALWAYS(sek::parallel_reduce(pool, data.begin(), data.begin(), std::size_t{10}) == 10);
+
+	std::shuffle(data.begin(), data.end(), std::mt19937{});
+	sek::parallel_sort(pool, data.begin(), data.end());
+	SEK_ASSERT_ALWAYS(std::is_sorted(data.begin(), data.end()));
+	sek::parallel_sort(pool, data.begin(), data.end(), std::greater<>{}, 100);
+	SEK_ASSERT_ALWAYS(std::is_sorted(data.begin(), data.end(), std::greater<>{}));
+
+	/* Exceptions are propagated to the caller. */
+	try
+	{
+		sek::parallel_for(pool, data.begin(), data.end(), [](std::size_t i) { if (i == 500) throw std::runtime_error("error"); });
+		SEK_ASSERT_ALWAYS(false);
+	}
+	catch (std::runtime_error &) {}
+
+	/* Nested jobs invoked from worker threads. */
+	std::atomic<std::size_t> nested = 0;
+	sek::parallel_for(pool, 0, 16, [&](int) { sek::parallel_for(pool, 0, 1000, [&](int) { nested.fetch_add(1); }); }, 1);
+	SEK_ASSERT_ALWAYS(nested.load() == 16000);
+}
\ No newline at end of file
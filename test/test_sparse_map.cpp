@@ -0,0 +1,208 @@
+/*
+ * Created by switchblade on 2026-10-16
+ */
+
+#include <core/sparse_map.hpp>
+#include <core/sparse_set.hpp>
+
+#include "tests.hpp"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+template<typename M>
+static bool check_keys(const M &map, std::vector<int> keys)
+{
+	std::vector<int> visited;
+	for (auto &value : map) visited.push_back(value.first);
+
+	std::sort(keys.begin(), keys.end());
+	std::sort(visited.begin(), visited.end());
+	return visited == keys && map.size() == keys.size();
+}
+
+/* Sends all keys to the same probe sequence. */
+struct colliding_hash
+{
+	constexpr std::size_t operator()(int) const noexcept { return 0; }
+};
+
+void test_sparse_map()
+{
+	sek::sparse_map<int, std::string> map;
+	std::vector<int> keys;
+
+	SEK_ASSERT_ALWAYS(map.empty());
+	SEK_ASSERT_ALWAYS(map.begin() == map.end());
+	SEK_ASSERT_ALWAYS(map.find(0) == map.end());
+	SEK_ASSERT_ALWAYS(!map.erase(0));
+
+	for (int i = 0; i < 100; ++i)
+	{
+		const auto result = map.try_emplace(i, std::to_string(i));
+		SEK_ASSERT_ALWAYS(result.second && result.first != map.end());
+		SEK_ASSERT_ALWAYS(map.find(i) == result.first);
+		keys.push_back(i);
+	}
+	SEK_ASSERT_ALWAYS(!map.try_emplace(5, "").second && map.at(5) == "5");
+	SEK_ASSERT_ALWAYS(!map.try_insert({5, ""}).second && map.at(5) == "5");
+	SEK_ASSERT_ALWAYS(!map.insert({5, "five"}).second && map.at(5) == "five");
+	map.at(5) = "5";
+	SEK_ASSERT_ALWAYS(check_keys(map, keys));
+
+	for (int i = 0; i < 100; i += 3) SEK_ASSERT_ALWAYS(map.erase(i));
+	std::erase_if(keys, [](int k) { return k % 3 == 0; });
+	SEK_ASSERT_ALWAYS(!map.erase(0) && map.find(0) == map.end());
+	SEK_ASSERT_ALWAYS(check_keys(map, keys));
+	for (auto key : keys) SEK_ASSERT_ALWAYS(map.at(key) == std::to_string(key));
+
+	/* Erasure via iterators visits every remaining value exactly once. */
+	for (auto item = map.begin(); item != map.end();)
+		if (item->first % 2 == 0)
+			item = map.erase(item);
+		else
+			++item;
+	std::erase_if(keys, [](int k) { return k % 2 == 0; });
+	SEK_ASSERT_ALWAYS(check_keys(map, keys));
+	for (int i = 0; i < 100; ++i) SEK_ASSERT_ALWAYS(map.contains(i) == (i % 2 != 0 && i % 3 != 0));
+
+	/* Colliding keys overflow their group & continue probing through the following groups. */
+	sek::sparse_map<int, int, colliding_hash> collide_map;
+	keys.clear();
+	for (int i = 0; i < 40; ++i)
+	{
+		SEK_ASSERT_ALWAYS(collide_map.try_emplace(i, i).second);
+		keys.push_back(i);
+	}
+	SEK_ASSERT_ALWAYS(collide_map.bucket_count() == 64);
+	SEK_ASSERT_ALWAYS(check_keys(collide_map, keys));
+	for (auto key : keys) SEK_ASSERT_ALWAYS(collide_map.at(key) == key);
+	SEK_ASSERT_ALWAYS(!collide_map.contains(40) && collide_map.find(-1) == collide_map.end());
+
+	/* Buckets of full groups are left as tombstones, which are skipped by lookups & re-used by insertions. */
+	SEK_ASSERT_ALWAYS(collide_map.tombstone_factor() == 0.0f);
+	for (int i = 0; i < 8; ++i) SEK_ASSERT_ALWAYS(collide_map.erase(i));
+	keys.erase(keys.begin(), keys.begin() + 8);
+	const auto tombstones = collide_map.tombstone_factor();
+	SEK_ASSERT_ALWAYS(tombstones != 0.0f && tombstones < collide_map.max_tombstone_factor());
+	SEK_ASSERT_ALWAYS(check_keys(collide_map, keys));
+	for (auto key : keys) SEK_ASSERT_ALWAYS(collide_map.at(key) == key);
+	for (int i = 0; i < 8; ++i) SEK_ASSERT_ALWAYS(!collide_map.contains(i));
+
+	for (int i = 0; i < 8; ++i)
+	{
+		SEK_ASSERT_ALWAYS(collide_map.try_emplace(i, -i).second);
+		keys.push_back(i);
+	}
+	SEK_ASSERT_ALWAYS(collide_map.tombstone_factor() < tombstones);
+	SEK_ASSERT_ALWAYS(!collide_map.try_emplace(0, 0).second && collide_map.at(0) == 0);
+	SEK_ASSERT_ALWAYS(check_keys(collide_map, keys));
+	for (int i = 0; i < 40; ++i) SEK_ASSERT_ALWAYS(collide_map.at(i) == (i < 8 ? -i : i));
+
+	/* Once there are too many tombstones, the next insertion re-hashes the table. */
+	for (int i = 0; i < 36; ++i) SEK_ASSERT_ALWAYS(collide_map.erase(i));
+	keys.assign({36, 37, 38, 39});
+	SEK_ASSERT_ALWAYS(collide_map.tombstone_factor() > collide_map.max_tombstone_factor());
+	SEK_ASSERT_ALWAYS(collide_map.bucket_count() == 64);
+	SEK_ASSERT_ALWAYS(check_keys(collide_map, keys));
+	SEK_ASSERT_ALWAYS(collide_map.try_emplace(100, 100).second);
+	keys.push_back(100);
+	SEK_ASSERT_ALWAYS(collide_map.tombstone_factor() == 0.0f);
+	SEK_ASSERT_ALWAYS(collide_map.bucket_count() < 64);
+	SEK_ASSERT_ALWAYS(check_keys(collide_map, keys));
+	for (auto key : keys) SEK_ASSERT_ALWAYS(collide_map.at(key) == key);
+
+	/* Pooled nodes of erased values are re-used by subsequent insertions. */
+	using pooled_map_t = sek::sparse_map<int, std::string, sek::pooled_hash<>>;
+	pooled_map_t pooled_map;
+	keys.clear();
+	for (int i = 0; i < 40; ++i)
+	{
+		pooled_map.try_emplace(i, std::to_string(i));
+		keys.push_back(i);
+	}
+	SEK_ASSERT_ALWAYS(pooled_map.bucket_count() == 64);
+
+	std::vector<const void *> erased_nodes;
+	for (int i = 0; i < 40; i += 4)
+	{
+		erased_nodes.push_back(&*pooled_map.find(i));
+		SEK_ASSERT_ALWAYS(pooled_map.erase(i));
+	}
+	std::erase_if(keys, [](int k) { return k % 4 == 0; });
+	SEK_ASSERT_ALWAYS(check_keys(pooled_map, keys));
+	for (int i = 100; i < 110; ++i)
+	{
+		const auto node = static_cast<const void *>(&*pooled_map.try_emplace(i, std::to_string(i)).first);
+		SEK_ASSERT_ALWAYS(std::find(erased_nodes.begin(), erased_nodes.end(), node) != erased_nodes.end());
+		keys.push_back(i);
+	}
+	SEK_ASSERT_ALWAYS(check_keys(pooled_map, keys));
+	for (auto key : keys) SEK_ASSERT_ALWAYS(pooled_map.at(key) == std::to_string(key));
+
+	/* Nodes extracted from the same table are re-used, values of foreign nodes are moved into new nodes. */
+	auto node = pooled_map.extract(1);
+	const auto *node_ptr = &node.value();
+	SEK_ASSERT_ALWAYS(!node.empty() && !pooled_map.contains(1));
+	SEK_ASSERT_ALWAYS(pooled_map.insert(std::move(node)).second && node.empty());
+	SEK_ASSERT_ALWAYS(&*pooled_map.find(1) == node_ptr && pooled_map.at(1) == "1");
+
+	pooled_map_t other_map;
+	for (int i = 200; i < 210; ++i) other_map.try_emplace(i, std::to_string(i));
+	node = other_map.extract(205);
+	node_ptr = &node.value();
+	SEK_ASSERT_ALWAYS(pooled_map.insert(std::move(node)).second && node.empty());
+	keys.push_back(205);
+	SEK_ASSERT_ALWAYS(&*pooled_map.find(205) != node_ptr && pooled_map.at(205) == "205");
+	SEK_ASSERT_ALWAYS(!other_map.contains(205) && other_map.size() == 9);
+	for (int i = 200; i < 210; ++i) SEK_ASSERT_ALWAYS(i == 205 || other_map.at(i) == std::to_string(i));
+	SEK_ASSERT_ALWAYS(check_keys(pooled_map, keys));
+
+	/* Shrinking moves values into a single contiguous page, in iteration order. */
+	std::vector<int> order;
+	for (auto &value : pooled_map) order.push_back(value.first);
+	pooled_map.shrink_to_fit();
+	SEK_ASSERT_ALWAYS(pooled_map.bucket_count() == 64);
+	SEK_ASSERT_ALWAYS(std::equal(pooled_map.begin(), pooled_map.end(), order.begin(), order.end(),
+								 [](const auto &value, int key) { return value.first == key; }));
+	for (auto item = pooled_map.begin(), next = std::next(item); next != pooled_map.end(); item = next++)
+		SEK_ASSERT_ALWAYS(&*next == &*item + 1);
+	for (auto key : keys) SEK_ASSERT_ALWAYS(pooled_map.at(key) == std::to_string(key));
+
+	/* Shrinking an empty table releases all of its storage, and the table remains usable. */
+	for (auto key : keys) SEK_ASSERT_ALWAYS(pooled_map.erase(key));
+	SEK_ASSERT_ALWAYS(pooled_map.empty());
+	pooled_map.shrink_to_fit();
+	SEK_ASSERT_ALWAYS(pooled_map.empty() && pooled_map.begin() == pooled_map.end());
+	SEK_ASSERT_ALWAYS(pooled_map.bucket_count() == 0 && !pooled_map.contains(0));
+	SEK_ASSERT_ALWAYS(pooled_map.try_emplace(0, "0").second && pooled_map.at(0) == "0");
+	SEK_ASSERT_ALWAYS(check_keys(pooled_map, {0}));
+
+	/* Predicate erasure leaves tombstones in full groups, which are removed at once if there are too many of them. */
+	collide_map.clear();
+	keys.clear();
+	for (int i = 0; i < 40; ++i)
+	{
+		collide_map.try_emplace(i, i);
+		keys.push_back(i);
+	}
+	SEK_ASSERT_ALWAYS(erase_if(collide_map, [](const auto &v) { return v.first == 0; }) == 1);
+	keys.erase(keys.begin());
+	SEK_ASSERT_ALWAYS(collide_map.tombstone_factor() <= collide_map.max_tombstone_factor());
+	SEK_ASSERT_ALWAYS(erase_if(collide_map, [](const auto &v) { return v.first < 0; }) == 0);
+	SEK_ASSERT_ALWAYS(check_keys(collide_map, keys));
+
+	SEK_ASSERT_ALWAYS(erase_if(collide_map, [](const auto &v) { return v.first % 10 != 0; }) == 36);
+	keys.assign({10, 20, 30});
+	SEK_ASSERT_ALWAYS(collide_map.tombstone_factor() == 0.0f && collide_map.bucket_count() == 64);
+	SEK_ASSERT_ALWAYS(check_keys(collide_map, keys));
+	for (auto key : keys) SEK_ASSERT_ALWAYS(collide_map.at(key) == key);
+	for (int i = 0; i < 40; ++i) SEK_ASSERT_ALWAYS(collide_map.contains(i) == (i != 0 && i % 10 == 0));
+
+	sek::sparse_set<std::string> set;
+	for (int i = 0; i < 100; ++i) set.insert(std::to_string(i));
+	SEK_ASSERT_ALWAYS(erase_if(set, [](const auto &v) { return v.size() == 1; }) == 10);
+	SEK_ASSERT_ALWAYS(set.size() == 90);
+	for (int i = 0; i < 100; ++i) SEK_ASSERT_ALWAYS(set.contains(std::to_string(i)) == (i >= 10));
+	SEK_ASSERT_ALWAYS(std::count_if(set.begin(), set.end(), [](auto &) { return true; }) == 90);
+}
@@ -0,0 +1,456 @@
+/*
+ * Created by switchblade on 2026-10-16
+ */
+
+#include <core/task.hpp>
+#include <core/task_graph.hpp>
+#include <core/thread_pool.hpp>
+
+#include "tests.hpp"
+#include <array>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+/* If set, the next allocation made by the thread fails. Used to make worker deques fail to grow. */
+static thread_local bool fail_allocation = false;
+
+void *operator new(std::size_t n)
+{
+	if (!std::exchange(fail_allocation, false)) [[likely]]
+		if (const auto ptr = std::malloc(n != 0 ? n : 1); ptr != nullptr) [[likely]]
+			return ptr;
+	throw std::bad_alloc();
+}
+
+namespace
+{
+	sek::task<int> coroutine_value(sek::thread_pool &pool, int value)
+	{
+		co_await pool.schedule();
+		co_return value;
+	}
+	sek::task<int> coroutine_sum(sek::thread_pool &pool, int n)
+	{
+		int result = 0;
+		for (int i = 0; i < n; ++i) result += co_await coroutine_value(pool, i);
+		co_return result;
+	}
+	sek::task<int &> coroutine_ref(int &value) { co_return value; }
+	std::atomic<int> hook_begin_count = 0;
+	std::atomic<int> hook_end_count = 0;
+
+	sek::task<> coroutine_error(sek::thread_pool &pool)
+	{
+		co_await pool.schedule();
+		throw std::runtime_error("error");
+	}
+}	 // namespace
+
+void test_thread_pool()
+{
+	for (auto mode : {sek::thread_pool::fifo,
+					  sek::thread_pool::filo,
+					  sek::thread_pool::fifo | sek::thread_pool::work_stealing,
+					  sek::thread_pool::filo | sek::thread_pool::work_stealing})
+	{
+		sek::thread_pool pool{4, mode};
+		SEK_ASSERT_ALWAYS(pool.size() == 4);
+		SEK_ASSERT_ALWAYS(pool.mode() == mode);
+
+		std::vector<sek::task_future<std::size_t>> futures;
+		for (std::size_t i = 0; i < 100; ++i) futures.push_back(pool.schedule([i]() { return i; }));
+		for (std::size_t i = 0; i < 100; ++i) SEK_ASSERT_ALWAYS(futures[i].get() == i);
+
+		auto error = pool.schedule([]() { throw std::runtime_error("error"); });
+		try
+		{
+			error.get();
+			SEK_ASSERT_ALWAYS(false);
+		}
+		catch (std::runtime_error &) {}
+
+		/* Large tasks are allocated outside of the task pool. */
+		std::array<std::size_t, 64> large = {};
+		large.back() = 64;
+		SEK_ASSERT_ALWAYS(pool.schedule([large]() { return large.back(); }).get() == 64);
+
+		int value = 0;
+		auto ref_future = pool.schedule([&]() -> int & { return value; });
+		SEK_ASSERT_ALWAYS(&ref_future.get() == &value);
+
+		auto void_future = pool.schedule([&]() { value = 1; });
+		void_future.wait();
+		SEK_ASSERT_ALWAYS(void_future.is_ready());
+		void_future.get();
+		SEK_ASSERT_ALWAYS(!void_future.valid());
+		SEK_ASSERT_ALWAYS(value == 1);
+
+		auto promise_future = pool.schedule(std::promise<long>{}, []() { return 2; });
+		SEK_ASSERT_ALWAYS(promise_future.get() == 2);
+
+		std::atomic<std::size_t> posted = 0;
+		for (std::size_t i = 0; i < 100; ++i) pool.post([&]() { posted.fetch_add(1); });
+		pool.post([]() { throw std::runtime_error("error"); });
+		while (posted.load() != 100) std::this_thread::yield();
+
+		/* Tasks spawning other tasks. */
+		const std::size_t count = 1000;
+		std::atomic<std::size_t> done = 0;
+		for (std::size_t i = 0; i < count / 10; ++i)
+			pool.schedule([&]()
+						  {
+							  for (std::size_t j = 0; j < 10; ++j)
+								  pool.post([&]() { done.fetch_add(1); });
+						  });
+		while (done.load() != count) std::this_thread::yield();
+
+		pool.resize(2);
+		SEK_ASSERT_ALWAYS(pool.size() == 2);
+		SEK_ASSERT_ALWAYS(pool.schedule([]() { return 1; }).get() == 1);
+		pool.resize(6);
+		SEK_ASSERT_ALWAYS(pool.size() == 6);
+		SEK_ASSERT_ALWAYS(pool.schedule([]() { return 2; }).get() == 2);
+	}
+
+	/* Task graphs. */
+	{
+		sek::thread_pool pool{4, sek::thread_pool::fifo | sek::thread_pool::work_stealing};
+		sek::task_graph graph;
+
+		/* Diamond-shaped graph: a -> (b0..b7) -> c */
+		std::atomic<int> stage = 0;
+		std::atomic<int> count = 0;
+		auto a = graph.emplace([&]() { stage.store(1); });
+		auto c = graph.emplace(
+			[&]()
+			{
+				SEK_ASSERT_ALWAYS(count.load() == 8);
+				stage.store(2);
+			});
+		for (int i = 0; i < 8; ++i)
+			graph
+				.emplace(
+					[&]()
+					{
+						SEK_ASSERT_ALWAYS(stage.load() == 1);
+						count.fetch_add(1);
+					})
+				.succeed(a)
+				.precede(c);
+		SEK_ASSERT_ALWAYS(graph.size() == 10);
+
+		/* Graph can be executed repeatedly. */
+		for (int i = 0; i < 100; ++i)
+		{
+			stage = 0;
+			count = 0;
+			graph.run(pool);
+			graph.wait();
+			SEK_ASSERT_ALWAYS(graph.is_done());
+			SEK_ASSERT_ALWAYS(stage.load() == 2);
+		}
+
+		/* Exceptions skip the remaining nodes and are re-thrown by `wait`. */
+		graph.clear();
+		bool executed = false;
+		graph.emplace([]() { throw std::runtime_error("error"); }).precede(graph.emplace([&]() { executed = true; }));
+		graph.run(pool);
+		try
+		{
+			graph.wait();
+			SEK_ASSERT_ALWAYS(false);
+		}
+		catch (std::runtime_error &) {}
+		SEK_ASSERT_ALWAYS(!executed);
+
+		/* Nodes that could not be pushed to the pool are executed in-place. A single worker is used, so that
+		 * the nodes are not stolen & the local deque of the worker has to grow. The first growth fails. */
+		sek::thread_pool single_pool{1, sek::thread_pool::fifo | sek::thread_pool::work_stealing};
+		graph.clear();
+		count = 0;
+		for (int i = 0; i < 1000; ++i) graph.emplace([&]() { count.fetch_add(1); });
+		auto run_future = single_pool.schedule(
+			[&]()
+			{
+				fail_allocation = true;
+				graph.run(single_pool);
+				fail_allocation = false;
+			});
+		run_future.get();
+		graph.wait();
+		SEK_ASSERT_ALWAYS(graph.is_done());
+		SEK_ASSERT_ALWAYS(count.load() == 1000);
+	}
+
+	/* Tasks that could not be pushed to the pool are destroyed. */
+	{
+		sek::thread_pool pool{1, sek::thread_pool::fifo | sek::thread_pool::work_stealing};
+		std::atomic<int> count = 0;
+
+		/* Fill the task slab of the worker, so that only growth of the worker's deque can fail. High-priority
+		 * tasks are not pushed to the deque. */
+		pool.schedule(
+				[&]()
+				{
+					for (int i = 0; i < 256; ++i) pool.post([&]() { count.fetch_add(1); }, sek::task_priority::high);
+				})
+			.get();
+		while (count.load() != 256) std::this_thread::yield();
+
+		const auto token = std::make_shared<int>();
+		const auto push_fails = [&](auto &&push)
+		{
+			fail_allocation = true;
+			bool failed = false;
+			try
+			{
+				push();
+			}
+			catch (std::bad_alloc &)
+			{
+				failed = true;
+			}
+			fail_allocation = false;
+			return failed && token.use_count() == 1;
+		};
+		pool.schedule(
+				[&]()
+				{
+					/* Fill the deque of the worker to it's capacity. */
+					for (int i = 0; i < 64; ++i) pool.post([&]() { count.fetch_add(1); });
+
+					std::promise<void> promise;
+					SEK_ASSERT_ALWAYS(push_fails([&]() { pool.schedule([token]() { return *token; }); }));
+					SEK_ASSERT_ALWAYS(push_fails([&]() { pool.schedule(std::move(promise), [token]() {}); }));
+					SEK_ASSERT_ALWAYS(push_fails([&]() { pool.post([token]() {}); }));
+				})
+			.get();
+		SEK_ASSERT_ALWAYS(pool.schedule([]() { return 1; }).get() == 1);
+		while (count.load() != 320) std::this_thread::yield();
+	}
+
+	/* Coroutines. */
+	{
+		sek::thread_pool pool{4};
+
+		std::vector<sek::task_future<int>> futures;
+		for (int i = 0; i < 64; ++i) futures.push_back(pool.schedule(coroutine_sum(pool, i)));
+		for (int i = 0; i < 64; ++i) SEK_ASSERT_ALWAYS(futures[static_cast<std::size_t>(i)].get() == i * (i - 1) / 2);
+
+		int value = 0;
+		auto ref_future = pool.schedule(coroutine_ref(value));
+		SEK_ASSERT_ALWAYS(&ref_future.get() == &value);
+
+		auto error_future = pool.schedule(coroutine_error(pool));
+		try
+		{
+			error_future.get();
+			SEK_ASSERT_ALWAYS(false);
+		}
+		catch (std::runtime_error &) {}
+	}
+
+	/* Coroutines awaiting a destroyed pool are unwound by their owner with an error. */
+	{
+		sek::thread_pool outer{1};
+		sek::task_future<int> future;
+
+		std::atomic<bool> started = false, released = false;
+		{
+			/* Block the only worker, so that the coroutine stays queued until the pool is destroyed. */
+			sek::thread_pool inner{1};
+			inner.post(
+				[&]()
+				{
+					started = true;
+					while (!released) std::this_thread::yield();
+				});
+			while (!started) std::this_thread::yield();
+
+			future = outer.schedule(coroutine_value(inner, 1));
+			while (inner.queue_depth(sek::task_priority::normal) == 0) std::this_thread::yield();
+		}
+		released = true;
+		try
+		{
+			future.get();
+			SEK_ASSERT_ALWAYS(false);
+		}
+		catch (std::future_error &e)
+		{
+			SEK_ASSERT_ALWAYS(e.code() == std::future_errc::broken_promise);
+		}
+	}
+
+	/* Priority lanes & deadlines. */
+	{
+		sek::thread_pool pool{1};
+		pool.starvation_limit(4);
+
+		/* Block the only worker, so that tasks accumulate in the lanes. */
+		std::atomic<bool> started = false, released = false;
+		const auto block = [&]()
+		{
+			started = false;
+			released = false;
+			pool.post(
+				[&]()
+				{
+					started = true;
+					started.notify_one();
+					released.wait(false);
+				});
+			started.wait(false);
+		};
+		const auto release = [&]()
+		{
+			released = true;
+			released.notify_one();
+		};
+
+		std::mutex mtx;
+		std::vector<int> order;
+		const auto push = [&](int i)
+		{
+			return [&, i]()
+			{
+				std::lock_guard<std::mutex> l(mtx);
+				order.push_back(i);
+			};
+		};
+
+		block();
+		pool.post(push(0), sek::task_priority::low);
+		pool.post(push(1), sek::task_priority::normal);
+		pool.post(push(2), sek::task_priority::high);
+		pool.post(push(3), sek::task_priority::high);
+		SEK_ASSERT_ALWAYS(pool.queue_depth(sek::task_priority::low) == 1);
+		SEK_ASSERT_ALWAYS(pool.queue_depth(sek::task_priority::normal) == 1);
+		SEK_ASSERT_ALWAYS(pool.queue_depth(sek::task_priority::high) == 2);
+		release();
+		pool.schedule([]() {}, sek::task_priority::low).wait();
+		SEK_ASSERT_ALWAYS((order == std::vector<int>{2, 3, 1, 0}));
+		SEK_ASSERT_ALWAYS(pool.queue_depth(sek::task_priority::high) == 0);
+
+		/* Low lane is served once it was skipped `starvation_limit` times. */
+		order.clear();
+		block();
+		pool.post(push(0), sek::task_priority::low);
+		for (int i = 1; i < 8; ++i) pool.post(push(i), sek::task_priority::high);
+		release();
+		pool.schedule([]() {}, sek::task_priority::low).wait();
+		SEK_ASSERT_ALWAYS((order == std::vector<int>{1, 2, 3, 4, 0, 5, 6, 7}));
+
+		/* Deadline tasks are dispatched in deadline order, and overdue tasks pre-empt higher lanes. */
+		order.clear();
+		block();
+		const auto now = sek::thread_pool::time_point::clock::now();
+		pool.post(push(0), now + std::chrono::hours{2});
+		pool.post(push(1), now + std::chrono::hours{1});
+		pool.post(push(2));
+		pool.post(push(3), sek::task_priority::high);
+		pool.post(push(4), now - std::chrono::seconds{1}, sek::task_priority::low);
+		release();
+		pool.schedule([]() {}, sek::task_priority::low).wait();
+		SEK_ASSERT_ALWAYS((order == std::vector<int>{4, 3, 1, 0, 2}));
+	}
+
+	/* Idle policy & CPU affinity. */
+	{
+		const sek::thread_pool::worker_config config = {
+			.spin_count = 1024,
+			.yield_count = 16,
+			.affinity = sek::thread_pool::affinity_mode::cpu,
+		};
+		sek::thread_pool pool{4, sek::thread_pool::fifo | sek::thread_pool::work_stealing, config};
+		SEK_ASSERT_ALWAYS(pool.config().spin_count == 1024);
+		SEK_ASSERT_ALWAYS(pool.config().yield_count == 16);
+		SEK_ASSERT_ALWAYS(pool.config().affinity == sek::thread_pool::affinity_mode::cpu);
+
+		std::atomic<int> count = 0;
+		for (int i = 0; i < 1000; ++i) pool.post([&]() { count.fetch_add(1); });
+		pool.schedule([]() {}, sek::task_priority::low).wait();
+		while (count.load() != 1000) std::this_thread::yield();
+
+		pool.config({.affinity = sek::thread_pool::affinity_mode::numa_node});
+		pool.resize(6);
+		SEK_ASSERT_ALWAYS(pool.config().spin_count == 0);
+		SEK_ASSERT_ALWAYS(pool.schedule([]() { return 1; }).get() == 1);
+
+		pool.config({});
+		SEK_ASSERT_ALWAYS(pool.config().affinity == sek::thread_pool::affinity_mode::none);
+	}
+
+	/* Batch submission. */
+	for (auto mode : {sek::thread_pool::fifo, sek::thread_pool::fifo | sek::thread_pool::work_stealing})
+	{
+		sek::thread_pool pool{4, mode};
+
+		std::vector<std::function<int()>> tasks;
+		for (int i = 0; i < 1000; ++i) tasks.emplace_back([i]() { return i; });
+		auto futures = pool.schedule_bulk(tasks);
+		SEK_ASSERT_ALWAYS(futures.size() == tasks.size());
+		for (int i = 0; i < 1000; ++i) SEK_ASSERT_ALWAYS(futures[static_cast<std::size_t>(i)].get() == i);
+
+		/* Batches submitted from within a worker. */
+		std::atomic<int> count = 0;
+		pool.schedule(
+				[&]()
+				{
+					std::array<std::function<void()>, 64> batch;
+					batch.fill([&]() { count.fetch_add(1); });
+					pool.post_bulk(batch, sek::task_priority::high);
+					pool.post_bulk(batch);
+				})
+			.wait();
+		while (count.load() != 128) std::this_thread::yield();
+
+		auto empty = pool.schedule_bulk(std::vector<std::function<void()>>{});
+		SEK_ASSERT_ALWAYS(empty.empty());
+	}
+	{
+		/* Batches are dispatched in range order. */
+		sek::thread_pool pool{1};
+		std::vector<int> order;
+		std::vector<std::function<void()>> tasks;
+		for (int i = 0; i < 16; ++i) tasks.emplace_back([&order, i]() { order.push_back(i); });
+		for (auto &future : pool.schedule_bulk(tasks)) future.wait();
+		for (int i = 0; i < 16; ++i) SEK_ASSERT_ALWAYS(order[static_cast<std::size_t>(i)] == i);
+	}
+
+	/* Statistics & task hooks. */
+	{
+		sek::thread_pool::worker_config config;
+		config.measure_time = true;
+		config.on_task_begin = [](std::size_t, const void *) noexcept { hook_begin_count.fetch_add(1); };
+		config.on_task_end = [](std::size_t, const void *) noexcept { hook_end_count.fetch_add(1); };
+
+		sek::thread_pool pool{2, sek::thread_pool::fifo | sek::thread_pool::work_stealing, config};
+		std::vector<sek::task_future<void>> futures;
+		for (int i = 0; i < 100; ++i) futures.push_back(pool.schedule([]() {}));
+		for (auto &future : futures) future.wait();
+
+		/* Wait for the workers to finish bookkeeping of the last tasks. */
+		const auto executed = [&]()
+		{
+			std::uint64_t result = 0;
+			for (auto &worker : pool.stats().workers) result += worker.tasks_executed;
+			return result;
+		};
+		while (executed() != 100 || hook_end_count.load() != 100) std::this_thread::yield();
+		SEK_ASSERT_ALWAYS(hook_begin_count.load() == 100);
+
+		const auto stats = pool.stats();
+		SEK_ASSERT_ALWAYS(stats.workers.size() == 2);
+		SEK_ASSERT_ALWAYS(stats.queue_high_water != 0);
+
+		std::uint64_t latency_samples = 0;
+		for (auto &worker : stats.workers)
+			for (auto n : worker.latency) latency_samples += n;
+		SEK_ASSERT_ALWAYS(latency_samples == 100);
+	}
+}
\ No newline at end of file
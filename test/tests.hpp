@@ -11,16 +11,38 @@
 
 void test_events();
 
+void test_buffered_vector();
+
 void test_dense_map();
 void test_dense_set();
 void test_dense_multiset();
+void test_dense_count_set();
+void test_flat_dense_map();
+void test_flat_dense_set();
+void test_ordered_map();
+void test_sparse_map();
+void test_concurrent_dense_map();
+void test_mapped_dense_map();
 
 void test_type_info();
 
+void test_thread_pool();
+void test_parallel();
+
 static std::pair<std::string_view, void (*)()> test_funcs[] = {
 	{"events", test_events},
+	{"buffered_vector", test_buffered_vector},
 	{"dense_map", test_dense_map},
 	{"dense_set", test_dense_set},
 	{"dense_multiset", test_dense_multiset},
+	{"dense_count_set", test_dense_count_set},
+	{"flat_dense_map", test_flat_dense_map},
+	{"flat_dense_set", test_flat_dense_set},
+	{"ordered_map", test_ordered_map},
+	{"sparse_map", test_sparse_map},
+	{"concurrent_dense_map", test_concurrent_dense_map},
+	{"mapped_dense_map", test_mapped_dense_map},
 	{"type_info", test_type_info},
+	{"thread_pool", test_thread_pool},
+	{"parallel", test_parallel},
 };